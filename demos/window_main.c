@@ -23,5 +23,7 @@ ret_t application_init(void) {
  */
 ret_t application_exit(void) {
   log_debug("application_exit\n");
+  slider_circle_sprite_cache_deinit();
+
   return RET_OK;
 }
@@ -0,0 +1,82 @@
+﻿/**
+ * File:   gauge_circle.h
+ * Author: AWTK Develop Team
+ * Brief:  只用于显示的环形仪表(与slider_circle共用绘制代码)。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_GAUGE_CIRCLE_H
+#define TK_GAUGE_CIRCLE_H
+
+#include "slider_circle.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class gauge_circle_t
+ * @parent slider_circle_t
+ * @annotation ["scriptable","design","widget"]
+ * 只用于显示的环形仪表。
+ *
+ * 属性、样式和绘制效果与slider_circle完全一样(可以使用slider_circle_set_xxx函数)，区别在于：
+ *
+ * * 不处理指针事件，不改变控件的状态，不参与输入和焦点。
+ * * 指针事件直接穿透到后面的控件(sensitive为FALSE)。
+ * * 拖动用的函数(如slider_circle_point_to_value)直接返回失败。
+ *
+ * 在xml中使用"gauge\_circle"标签创建控件。如：
+ *
+ * ```xml
+ * <!-- ui -->
+ * <gauge_circle start_angle="120" end_angle="420" line_cap="round" value="30"/>
+ * ```
+ */
+
+/**
+ * @method gauge_circle_create
+ * @annotation ["constructor", "scriptable"]
+ * 创建gauge_circle对象
+ * @param {widget_t*} parent 父控件
+ * @param {xy_t} x x坐标
+ * @param {xy_t} y y坐标
+ * @param {wh_t} w 宽度
+ * @param {wh_t} h 高度
+ *
+ * @return {widget_t*} gauge_circle对象。
+ */
+widget_t* gauge_circle_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h);
+
+/**
+ * @method gauge_circle_cast
+ * 转换为gauge_circle对象(供脚本语言使用)。
+ * @annotation ["cast", "scriptable"]
+ * @param {widget_t*} widget gauge_circle对象。
+ *
+ * @return {widget_t*} gauge_circle对象。
+ */
+widget_t* gauge_circle_cast(widget_t* widget);
+
+#define WIDGET_TYPE_GAUGE_CIRCLE "gauge_circle"
+
+#define GAUGE_CIRCLE(widget) ((slider_circle_t*)(gauge_circle_cast(WIDGET(widget))))
+
+/*public for subclass and runtime type check*/
+TK_EXTERN_VTABLE(gauge_circle);
+
+END_C_DECLS
+
+#endif /*TK_GAUGE_CIRCLE_H*/
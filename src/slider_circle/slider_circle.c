@@ -21,35 +21,119 @@
 
 #include "tkc/mem.h"
 #include "tkc/utils.h"
+#include "tkc/time_now.h"
+#include "base/idle.h"
+#include "base/style_mutable.h"
 #include "slider_circle.h"
+#include "gauge_circle.h"
+#include "slider_circle_mono.h"
+#include "slider_circle_pool.h"
+#include "slider_circle_direct.h"
+#include "slider_circle_trace.h"
+#include "slider_circle_source.h"
+#include "slider_circle_sprite.h"
+#include "slider_circle_backend.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SLIDER_CIRCLE_FORCE_INLINE static inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define SLIDER_CIRCLE_FORCE_INLINE static __forceinline
+#else
+#define SLIDER_CIRCLE_FORCE_INLINE static inline
+#endif
 
 static ret_t slider_circle_set_value_internal(widget_t* widget, double value, uint32_t etype,
                                               bool_t force);
 
-static ret_t slider_circle_set_value_internal(widget_t* widget, double value, uint32_t etype,
-                                              bool_t force) {
-  double step = 0;
-  double offset = 0;
-  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
-  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+static double slider_circle_normalize_value(slider_circle_t* slider_circle, double value) {
+  double step = slider_circle->step;
 
-  step = slider_circle->step;
   value = tk_clamp(value, slider_circle->min, slider_circle->max);
-
-  if (step > 0) {
-    offset = value - slider_circle->min;
+  if (slider_circle->value_map != NULL &&
+      slider_circle->value_map->type == SLIDER_CIRCLE_MAPPING_LIST) {
+    /*离散值列表代替step的取整*/
+    return slider_circle_mapping_snap(slider_circle->value_map, value);
+  } else if (step > 0) {
+    double offset = value - slider_circle->min;
     offset = tk_roundi(offset / step) * step;
     value = slider_circle->min + offset;
   }
 
+  return value;
+}
+
+ret_t slider_circle_update_text(widget_t* widget) {
+#ifndef SLIDER_CIRCLE_WITHOUT_TEXT
+  char text[TK_NUM_MAX_LEN + 1];
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  if (!slider_circle->show_text) {
+    return RET_OK;
+  }
+
+  /*直接写text，不经过widget_set_text(它会分发属性变化事件并且刷新)*/
+  slider_circle_format_value(text, sizeof(text), slider_circle->format, slider_circle->value);
+  return wstr_set_utf8(&(widget->text), text);
+#else
+  return RET_OK;
+#endif /*SLIDER_CIRCLE_WITHOUT_TEXT*/
+}
+
+static ret_t slider_circle_get_render_key(widget_t* widget, double value,
+                                          slider_circle_render_key_t* key) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  double cx = widget->w / 2;
+  double cy = widget->h / 2;
+  double r = tk_min(cx, cy) - slider_circle->bg_line_width / 2;
+  double angle = slider_circle_value_to_angle(widget, value);
+
+  memset(key, 0x00, sizeof(*key));
+  key->arc_end = tk_roundi(angle * r * SLIDER_CIRCLE_RENDER_KEY_SUBPIXEL);
+  if (slider_circle->header_size > 0) {
+    key->dragger_x = tk_roundi(cx + r * cos(angle));
+    key->dragger_y = tk_roundi(cy + r * sin(angle));
+  }
+#ifndef SLIDER_CIRCLE_WITHOUT_TEXT
+  if (slider_circle->show_text) {
+    slider_circle_format_value(key->text, sizeof(key->text), slider_circle->format, value);
+  }
+#endif /*SLIDER_CIRCLE_WITHOUT_TEXT*/
+
+  return RET_OK;
+}
+
+/*值变化之后，绘制的结果和上次绘制时一样就不重绘(值变化的事件照常分发)*/
+static ret_t slider_circle_invalidate_value(widget_t* widget) {
+  slider_circle_render_key_t key;
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+
+  if (slider_circle->render_key_valid) {
+    slider_circle_get_render_key(widget, slider_circle->value, &key);
+    if (memcmp(&key, &(slider_circle->render_key), sizeof(key)) == 0) {
+      return RET_OK;
+    }
+  }
+
+  return widget_invalidate(widget, NULL);
+}
+
+static ret_t slider_circle_set_value_internal(widget_t* widget, double value, uint32_t etype,
+                                              bool_t force) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  value = slider_circle_normalize_value(slider_circle, value);
+
   if (slider_circle->value != value || force) {
     value_change_event_t evt;
     value_change_event_init(&evt, etype, widget);
     value_set_double(&(evt.old_value), slider_circle->value);
     value_set_double(&(evt.new_value), value);
     slider_circle->value = value;
+    slider_circle_update_text(widget);
     widget_dispatch(widget, (event_t*)&evt);
-    widget_invalidate(widget, NULL);
+    slider_circle_invalidate_value(widget);
   }
 
   return RET_OK;
@@ -59,10 +143,12 @@ ret_t slider_circle_set_value(widget_t* widget, double value) {
   slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
   return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
 
-  if (slider_circle->dragging) {
+  if (SLIDER_CIRCLE_IS_DRAGGING(widget, slider_circle)) {
     return RET_BUSY;
   }
 
+  /*先取数据源发布的值，比较和事件中的旧值才是当前的值*/
+  slider_circle_sync_source(widget);
   if (slider_circle->value != value) {
     value_change_event_t evt;
     value_change_event_init(&evt, EVT_VALUE_WILL_CHANGE, widget);
@@ -78,11 +164,169 @@ ret_t slider_circle_set_value(widget_t* widget, double value) {
   return RET_OK;
 }
 
+ret_t slider_circle_set_render_backend(widget_t* widget, const char* render_backend) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  slider_circle->render_backend = slider_circle_backend_from_str(render_backend);
+  slider_circle->backend_lcd = NULL;
+
+  return widget_invalidate(widget, NULL);
+}
+
+ret_t slider_circle_set_peak_hold(widget_t* widget, bool_t peak_hold) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  slider_circle->peak_hold = peak_hold;
+
+  return widget_invalidate(widget, NULL);
+}
+
+ret_t slider_circle_set_peak_decay(widget_t* widget, float_t peak_decay) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  slider_circle->peak_decay = tk_max(peak_decay, 0);
+
+  /*已经有峰值时需要重绘一次，开始回落*/
+  if (slider_circle->ingest != NULL && slider_circle->ingest->has_peaks) {
+    return widget_invalidate(widget, NULL);
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_ingest(widget_t* widget, const double* samples, uint32_t nr) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  if (slider_circle->ingest == NULL) {
+    slider_circle->ingest = TKMEM_ZALLOC(slider_circle_ingest_t);
+    return_value_if_fail(slider_circle->ingest != NULL, RET_OOM);
+  }
+  return_value_if_fail(slider_circle_ingest_push(slider_circle->ingest, samples, nr) == RET_OK,
+                       RET_BAD_PARAMS);
+
+  /*两次绘制之间只刷新一次*/
+  if (nr > 0 && !slider_circle->ingest_pending) {
+    slider_circle->ingest_pending = TRUE;
+    widget_invalidate(widget, NULL);
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_reset_peaks(widget_t* widget) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  if (slider_circle->ingest != NULL) {
+    slider_circle->ingest->has_peaks = FALSE;
+  }
+
+  return widget_invalidate(widget, NULL);
+}
+
+static ret_t slider_circle_on_peak_idle(const idle_info_t* info) {
+  widget_t* widget = WIDGET(info->ctx);
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+
+  slider_circle->peak_idle = TK_INVALID_ID;
+  widget_invalidate(widget, NULL);
+
+  return RET_REMOVE;
+}
+
+static ret_t slider_circle_commit_ingest(widget_t* widget) {
+  ret_t ret = RET_OK;
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  slider_circle_ingest_t* ingest = slider_circle->ingest;
+
+  if (ingest == NULL) {
+    return RET_OK;
+  }
+
+  if (ingest->frame_count > 0) {
+    slider_circle->value = slider_circle_normalize_value(slider_circle, ingest->last);
+    slider_circle_update_text(widget);
+  }
+  slider_circle->ingest_pending = FALSE;
+
+  ret = slider_circle_ingest_commit(ingest, slider_circle->value, slider_circle->peak_decay,
+                                    time_now_ms());
+
+  /*峰值只在绘制时回落，没有新的采样时也要继续绘制，直到回落到当前值*/
+  if (slider_circle->peak_hold && slider_circle->peak_decay > 0 && ingest->has_peaks &&
+      (ingest->peak_max > slider_circle->value || ingest->peak_min < slider_circle->value) &&
+      slider_circle->peak_idle == TK_INVALID_ID) {
+    slider_circle->peak_idle = widget_add_idle(widget, slider_circle_on_peak_idle);
+  }
+
+  return ret;
+}
+
+ret_t slider_circle_sync_source(widget_t* widget) {
+  slider_circle_source_t* source = NULL;
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  source = slider_circle->source;
+  if (source == NULL || source->generation == 0 ||
+      slider_circle->source_generation == source->generation) {
+    return RET_OK;
+  }
+
+  /*不分发值变化的事件，只更新自己的值*/
+  slider_circle->source_generation = source->generation;
+  slider_circle->value = slider_circle_normalize_value(slider_circle, source->value);
+
+  return slider_circle_update_text(widget);
+}
+
+static ret_t slider_circle_update_value_map(widget_t* widget) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  const char* mapping = slider_circle->mapping;
+
+  /*线性映射不需要节点表，使用原来的计算方法*/
+  if (mapping == NULL || *mapping == '\0' || tk_str_eq(mapping, "linear")) {
+    TKMEM_FREE(slider_circle->value_map);
+    return RET_OK;
+  }
+
+  if (slider_circle->value_map == NULL) {
+    slider_circle->value_map = TKMEM_ZALLOC(slider_circle_mapping_t);
+    return_value_if_fail(slider_circle->value_map != NULL, RET_OOM);
+  }
+
+  /*对数映射的节点表和min/max有关，min/max变化时重新生成*/
+  slider_circle_mapping_parse(slider_circle->value_map, mapping, slider_circle->min,
+                              slider_circle->max);
+  if (slider_circle->value_map->type == SLIDER_CIRCLE_MAPPING_LINEAR) {
+    TKMEM_FREE(slider_circle->value_map);
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_update_mapping(widget_t* widget) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  slider_circle_update_value_map(widget);
+  slider_circle->value = slider_circle_normalize_value(slider_circle, slider_circle->value);
+
+  return slider_circle_update_text(widget);
+}
+
 ret_t slider_circle_set_min(widget_t* widget, double min) {
   slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
   return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
 
   slider_circle->min = min;
+  if (slider_circle->mapping != NULL) {
+    slider_circle_update_value_map(widget);
+  }
 
   return widget_invalidate(widget, NULL);
 }
@@ -92,6 +336,9 @@ ret_t slider_circle_set_max(widget_t* widget, double max) {
   return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
 
   slider_circle->max = max;
+  if (slider_circle->mapping != NULL) {
+    slider_circle_update_value_map(widget);
+  }
 
   return widget_invalidate(widget, NULL);
 }
@@ -146,6 +393,7 @@ ret_t slider_circle_set_header_size(widget_t* widget, uint8_t header_size) {
   return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
 
   slider_circle->header_size = header_size;
+  slider_circle_update_paint(widget);
 
   return widget_invalidate(widget, NULL);
 }
@@ -163,7 +411,8 @@ ret_t slider_circle_set_line_cap(widget_t* widget, const char* line_cap) {
   slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
   return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
 
-  slider_circle->line_cap = tk_str_copy(slider_circle->line_cap, line_cap);
+  slider_circle->line_cap = slider_circle_pool_str_copy(slider_circle->line_cap, line_cap);
+  slider_circle_update_paint(widget);
 
   return widget_invalidate(widget, NULL);
 }
@@ -173,6 +422,7 @@ ret_t slider_circle_set_counter_clock_wise(widget_t* widget, bool_t counter_cloc
   return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
 
   slider_circle->counter_clock_wise = counter_clock_wise;
+  slider_circle_update_paint(widget);
 
   return widget_invalidate(widget, NULL);
 }
@@ -182,6 +432,8 @@ ret_t slider_circle_set_show_text(widget_t* widget, bool_t show_text) {
   return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
 
   slider_circle->show_text = show_text;
+  slider_circle_update_paint(widget);
+  slider_circle_update_text(widget);
 
   return widget_invalidate(widget, NULL);
 }
@@ -190,16 +442,110 @@ ret_t slider_circle_set_format(widget_t* widget, const char* format) {
   slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
   return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
 
-  slider_circle->format = tk_str_copy(slider_circle->format, format);
+  slider_circle->format = slider_circle_pool_str_copy(slider_circle->format, format);
+  slider_circle_update_text(widget);
+
+  return widget_invalidate(widget, NULL);
+}
+
+ret_t slider_circle_set_show_ticks(widget_t* widget, bool_t show_ticks) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  slider_circle->show_ticks = show_ticks;
+
+  return widget_invalidate(widget, NULL);
+}
+
+ret_t slider_circle_set_major_ticks(widget_t* widget, uint8_t major_ticks) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  slider_circle->major_ticks = major_ticks;
+
+  return widget_invalidate(widget, NULL);
+}
+
+ret_t slider_circle_set_tick_min_gap(widget_t* widget, uint8_t tick_min_gap) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  slider_circle->tick_min_gap = tick_min_gap;
+
+  return widget_invalidate(widget, NULL);
+}
+
+ret_t slider_circle_set_track_dither(widget_t* widget, bool_t track_dither) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  slider_circle->track_dither = track_dither;
+
+  return widget_invalidate(widget, NULL);
+}
+
+ret_t slider_circle_set_zones(widget_t* widget, const char* zones) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  if (tk_str_eq(slider_circle->zones, zones)) {
+    return RET_OK;
+  }
+
+  /*只在设置时解析一次，绘制时直接使用解析的结果*/
+  if (zones == NULL || *zones == '\0') {
+    TKMEM_FREE(slider_circle->zone_list);
+    TKMEM_FREE(slider_circle->zones);
+  } else {
+    if (slider_circle->zone_list == NULL) {
+      slider_circle->zone_list = TKMEM_ZALLOC(slider_circle_zones_t);
+      return_value_if_fail(slider_circle->zone_list != NULL, RET_OOM);
+    }
+    slider_circle->zones = tk_str_copy(slider_circle->zones, zones);
+    slider_circle_zones_parse(slider_circle->zone_list, zones);
+  }
+
+  return widget_invalidate(widget, NULL);
+}
+
+ret_t slider_circle_set_mapping(widget_t* widget, const char* mapping) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  if (tk_str_eq(slider_circle->mapping, mapping)) {
+    return RET_OK;
+  }
+
+  if (mapping == NULL || *mapping == '\0') {
+    TKMEM_FREE(slider_circle->mapping);
+  } else {
+    slider_circle->mapping = tk_str_copy(slider_circle->mapping, mapping);
+  }
+  slider_circle_update_value_map(widget);
+
+  /*离散值列表可能改变当前的值*/
+  slider_circle_set_value_internal(widget, slider_circle->value, EVT_VALUE_CHANGED, FALSE);
 
   return widget_invalidate(widget, NULL);
 }
 
+float_t slider_circle_value_to_angle(widget_t* widget, double value) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, 0);
+
+  return slider_circle_mapping_to_angle(slider_circle->value_map, value, slider_circle->min,
+                                        slider_circle->max, slider_circle->start_angle,
+                                        slider_circle->end_angle,
+                                        SLIDER_CIRCLE_IS_CCW(slider_circle));
+}
+
+#ifndef SLIDER_CIRCLE_WITHOUT_PROPS
 static ret_t slider_circle_get_prop(widget_t* widget, const char* name, value_t* v) {
   slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
   return_value_if_fail(slider_circle != NULL && name != NULL && v != NULL, RET_BAD_PARAMS);
 
   if (tk_str_eq(SLIDER_CIRCLE_PROP_VALUE, name)) {
+    slider_circle_sync_source(widget);
     value_set_double(v, slider_circle->value);
     return RET_OK;
   } else if (tk_str_eq(SLIDER_CIRCLE_PROP_MIN, name)) {
@@ -233,7 +579,7 @@ static ret_t slider_circle_get_prop(widget_t* widget, const char* name, value_t*
     value_set_str(v, slider_circle->line_cap);
     return RET_OK;
   } else if (tk_str_eq(SLIDER_CIRCLE_PROP_COUNTER_CLOCK_WISE, name)) {
-    value_set_bool(v, slider_circle->counter_clock_wise);
+    value_set_bool(v, SLIDER_CIRCLE_IS_CCW(slider_circle));
     return RET_OK;
   } else if (tk_str_eq(SLIDER_CIRCLE_PROP_SHOW_TEXT, name)) {
     value_set_bool(v, slider_circle->show_text);
@@ -241,8 +587,38 @@ static ret_t slider_circle_get_prop(widget_t* widget, const char* name, value_t*
   } else if (tk_str_eq(SLIDER_CIRCLE_PROP_FORMAT, name)) {
     value_set_str(v, slider_circle->format);
     return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_SHOW_TICKS, name)) {
+    value_set_bool(v, slider_circle->show_ticks);
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_MAJOR_TICKS, name)) {
+    value_set_uint8(v, slider_circle->major_ticks);
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_TICK_MIN_GAP, name)) {
+    value_set_uint8(v, slider_circle->tick_min_gap);
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_TRACK_DITHER, name)) {
+    value_set_bool(v, slider_circle->track_dither);
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_MAPPING, name)) {
+    value_set_str(v, slider_circle->mapping);
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_ZONES, name)) {
+    value_set_str(v, slider_circle->zones);
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_PEAK_HOLD, name)) {
+    value_set_bool(v, slider_circle->peak_hold);
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_RENDER_BACKEND, name)) {
+    value_set_str(v, slider_circle_backend_to_str(slider_circle->render_backend));
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_ACTIVE_BACKEND, name)) {
+    value_set_str(v, slider_circle_backend_to_str(slider_circle->backend));
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_PEAK_DECAY, name)) {
+    value_set_float(v, slider_circle->peak_decay);
+    return RET_OK;
   } else if (tk_str_eq(WIDGET_PROP_INPUTING, name)) {
-    value_set_bool(v, slider_circle->dragging);
+    value_set_bool(v, SLIDER_CIRCLE_IS_DRAGGING(widget, slider_circle));
     return RET_OK;
   }
 
@@ -295,21 +671,137 @@ static ret_t slider_circle_set_prop(widget_t* widget, const char* name, const va
   } else if (tk_str_eq(SLIDER_CIRCLE_PROP_FORMAT, name)) {
     slider_circle_set_format(widget, value_str(v));
     return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_SHOW_TICKS, name)) {
+    slider_circle_set_show_ticks(widget, value_bool(v));
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_MAJOR_TICKS, name)) {
+    slider_circle_set_major_ticks(widget, value_uint8(v));
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_TICK_MIN_GAP, name)) {
+    slider_circle_set_tick_min_gap(widget, value_uint8(v));
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_TRACK_DITHER, name)) {
+    slider_circle_set_track_dither(widget, value_bool(v));
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_MAPPING, name)) {
+    slider_circle_set_mapping(widget, value_str(v));
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_ZONES, name)) {
+    slider_circle_set_zones(widget, value_str(v));
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_PEAK_HOLD, name)) {
+    slider_circle_set_peak_hold(widget, value_bool(v));
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_RENDER_BACKEND, name)) {
+    slider_circle_set_render_backend(widget, value_str(v));
+    return RET_OK;
+  } else if (tk_str_eq(SLIDER_CIRCLE_PROP_PEAK_DECAY, name)) {
+    slider_circle_set_peak_decay(widget, value_float(v));
+    return RET_OK;
   }
 
   return RET_NOT_FOUND;
 }
+#endif /*SLIDER_CIRCLE_WITHOUT_PROPS*/
 
 static ret_t slider_circle_on_destroy(widget_t* widget) {
   slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
   return_value_if_fail(widget != NULL && slider_circle != NULL, RET_BAD_PARAMS);
 
-  TKMEM_FREE(slider_circle->line_cap);
-  TKMEM_FREE(slider_circle->format);
+  slider_circle_pool_str_free(slider_circle->line_cap);
+  slider_circle_pool_str_free(slider_circle->format);
+  slider_circle->line_cap = NULL;
+  slider_circle->format = NULL;
+  slider_circle_bind_source(widget, NULL);
+  if (slider_circle->peak_idle != TK_INVALID_ID) {
+    idle_remove(slider_circle->peak_idle);
+    slider_circle->peak_idle = TK_INVALID_ID;
+  }
+  TKMEM_FREE(slider_circle->ingest);
+  TKMEM_FREE(slider_circle->zones);
+  TKMEM_FREE(slider_circle->zone_list);
+  TKMEM_FREE(slider_circle->mapping);
+  TKMEM_FREE(slider_circle->value_map);
+  TKMEM_FREE(slider_circle->cached_style.style_name);
+#ifndef SLIDER_CIRCLE_WITHOUT_TICKS
+  slider_circle_ticks_deinit(&(slider_circle->ticks));
+#endif /*SLIDER_CIRCLE_WITHOUT_TICKS*/
+#ifndef SLIDER_CIRCLE_WITHOUT_WARMUP
+  if (slider_circle->track_layer != NULL) {
+    slider_circle_layer_destroy(slider_circle->track_layer);
+    slider_circle->track_layer = NULL;
+  }
+#endif /*SLIDER_CIRCLE_WITHOUT_WARMUP*/
 
   return RET_OK;
 }
 
+static ret_t slider_circle_on_copy(widget_t* widget, widget_t* other) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  slider_circle_t* slider_circle_other = SLIDER_CIRCLE(other);
+  return_value_if_fail(slider_circle != NULL && slider_circle_other != NULL, RET_BAD_PARAMS);
+
+  /*直接拷贝字段，不经过set_prop，字符串相同时不重新分配，最后只刷新一次*/
+  slider_circle->value = slider_circle_other->value;
+  slider_circle->min = slider_circle_other->min;
+  slider_circle->max = slider_circle_other->max;
+  slider_circle->step = slider_circle_other->step;
+  slider_circle->start_angle = slider_circle_other->start_angle;
+  slider_circle->end_angle = slider_circle_other->end_angle;
+  slider_circle->fg_line_width = slider_circle_other->fg_line_width;
+  slider_circle->bg_line_width = slider_circle_other->bg_line_width;
+  slider_circle->header_size = slider_circle_other->header_size;
+  slider_circle->dragger_size = slider_circle_other->dragger_size;
+  slider_circle->counter_clock_wise = slider_circle_other->counter_clock_wise;
+  slider_circle->show_text = slider_circle_other->show_text;
+  slider_circle->show_ticks = slider_circle_other->show_ticks;
+  slider_circle->major_ticks = slider_circle_other->major_ticks;
+  slider_circle->tick_min_gap = slider_circle_other->tick_min_gap;
+  slider_circle->track_dither = slider_circle_other->track_dither;
+  slider_circle->peak_hold = slider_circle_other->peak_hold;
+  slider_circle->peak_decay = slider_circle_other->peak_decay;
+  slider_circle->render_backend = slider_circle_other->render_backend;
+  slider_circle->line_cap = slider_circle_pool_str_copy(slider_circle->line_cap,
+                                                        slider_circle_other->line_cap);
+  slider_circle->format = slider_circle_pool_str_copy(slider_circle->format,
+                                                      slider_circle_other->format);
+  if (slider_circle_other->zone_list != NULL) {
+    /*直接拷贝解析的结果，不重新解析*/
+    if (slider_circle->zone_list == NULL) {
+      slider_circle->zone_list = TKMEM_ZALLOC(slider_circle_zones_t);
+    }
+    if (slider_circle->zone_list != NULL) {
+      *(slider_circle->zone_list) = *(slider_circle_other->zone_list);
+      slider_circle->zones = tk_str_copy(slider_circle->zones, slider_circle_other->zones);
+    }
+  } else {
+    TKMEM_FREE(slider_circle->zone_list);
+    TKMEM_FREE(slider_circle->zones);
+  }
+  if (slider_circle_other->value_map != NULL) {
+    if (slider_circle->value_map == NULL) {
+      slider_circle->value_map = TKMEM_ZALLOC(slider_circle_mapping_t);
+    }
+    if (slider_circle->value_map != NULL) {
+      *(slider_circle->value_map) = *(slider_circle_other->value_map);
+      slider_circle->mapping = tk_str_copy(slider_circle->mapping, slider_circle_other->mapping);
+    }
+  } else {
+    TKMEM_FREE(slider_circle->value_map);
+    TKMEM_FREE(slider_circle->mapping);
+  }
+
+#ifndef SLIDER_CIRCLE_WITHOUT_TICKS
+  /*刻度布局只和参数有关，直接拷贝(字符串按内容比较)，第一次绘制时就能命中缓存*/
+  slider_circle_ticks_copy(&(slider_circle->ticks), &(slider_circle_other->ticks));
+#endif /*SLIDER_CIRCLE_WITHOUT_TICKS*/
+  slider_circle_update_paint(widget);
+  slider_circle_update_text(widget);
+
+  return widget_invalidate(widget, NULL);
+}
+
+#ifndef SLIDER_CIRCLE_WITHOUT_INPUT
 bool_t slider_circle_is_point_in_dragger(widget_t* widget, xy_t x, xy_t y) {
   double r = 0;
   double cx = 0;
@@ -317,15 +809,14 @@ bool_t slider_circle_is_point_in_dragger(widget_t* widget, xy_t x, xy_t y) {
   double value_angle = 0;
   point_t point = {x, y};
   slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
-  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(slider_circle != NULL && widget->vt->inputable, FALSE);
 
+  slider_circle_sync_source(widget);
   cx = widget->w / 2;
   cy = widget->h / 2;
   r = tk_min(cx, cy) - slider_circle->fg_line_width / 2;
   r = r - (slider_circle->bg_line_width - slider_circle->fg_line_width) / 2;
-  value_angle = tk_value_to_angle(slider_circle->value, slider_circle->min, slider_circle->max,
-                                  slider_circle->start_angle, slider_circle->end_angle,
-                                  slider_circle->counter_clock_wise);
+  value_angle = slider_circle_value_to_angle(widget, slider_circle->value);
 
   point.x = cx + r * cos(value_angle);
   point.y = cy + r * sin(value_angle);
@@ -362,12 +853,17 @@ double slider_circle_angle_to_value(widget_t* widget, double angle) {
   double range = 0;
   double range_angle = 0;
   slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
-  return_value_if_fail(slider_circle != NULL, 0);
+  return_value_if_fail(slider_circle != NULL && widget->vt->inputable, 0);
 
+  SLIDER_CIRCLE_TRACE_BEGIN(angle_to_value);
   range = slider_circle->max - slider_circle->min;
   range_angle = slider_circle->end_angle - slider_circle->start_angle;
 
-  if (slider_circle->counter_clock_wise) {
+  if (slider_circle->value_map != NULL) {
+    double pos = SLIDER_CIRCLE_IS_CCW(slider_circle) ? slider_circle->end_angle - angle
+                                                     : angle - slider_circle->start_angle;
+    value = slider_circle_mapping_to_value(slider_circle->value_map, pos / range_angle);
+  } else if (SLIDER_CIRCLE_IS_CCW(slider_circle)) {
     value = slider_circle->min + (range / range_angle) * (slider_circle->end_angle - angle);
   } else {
     value = slider_circle->min + (range / range_angle) * (angle - slider_circle->start_angle);
@@ -394,90 +890,715 @@ double slider_circle_angle_to_value(widget_t* widget, double angle) {
     }
   }
 
-  log_debug("prev=%lf value=%lf\n", slider_circle->prev_value, value);
+  value = tk_clamp(value, slider_circle->min, slider_circle->max);
+  SLIDER_CIRCLE_TRACE_END(angle_to_value);
 
-  return tk_clamp(value, slider_circle->min, slider_circle->max);
+  return value;
 }
 
 double slider_circle_point_to_value(widget_t* widget, xy_t x, xy_t y) {
   double angle = 0;
   slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
-  return_value_if_fail(slider_circle != NULL, 0);
+  return_value_if_fail(slider_circle != NULL && widget->vt->inputable, 0);
 
   angle = slider_circle_point_to_angle(widget, x, y);
   return slider_circle_angle_to_value(widget, angle);
 }
+#endif /*SLIDER_CIRCLE_WITHOUT_INPUT*/
 
-static ret_t slider_circle_on_paint_self(widget_t* widget, canvas_t* c) {
+static bool_t slider_circle_str_eq(const char* a, const char* b) {
+  return a == b || tk_str_eq(a, b);
+}
+
+/*widget(边框)和slider_circle绘制时用到，但是不需要缓存值的整数样式*/
+static const char* s_slider_circle_style_ints[SLIDER_CIRCLE_STYLE_INTS] = {
+    STYLE_ID_BORDER,
+    STYLE_ID_BORDER_WIDTH,
+    STYLE_ID_ROUND_RADIUS,
+    STYLE_ID_ROUND_RADIUS_TOP_LEFT,
+    STYLE_ID_ROUND_RADIUS_TOP_RIGHT,
+    STYLE_ID_ROUND_RADIUS_BOTTOM_LEFT,
+    STYLE_ID_ROUND_RADIUS_BOTTOM_RIGHT,
+    STYLE_ID_BG_IMAGE_DRAW_TYPE,
+    STYLE_ID_FG_IMAGE_DRAW_TYPE};
+
+static const slider_circle_style_t* slider_circle_get_style(widget_t* widget) {
+  uint32_t i = 0;
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  slider_circle_style_t* cs = &(slider_circle->cached_style);
+  style_t* style = widget->astyle;
+  color_t trans = color_init(0, 0, 0, 0);
+
+  if (cs->valid && cs->state == widget->state && cs->astyle == style &&
+      !style_is_mutable(style) && slider_circle_str_eq(cs->style_name, widget->style)) {
+    return cs;
+  }
+
+  cs->state = widget->state;
+  cs->astyle = style;
+  if (widget->style == NULL) {
+    TKMEM_FREE(cs->style_name);
+  } else if (!slider_circle_str_eq(cs->style_name, widget->style)) {
+    cs->style_name = tk_str_copy(cs->style_name, widget->style);
+  }
+  cs->fg_color = style_get_color(style, STYLE_ID_FG_COLOR, trans);
+  cs->bg_color = style_get_color(style, STYLE_ID_BG_COLOR, trans);
+  cs->dragger_color = style_get_color(style, STYLE_ID_DRAGGER_COLOR, trans);
+  if (cs->dragger_color.rgba.a == 0) {
+    cs->dragger_color = cs->fg_color;
+  }
+  cs->text_color = style_get_color(style, STYLE_ID_TEXT_COLOR, trans);
+  cs->tick_color = style_get_color(style, SLIDER_CIRCLE_STYLE_ID_TICK_COLOR, cs->text_color);
+  cs->peak_color = style_get_color(style, SLIDER_CIRCLE_STYLE_ID_PEAK_COLOR, cs->dragger_color);
+  cs->border_color = style_get_color(style, STYLE_ID_BORDER_COLOR, trans);
+  for (i = 0; i < ARRAY_SIZE(s_slider_circle_style_ints); i++) {
+    cs->ints[i] = style_get_int(style, s_slider_circle_style_ints[i], 0);
+  }
+  cs->fg_image = style_get_str(style, STYLE_ID_FG_IMAGE, NULL);
+  cs->bg_image = style_get_str(style, STYLE_ID_BG_IMAGE, NULL);
+  cs->font_name = style_get_str(style, STYLE_ID_FONT_NAME, NULL);
+  cs->font_size = style_get_int(style, STYLE_ID_FONT_SIZE, TK_DEFAULT_FONT_SIZE);
+  cs->text_align_h = style_get_int(style, STYLE_ID_TEXT_ALIGN_H, ALIGN_H_CENTER);
+  cs->text_align_v = style_get_int(style, STYLE_ID_TEXT_ALIGN_V, ALIGN_V_MIDDLE);
+  /*样式还没有按新的样式名或者主题更新，解析出来的值只能用这一次*/
+  cs->valid = !widget->need_update_style;
+
+  return cs;
+}
+
+#ifndef SLIDER_CIRCLE_WITHOUT_DIRECT
+static bool_t slider_circle_use_direct(slider_circle_t* slider_circle, canvas_t* c) {
+  return slider_circle->backend != SLIDER_CIRCLE_BACKEND_VGCANVAS &&
+         (slider_circle_direct_supported(c) || slider_circle_mono_supported(c));
+}
+#endif /*SLIDER_CIRCLE_WITHOUT_DIRECT*/
+
+/*画布(lcd)变化时重新选择绘制方式*/
+static ret_t slider_circle_update_backend(widget_t* widget, canvas_t* c) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+
+  if (slider_circle->backend_lcd == c->lcd) {
+    return RET_OK;
+  }
+
+  slider_circle->backend_lcd = c->lcd;
+  slider_circle->backend = slider_circle_backend_resolve(slider_circle->render_backend, c);
+  log_debug("slider_circle %s: render backend %s\n", widget->name ? widget->name : "",
+            slider_circle_backend_to_str(slider_circle->backend));
+
+  return RET_OK;
+}
+
+static ret_t slider_circle_draw_arc(widget_t* widget, canvas_t* c, color_t color,
+                                    const char* image_name, float_t line_width,
+                                    float_t start_angle, float_t end_angle, bool_t ccw,
+                                    slider_circle_raster_cap_t cap, float_t r, bool_t dither) {
+  bitmap_t img;
+  vgcanvas_t* vg = NULL;
+
+  if (line_width <= 0 || r <= 0 || start_angle == end_angle) {
+    return RET_OK;
+  }
+
+#ifndef SLIDER_CIRCLE_WITHOUT_DIRECT
+  /*纯色的圆弧直接画到framebuffer上，不经过vgcanvas的通用路径光栅化*/
+  if ((image_name == NULL || *image_name == '\0') && !ccw && start_angle < end_angle &&
+      slider_circle_use_direct(SLIDER_CIRCLE(widget), c)) {
+    slider_circle_raster_arc_t arc;
+
+    memset(&arc, 0x00, sizeof(arc));
+    arc.cx = widget->w / 2;
+    arc.cy = widget->h / 2;
+    arc.r = r;
+    arc.line_width = line_width;
+    arc.start_angle = start_angle;
+    arc.end_angle = end_angle;
+    arc.cap = cap;
+
+    if (slider_circle_mono_supported(c)) {
+      return slider_circle_mono_draw(c, &arc, color, dither);
+    }
+
+    return slider_circle_direct_draw(c, &arc, color);
+  }
+#endif /*SLIDER_CIRCLE_WITHOUT_DIRECT*/
+
+  vg = canvas_get_vgcanvas(c);
+  if (vg == NULL) {
+    return RET_OK;
+  }
+
+  vgcanvas_save(vg);
+  vgcanvas_translate(vg, c->ox, c->oy);
+  vgcanvas_set_line_width(vg, line_width);
+  vgcanvas_set_line_cap(vg, slider_circle_raster_cap_to_str(cap));
+
+  vgcanvas_begin_path(vg);
+  vgcanvas_arc(vg, widget->w / 2, widget->h / 2, r, start_angle, end_angle, ccw);
+  if (image_name != NULL && *image_name && widget_load_image(widget, image_name, &img) == RET_OK) {
+    vgcanvas_paint(vg, TRUE, &img);
+  } else if (color.rgba.a > 0) {
+    vgcanvas_set_stroke_color(vg, color);
+    vgcanvas_stroke(vg);
+  }
+  vgcanvas_restore(vg);
+
+  return RET_OK;
+}
+
+static uint32_t slider_circle_get_zone_angles(widget_t* widget, slider_circle_layer_zone_t* out) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  const slider_circle_zones_t* zones = slider_circle->zone_list;
+
+  if (zones == NULL || slider_circle->max <= slider_circle->min) {
+    return 0;
+  }
+
+  for (i = 0; i < zones->size; i++) {
+    const slider_circle_zone_t* zone = zones->zones + i;
+    double from = tk_clamp(zone->from, slider_circle->min, slider_circle->max);
+    double to = tk_clamp(zone->to, slider_circle->min, slider_circle->max);
+    float_t a0 = 0;
+    float_t a1 = 0;
+
+    if (from >= to || zone->color.rgba.a == 0) {
+      continue;
+    }
+
+    a0 = slider_circle_value_to_angle(widget, from);
+    a1 = slider_circle_value_to_angle(widget, to);
+    out[n].start_angle = tk_min(a0, a1);
+    out[n].end_angle = tk_max(a0, a1);
+    out[n].color = zone->color;
+    n++;
+  }
+
+  return n;
+}
+
+/*只绘制区间在[from, to]之间的部分(被填充部分盖住的不画)*/
+static ret_t slider_circle_paint_zones(widget_t* widget, canvas_t* c, float_t r, float_t from,
+                                       float_t to) {
+  uint32_t i = 0;
+  uint32_t k = 0;
+  uint32_t n = 0;
+  uint32_t nr = 0;
+  float_t cx = widget->w / 2;
+  float_t cy = widget->h / 2;
+  vgcanvas_t* vg = NULL;
+  slider_circle_layer_zone_t zones[SLIDER_CIRCLE_ZONES_MAX];
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  float_t line_width = slider_circle->bg_line_width;
+
+  nr = slider_circle_get_zone_angles(widget, zones);
+  for (i = 0; i < nr; i++) {
+    float_t start_angle = tk_max(zones[i].start_angle, from);
+    float_t end_angle = tk_min(zones[i].end_angle, to);
+
+    if (start_angle < end_angle) {
+      zones[n] = zones[i];
+      zones[n].start_angle = start_angle;
+      zones[n].end_angle = end_angle;
+      n++;
+    }
+  }
+
+  if (n == 0 || line_width <= 0 || r <= 0) {
+    return RET_OK;
+  }
+
+#ifndef SLIDER_CIRCLE_WITHOUT_DIRECT
+  if (slider_circle_use_direct(slider_circle, c)) {
+    for (i = 0; i < n; i++) {
+      slider_circle_draw_arc(widget, c, zones[i].color, NULL, line_width, zones[i].start_angle,
+                             zones[i].end_angle, FALSE, SLIDER_CIRCLE_RASTER_CAP_BUTT, r,
+                             slider_circle->track_dither);
+    }
+    return RET_OK;
+  }
+#endif /*SLIDER_CIRCLE_WITHOUT_DIRECT*/
+
+  vg = canvas_get_vgcanvas(c);
+  if (vg == NULL) {
+    return RET_OK;
+  }
+
+  vgcanvas_save(vg);
+  vgcanvas_translate(vg, c->ox, c->oy);
+  vgcanvas_set_line_width(vg, line_width);
+  vgcanvas_set_line_cap(vg, "butt");
+
+  /*颜色相同的区间放到同一条路径中，只描边一次*/
+  for (i = 0; i < n; i++) {
+    for (k = 0; k < i; k++) {
+      if (zones[k].color.color == zones[i].color.color) {
+        break;
+      }
+    }
+    if (k < i) {
+      continue;
+    }
+
+    vgcanvas_begin_path(vg);
+    for (k = i; k < n; k++) {
+      if (zones[k].color.color == zones[i].color.color) {
+        vgcanvas_move_to(vg, cx + r * cos(zones[k].start_angle),
+                         cy + r * sin(zones[k].start_angle));
+        vgcanvas_arc(vg, cx, cy, r, zones[k].start_angle, zones[k].end_angle, FALSE);
+      }
+    }
+    vgcanvas_set_stroke_color(vg, zones[i].color);
+    vgcanvas_stroke(vg);
+  }
+  vgcanvas_restore(vg);
+
+  return RET_OK;
+}
+
+#ifndef SLIDER_CIRCLE_WITHOUT_WARMUP
+static bool_t slider_circle_track_key(widget_t* widget, const slider_circle_style_t* cs,
+                                      slider_circle_layer_key_t* key) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+
+  /*图片填充的轨道仍然直接绘制*/
+  if ((cs->bg_image != NULL && *cs->bg_image) || cs->bg_color.rgba.a == 0 ||
+      slider_circle->bg_line_width == 0 || widget->w <= 0 || widget->h <= 0) {
+    return FALSE;
+  }
+
+  memset(key, 0x00, sizeof(*key));
+  key->w = widget->w;
+  key->h = widget->h;
+  key->color = cs->bg_color;
+  key->arc.cx = widget->w / 2;
+  key->arc.cy = widget->h / 2;
+  key->arc.r = tk_min(widget->w / 2, widget->h / 2) - slider_circle->bg_line_width / 2;
+  key->arc.line_width = slider_circle->bg_line_width;
+  key->arc.start_angle = TK_D2R(slider_circle->start_angle);
+  key->arc.end_angle = TK_D2R(slider_circle->end_angle);
+  key->arc.cap = slider_circle->cap;
+  key->zones_nr = slider_circle_get_zone_angles(widget, key->zones);
+
+  return key->arc.r > 0;
+}
+
+ret_t slider_circle_warmup_widget(widget_t* widget) {
+  slider_circle_layer_key_t key;
+  const slider_circle_style_t* cs = NULL;
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  /*工作线程启动之后，下次绘制时重新选择绘制方式*/
+  slider_circle->backend_lcd = NULL;
+  if (slider_circle->render_backend == SLIDER_CIRCLE_BACKEND_VGCANVAS ||
+      slider_circle->render_backend == SLIDER_CIRCLE_BACKEND_DIRECT) {
+    return RET_OK;
+  }
+
+  if (widget->need_update_style) {
+    widget_update_style(widget);
+  }
+  cs = slider_circle_get_style(widget);
+
+  if (slider_circle_track_key(widget, cs, &key)) {
+    slider_circle_layer_schedule(&(slider_circle->track_layer), &key);
+  }
+  /*拖动点的位图很小，外观相同的控件共用，直接生成到共享的缓存中*/
+  if (slider_circle->header_size > 0) {
+    slider_circle_sprite_prepare(slider_circle->header_size, cs->dragger_color);
+  }
+
+  return RET_OK;
+}
+#else
+ret_t slider_circle_warmup_widget(widget_t* widget) {
+  return RET_NOT_IMPL;
+}
+#endif /*SLIDER_CIRCLE_WITHOUT_WARMUP*/
+
+#ifndef SLIDER_CIRCLE_WITHOUT_TEXT
+static ret_t slider_circle_paint_text(widget_t* widget, canvas_t* c,
+                                      const slider_circle_style_t* cs) {
+  char text[TK_NUM_MAX_LEN + 1];
+  wchar_t wtext[TK_NUM_MAX_LEN + 1];
+  rect_t r = rect_init(0, 0, widget->w, widget->h);
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  ret_t ret = RET_OK;
+
+  SLIDER_CIRCLE_TRACE_BEGIN(paint_text);
+  slider_circle_format_value(text, sizeof(text), slider_circle->format, slider_circle->value);
+  tk_utf8_to_utf16(text, wtext, ARRAY_SIZE(wtext));
+
+  canvas_set_font(c, cs->font_name, cs->font_size);
+  canvas_set_text_color(c, cs->text_color);
+  canvas_set_text_align(c, (align_h_t)(cs->text_align_h), (align_v_t)(cs->text_align_v));
+
+  ret = canvas_draw_text_in_rect(c, wtext, wcslen(wtext), &r);
+  SLIDER_CIRCLE_TRACE_END(paint_text);
+
+  return ret;
+}
+#endif /*SLIDER_CIRCLE_WITHOUT_TEXT*/
+
+static ret_t slider_circle_paint_peaks(widget_t* widget, canvas_t* c,
+                                       const slider_circle_style_t* cs, float_t r) {
+  uint32_t i = 0;
+  double peaks[2];
+  float_t half = 0;
+  float_t line_width = 0;
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  const slider_circle_ingest_t* ingest = slider_circle->ingest;
+
+  if (!slider_circle->peak_hold || ingest == NULL || !ingest->has_peaks || r <= 0 ||
+      slider_circle->max <= slider_circle->min) {
+    return RET_OK;
+  }
+
+  /*标记是横跨轨道、宽度约3个像素的短圆弧*/
+  peaks[0] = ingest->peak_min;
+  peaks[1] = ingest->peak_max;
+  half = 1.5f / r;
+  line_width = tk_max(slider_circle->bg_line_width, slider_circle->fg_line_width);
+  for (i = 0; i < ARRAY_SIZE(peaks); i++) {
+    double value = tk_clamp(peaks[i], slider_circle->min, slider_circle->max);
+    float_t angle = slider_circle_value_to_angle(widget, value);
+
+    slider_circle_draw_arc(widget, c, cs->peak_color, NULL, line_width, angle - half,
+                           angle + half, FALSE, SLIDER_CIRCLE_RASTER_CAP_BUTT, r, FALSE);
+  }
+
+  return RET_OK;
+}
+
+/*
+ * 绘制前景。方向、拖动点、文本和线帽由参数决定：特化的函数传入常量，内联之后去掉用不到的分支，
+ * 通用的函数传入字段的值。
+ */
+SLIDER_CIRCLE_FORCE_INLINE ret_t slider_circle_paint_self_impl(widget_t* widget, canvas_t* c,
+                                                              bool_t ccw, bool_t dragger,
+                                                              bool_t text,
+                                                              slider_circle_raster_cap_t cap) {
   double r = 0;
   double cx = 0;
   double cy = 0;
   double value_angle = 0;
+  const slider_circle_style_t* cs = NULL;
   slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
-  return_value_if_fail(slider_circle != NULL && c != NULL, RET_BAD_PARAMS);
 
+  SLIDER_CIRCLE_TRACE_BEGIN(paint_foreground);
+  slider_circle_sync_source(widget);
+  cs = slider_circle_get_style(widget);
   cx = widget->w / 2;
   cy = widget->h / 2;
   r = tk_min(cx, cy) - slider_circle->fg_line_width / 2;
   r = r - (slider_circle->bg_line_width - slider_circle->fg_line_width) / 2;
-  value_angle = tk_value_to_angle(slider_circle->value, slider_circle->min, slider_circle->max,
-                                  slider_circle->start_angle, slider_circle->end_angle,
-                                  slider_circle->counter_clock_wise);
+  value_angle = slider_circle_value_to_angle(widget, slider_circle->value);
 
-  if (slider_circle->counter_clock_wise) {
-    widget_draw_arc_at_center(widget, c, FALSE, slider_circle->fg_line_width, value_angle,
-                              TK_D2R(slider_circle->end_angle), FALSE, slider_circle->line_cap, r);
+  if (ccw) {
+    slider_circle_draw_arc(widget, c, cs->fg_color, cs->fg_image, slider_circle->fg_line_width,
+                           value_angle, TK_D2R(slider_circle->end_angle), FALSE,
+                           cap, r, FALSE);
   } else {
-    widget_draw_arc_at_center(widget, c, FALSE, slider_circle->fg_line_width,
-                              TK_D2R(slider_circle->start_angle), value_angle, FALSE,
-                              slider_circle->line_cap, r);
+    slider_circle_draw_arc(widget, c, cs->fg_color, cs->fg_image, slider_circle->fg_line_width,
+                           TK_D2R(slider_circle->start_angle), value_angle, FALSE,
+                           cap, r, FALSE);
   }
+  slider_circle_paint_peaks(widget, c, cs, r);
 
-  if (slider_circle->header_size > 0) {
-    double dragger_x = c->ox + cx + r * cos(value_angle);
-    double dragger_y = c->oy + cy + r * sin(value_angle);
-    vgcanvas_t* vg = canvas_get_vgcanvas(c);
-    color_t color = style_get_color(widget->astyle, STYLE_ID_DRAGGER_COLOR, color_init(0, 0, 0, 0));
+  if (dragger) {
+    double dragger_x = cx + r * cos(value_angle);
+    double dragger_y = cy + r * sin(value_angle);
+    ret_t ret = RET_FAIL;
 
-    if (color.rgba.a == 0) {
-      color = style_get_color(widget->astyle, STYLE_ID_FG_COLOR, color_init(0, 0, 0, 0));
+    /*按选择的绘制方式：sprite贴共享的位图，direct直接光栅化，不可用时填充路径*/
+    if (slider_circle->backend == SLIDER_CIRCLE_BACKEND_SPRITE) {
+      ret = slider_circle_sprite_draw(c, slider_circle->header_size, cs->dragger_color, dragger_x,
+                                      dragger_y);
     }
+#ifndef SLIDER_CIRCLE_WITHOUT_DIRECT
+    else if (slider_circle_use_direct(slider_circle, c)) {
+      slider_circle_raster_arc_t arc;
+
+      memset(&arc, 0x00, sizeof(arc));
+      arc.cx = dragger_x;
+      arc.cy = dragger_y;
+      arc.r = slider_circle->header_size;
+      if (slider_circle_mono_supported(c)) {
+        slider_circle_mono_draw(c, &arc, cs->dragger_color, FALSE);
+      } else {
+        slider_circle_direct_draw(c, &arc, cs->dragger_color);
+      }
+      ret = RET_OK;
+    }
+#endif /*SLIDER_CIRCLE_WITHOUT_DIRECT*/
 
-    vgcanvas_draw_circle(vg, dragger_x, dragger_y, slider_circle->header_size, color, TRUE, FALSE);
+    if (ret != RET_OK) {
+      vgcanvas_draw_circle(canvas_get_vgcanvas(c), c->ox + dragger_x, c->oy + dragger_y,
+                           slider_circle->header_size, cs->dragger_color, TRUE, FALSE);
+    }
   }
+  SLIDER_CIRCLE_TRACE_END(paint_foreground);
 
-  if (slider_circle->show_text) {
-    widget_set_text_with_double(widget, slider_circle->format, slider_circle->value);
-    widget_paint_helper(widget, c, NULL, NULL);
+#ifndef SLIDER_CIRCLE_WITHOUT_TEXT
+  if (text) {
+    slider_circle_paint_text(widget, c, cs);
   }
+#endif /*SLIDER_CIRCLE_WITHOUT_TEXT*/
+  slider_circle_get_render_key(widget, slider_circle->value, &(slider_circle->render_key));
+  slider_circle->render_key_valid = TRUE;
 
   return RET_OK;
 }
 
+static ret_t slider_circle_paint_self_generic(widget_t* widget, canvas_t* c) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+
+  return slider_circle_paint_self_impl(widget, c, SLIDER_CIRCLE_IS_CCW(slider_circle),
+                                       slider_circle->header_size > 0, slider_circle->show_text,
+                                       slider_circle->cap);
+}
+
+#ifndef SLIDER_CIRCLE_WITHOUT_SPECIALIZE
+static bool_t s_specialized_paint = TRUE;
+
+#define SLIDER_CIRCLE_PAINT_FUNC(name, ccw, dragger, text, cap)                 \
+  static ret_t slider_circle_paint_self_##name(widget_t* widget, canvas_t* c) { \
+    return slider_circle_paint_self_impl(widget, c, ccw, dragger, text,         \
+                                         SLIDER_CIRCLE_RASTER_CAP_##cap);       \
+  }
+
+#define SLIDER_CIRCLE_PAINT_FUNCS(cap)                                    \
+  SLIDER_CIRCLE_PAINT_FUNC(cw_##cap, FALSE, FALSE, FALSE, cap)            \
+  SLIDER_CIRCLE_PAINT_FUNC(cw_text_##cap, FALSE, FALSE, TRUE, cap)        \
+  SLIDER_CIRCLE_PAINT_FUNC(cw_dragger_##cap, FALSE, TRUE, FALSE, cap)     \
+  SLIDER_CIRCLE_PAINT_FUNC(cw_dragger_text_##cap, FALSE, TRUE, TRUE, cap) \
+  SLIDER_CIRCLE_PAINT_FUNC(ccw_##cap, TRUE, FALSE, FALSE, cap)            \
+  SLIDER_CIRCLE_PAINT_FUNC(ccw_text_##cap, TRUE, FALSE, TRUE, cap)        \
+  SLIDER_CIRCLE_PAINT_FUNC(ccw_dragger_##cap, TRUE, TRUE, FALSE, cap)     \
+  SLIDER_CIRCLE_PAINT_FUNC(ccw_dragger_text_##cap, TRUE, TRUE, TRUE, cap)
+
+SLIDER_CIRCLE_PAINT_FUNCS(BUTT)
+SLIDER_CIRCLE_PAINT_FUNCS(ROUND)
+SLIDER_CIRCLE_PAINT_FUNCS(SQUARE)
+
+#define SLIDER_CIRCLE_PAINT_ENTRY(cap)                                             \
+  {{{slider_circle_paint_self_cw_##cap, slider_circle_paint_self_cw_text_##cap},   \
+    {slider_circle_paint_self_cw_dragger_##cap,                                    \
+     slider_circle_paint_self_cw_dragger_text_##cap}},                             \
+   {{slider_circle_paint_self_ccw_##cap, slider_circle_paint_self_ccw_text_##cap}, \
+    {slider_circle_paint_self_ccw_dragger_##cap,                                   \
+     slider_circle_paint_self_ccw_dragger_text_##cap}}}
+
+/*按[线帽][方向][拖动点][文本]索引*/
+static const slider_circle_paint_func_t s_paint_funcs[3][2][2][2] = {
+    SLIDER_CIRCLE_PAINT_ENTRY(BUTT), SLIDER_CIRCLE_PAINT_ENTRY(ROUND),
+    SLIDER_CIRCLE_PAINT_ENTRY(SQUARE)};
+#endif /*SLIDER_CIRCLE_WITHOUT_SPECIALIZE*/
+
+ret_t slider_circle_update_paint(widget_t* widget) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  slider_circle->cap = slider_circle_raster_cap_from_str(slider_circle->line_cap);
+#ifndef SLIDER_CIRCLE_WITHOUT_SPECIALIZE
+  slider_circle->paint_self =
+      s_paint_funcs[slider_circle->cap][SLIDER_CIRCLE_IS_CCW(slider_circle) ? 1 : 0]
+                   [slider_circle->header_size > 0 ? 1 : 0][slider_circle->show_text ? 1 : 0];
+#else
+  slider_circle->paint_self = NULL;
+#endif /*SLIDER_CIRCLE_WITHOUT_SPECIALIZE*/
+
+  return RET_OK;
+}
+
+ret_t slider_circle_set_specialized_paint(bool_t enabled) {
+#ifndef SLIDER_CIRCLE_WITHOUT_SPECIALIZE
+  s_specialized_paint = enabled;
+
+  return RET_OK;
+#else
+  return RET_NOT_IMPL;
+#endif /*SLIDER_CIRCLE_WITHOUT_SPECIALIZE*/
+}
+
+static ret_t slider_circle_on_paint_self(widget_t* widget, canvas_t* c) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL && c != NULL, RET_BAD_PARAMS);
+
+#ifndef SLIDER_CIRCLE_WITHOUT_SPECIALIZE
+  if (s_specialized_paint && slider_circle->paint_self != NULL) {
+    return slider_circle->paint_self(widget, c);
+  }
+#endif /*SLIDER_CIRCLE_WITHOUT_SPECIALIZE*/
+
+  return slider_circle_paint_self_generic(widget, c);
+}
+
+#ifndef SLIDER_CIRCLE_WITHOUT_TICKS
+static ret_t slider_circle_paint_ticks(widget_t* widget, canvas_t* c,
+                                       const slider_circle_style_t* cs) {
+  slider_circle_ticks_params_t params;
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+
+  /*参数没有变化时直接使用缓存的刻度位置和标签*/
+  memset(&params, 0x00, sizeof(params));
+  params.min = slider_circle->min;
+  params.max = slider_circle->max;
+  params.step = slider_circle->step;
+  params.format = slider_circle->format;
+  params.mapping = slider_circle->mapping;
+  params.font_name = cs->font_name;
+  params.font_size = cs->font_size * 2 / 3;
+  params.w = widget->w;
+  params.h = widget->h;
+  params.start_angle = slider_circle->start_angle;
+  params.end_angle = slider_circle->end_angle;
+  params.line_width = tk_max(slider_circle->bg_line_width, slider_circle->fg_line_width);
+  params.major_ticks = slider_circle->major_ticks;
+  params.min_gap = slider_circle->tick_min_gap;
+  params.counter_clock_wise = SLIDER_CIRCLE_IS_CCW(slider_circle);
+  slider_circle_ticks_update(&(slider_circle->ticks), c, &params);
+
+  return slider_circle_ticks_paint(&(slider_circle->ticks), c, cs->tick_color, cs->text_color);
+}
+#endif /*SLIDER_CIRCLE_WITHOUT_TICKS*/
+
+/*填充部分不透明并且不比轨道窄时，会完全盖住轨道上被填充的部分*/
+static bool_t slider_circle_fill_covers_track(widget_t* widget, const slider_circle_style_t* cs) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+
+  return slider_circle->fg_line_width >= slider_circle->bg_line_width &&
+         (cs->fg_image == NULL || *cs->fg_image == '\0') && cs->fg_color.rgba.a == 0xff;
+}
+
 static ret_t slider_circle_on_paint_background(widget_t* widget, canvas_t* c) {
   double r = 0;
+  bool_t track_painted = FALSE;
+  const slider_circle_style_t* cs = NULL;
   slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
   return_value_if_fail(slider_circle != NULL && c != NULL, RET_BAD_PARAMS);
+
+  SLIDER_CIRCLE_TRACE_BEGIN(paint_background);
+  slider_circle_update_backend(widget, c);
+  slider_circle_sync_source(widget);
+  slider_circle_commit_ingest(widget);
+  cs = slider_circle_get_style(widget);
   r = tk_min(widget->w / 2, widget->h / 2) - slider_circle->bg_line_width / 2;
 
-  widget_draw_arc_at_center(widget, c, TRUE, slider_circle->bg_line_width,
-                            TK_D2R(slider_circle->start_angle), TK_D2R(slider_circle->end_angle),
-                            FALSE, slider_circle->line_cap, r);
+#ifndef SLIDER_CIRCLE_WITHOUT_WARMUP
+  if (slider_circle->backend == SLIDER_CIRCLE_BACKEND_SPRITE && slider_circle->track_layer != NULL) {
+    /*预先生成的轨道已经完成并且参数没有变化时直接贴图，否则直接绘制*/
+    slider_circle_layer_key_t key;
+    bitmap_t* track = NULL;
+
+    if (slider_circle_track_key(widget, cs, &key)) {
+      track = slider_circle_layer_adopt(slider_circle->track_layer, &key);
+    }
+    if (track != NULL) {
+      canvas_draw_image_at(c, track, 0, 0);
+      track_painted = TRUE;
+    }
+  }
+#endif /*SLIDER_CIRCLE_WITHOUT_WARMUP*/
+
+  if (!track_painted) {
+    float_t start_angle = TK_D2R(slider_circle->start_angle);
+    float_t end_angle = TK_D2R(slider_circle->end_angle);
+
+    /*
+     * 只描边没有被填充部分盖住的轨道，避免同样的像素画两次。
+     * 接缝处向填充部分多画一个像素，两次抗锯齿之间不会露出缝隙，接缝处的线帽也在填充部分下面。
+     */
+    if (slider_circle_fill_covers_track(widget, cs)) {
+      float_t seam = slider_circle_value_to_angle(widget, slider_circle->value);
+      float_t overlap = r > 1 ? 1 / r : 0;
+
+      if (SLIDER_CIRCLE_IS_CCW(slider_circle)) {
+        end_angle = tk_min(seam + overlap, end_angle);
+      } else {
+        start_angle = tk_max(seam - overlap, start_angle);
+      }
+    }
+
+    if (start_angle < end_angle) {
+      slider_circle_draw_arc(widget, c, cs->bg_color, cs->bg_image, slider_circle->bg_line_width,
+                             start_angle, end_angle, FALSE, slider_circle->cap, r,
+                             slider_circle->track_dither);
+      slider_circle_paint_zones(widget, c, r, start_angle, end_angle);
+    }
+  }
+
+#ifndef SLIDER_CIRCLE_WITHOUT_TICKS
+  if (slider_circle->show_ticks) {
+    slider_circle_paint_ticks(widget, c, cs);
+  }
+#endif /*SLIDER_CIRCLE_WITHOUT_TICKS*/
+  SLIDER_CIRCLE_TRACE_END(paint_background);
 
   return RET_OK;
 }
 
+#ifndef SLIDER_CIRCLE_WITHOUT_INPUT
+
+static bool_t slider_circle_style_equal(const slider_circle_style_t* a,
+                                        const slider_circle_style_t* b) {
+  return a->fg_color.color == b->fg_color.color && a->bg_color.color == b->bg_color.color &&
+         a->dragger_color.color == b->dragger_color.color &&
+         a->text_color.color == b->text_color.color &&
+         a->tick_color.color == b->tick_color.color &&
+         a->peak_color.color == b->peak_color.color &&
+         a->border_color.color == b->border_color.color && a->font_size == b->font_size &&
+         a->text_align_h == b->text_align_h && a->text_align_v == b->text_align_v &&
+         memcmp(a->ints, b->ints, sizeof(a->ints)) == 0 &&
+         slider_circle_str_eq(a->fg_image, b->fg_image) &&
+         slider_circle_str_eq(a->bg_image, b->bg_image) &&
+         slider_circle_str_eq(a->font_name, b->font_name);
+}
+
+/*
+ * 状态没有变化时什么也不做(指针移动时不重复设置状态、不重新解析样式)；
+ * 状态变化之后解析出的样式值都一样时只更新状态，不重绘。
+ * 子类和子控件可能用到其它样式，无法判断，总是重绘。
+ * 与widget_set_state的区别只在于最后是否刷新。
+ */
+static ret_t slider_circle_update_state(widget_t* widget, const char* state) {
+  slider_circle_style_t old;
+
+  if (tk_str_eq(widget->state, state)) {
+    return RET_OK;
+  }
+
+  old = *slider_circle_get_style(widget);
+  widget->state = state;
+  widget_update_style(widget);
+
+  if (widget->vt == TK_REF_VTABLE(slider_circle) && widget_count_children(widget) == 0 &&
+      slider_circle_style_equal(&old, slider_circle_get_style(widget))) {
+    return RET_OK;
+  }
+
+  return widget_invalidate(widget, NULL);
+}
+#endif /*SLIDER_CIRCLE_WITHOUT_INPUT*/
+
 static ret_t slider_circle_on_event(widget_t* widget, event_t* e) {
+  ret_t ret = RET_OK;
   uint16_t type = e->type;
   slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
   return_value_if_fail(widget != NULL && slider_circle != NULL, RET_BAD_PARAMS);
 
+  SLIDER_CIRCLE_TRACE_BEGIN(on_event);
   switch (type) {
+#ifndef SLIDER_CIRCLE_WITHOUT_INPUT
     case EVT_POINTER_DOWN: {
       pointer_event_t* pointer_event = pointer_event_cast(e);
 
+      /*从数据源发布的值开始拖动，取消拖动时也恢复到这个值*/
+      slider_circle_sync_source(widget);
       if (slider_circle_is_point_in_dragger(widget, pointer_event->x, pointer_event->y)) {
-        widget_set_state(widget, WIDGET_STATE_PRESSED);
+        slider_circle_update_state(widget, WIDGET_STATE_PRESSED);
         widget_grab(widget->parent, widget);
         slider_circle->save_value = slider_circle->value;
         slider_circle->prev_value = slider_circle->value;
@@ -487,15 +1608,19 @@ static ret_t slider_circle_on_event(widget_t* widget, event_t* e) {
       break;
     }
     case EVT_POINTER_DOWN_ABORT: {
-      widget_set_state(widget, WIDGET_STATE_NORMAL);
+      slider_circle_update_state(widget, WIDGET_STATE_NORMAL);
       widget_ungrab(widget->parent, widget);
 
       slider_circle->dragging = FALSE;
-      slider_circle->value = slider_circle->save_value;
+      if (slider_circle->value != slider_circle->save_value) {
+        slider_circle->value = slider_circle->save_value;
+        slider_circle_update_text(widget);
+        widget_invalidate(widget, NULL);
+      }
       break;
     }
     case EVT_POINTER_UP: {
-      widget_set_state(widget, WIDGET_STATE_NORMAL);
+      slider_circle_update_state(widget, WIDGET_STATE_NORMAL);
       widget_ungrab(widget->parent, widget);
       slider_circle->dragging = FALSE;
 
@@ -512,29 +1637,33 @@ static ret_t slider_circle_on_event(widget_t* widget, event_t* e) {
 
         slider_circle->prev_value = value;
         slider_circle_set_value_internal(widget, value, EVT_VALUE_CHANGING, FALSE);
-
-        log_debug("value:%f\n", slider_circle->value);
-        widget_set_state(widget, WIDGET_STATE_PRESSED);
-        widget_invalidate(widget, NULL);
-        return RET_STOP;
+        /*值变化时set_value_internal已经刷新，这里只在状态变化时处理*/
+        slider_circle_update_state(widget, WIDGET_STATE_PRESSED);
+        ret = RET_STOP;
       } else {
-        widget_set_state(widget, WIDGET_STATE_OVER);
+        slider_circle_update_state(widget, WIDGET_STATE_OVER);
       }
       break;
     }
     case EVT_POINTER_LEAVE:
-      widget_set_state(widget, WIDGET_STATE_NORMAL);
+      slider_circle_update_state(widget, WIDGET_STATE_NORMAL);
       break;
     case EVT_POINTER_ENTER:
-      widget_set_state(widget, WIDGET_STATE_OVER);
+      slider_circle_update_state(widget, WIDGET_STATE_OVER);
+      break;
+#endif /*SLIDER_CIRCLE_WITHOUT_INPUT*/
+    case EVT_THEME_CHANGED:
+      slider_circle->cached_style.valid = FALSE;
       break;
     default:
       break;
   }
+  SLIDER_CIRCLE_TRACE_END(on_event);
 
-  return RET_OK;
+  return ret;
 }
 
+#ifndef SLIDER_CIRCLE_WITHOUT_PROPS
 const char* s_slider_circle_properties[] = {SLIDER_CIRCLE_PROP_VALUE,
                                             SLIDER_CIRCLE_PROP_MIN,
                                             SLIDER_CIRCLE_PROP_MAX,
@@ -549,24 +1678,40 @@ const char* s_slider_circle_properties[] = {SLIDER_CIRCLE_PROP_VALUE,
                                             SLIDER_CIRCLE_PROP_COUNTER_CLOCK_WISE,
                                             SLIDER_CIRCLE_PROP_SHOW_TEXT,
                                             SLIDER_CIRCLE_PROP_FORMAT,
+                                            SLIDER_CIRCLE_PROP_SHOW_TICKS,
+                                            SLIDER_CIRCLE_PROP_MAJOR_TICKS,
+                                            SLIDER_CIRCLE_PROP_TICK_MIN_GAP,
+                                            SLIDER_CIRCLE_PROP_TRACK_DITHER,
+                                            SLIDER_CIRCLE_PROP_ZONES,
+                                            SLIDER_CIRCLE_PROP_MAPPING,
+                                            SLIDER_CIRCLE_PROP_PEAK_HOLD,
+                                            SLIDER_CIRCLE_PROP_PEAK_DECAY,
+                                            SLIDER_CIRCLE_PROP_RENDER_BACKEND,
                                             NULL};
+#endif /*SLIDER_CIRCLE_WITHOUT_PROPS*/
 
 TK_DECL_VTABLE(slider_circle) = {.size = sizeof(slider_circle_t),
+#ifndef SLIDER_CIRCLE_WITHOUT_INPUT
                                  .inputable = TRUE,
+#endif /*SLIDER_CIRCLE_WITHOUT_INPUT*/
                                  .type = WIDGET_TYPE_SLIDER_CIRCLE,
+#ifndef SLIDER_CIRCLE_WITHOUT_PROPS
                                  .clone_properties = s_slider_circle_properties,
                                  .persistent_properties = s_slider_circle_properties,
+                                 .set_prop = slider_circle_set_prop,
+                                 .get_prop = slider_circle_get_prop,
+#endif /*SLIDER_CIRCLE_WITHOUT_PROPS*/
                                  .parent = TK_PARENT_VTABLE(widget),
                                  .create = slider_circle_create,
                                  .on_paint_self = slider_circle_on_paint_self,
                                  .on_paint_background = slider_circle_on_paint_background,
-                                 .set_prop = slider_circle_set_prop,
-                                 .get_prop = slider_circle_get_prop,
                                  .on_event = slider_circle_on_event,
+                                 .on_copy = slider_circle_on_copy,
                                  .on_destroy = slider_circle_on_destroy};
 
-widget_t* slider_circle_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
-  widget_t* widget = widget_create(parent, TK_REF_VTABLE(slider_circle), x, y, w, h);
+static widget_t* slider_circle_create_with_vtable(widget_t* parent, const widget_vtable_t* vt,
+                                                  xy_t x, xy_t y, wh_t w, wh_t h) {
+  widget_t* widget = widget_create(parent, vt, x, y, w, h);
   slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
   return_value_if_fail(slider_circle != NULL, NULL);
 
@@ -581,13 +1726,70 @@ widget_t* slider_circle_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h)
   slider_circle->header_size = 8;
   slider_circle->dragger_size = 10;
   slider_circle->show_text = TRUE;
-  slider_circle->format = tk_strdup("%d");
+  slider_circle->format = slider_circle_pool_str_copy(NULL, "%d");
+  slider_circle->major_ticks = 10;
+  slider_circle->tick_min_gap = 4;
+#ifndef SLIDER_CIRCLE_WITHOUT_TICKS
+  slider_circle_ticks_init(&(slider_circle->ticks));
+#endif /*SLIDER_CIRCLE_WITHOUT_TICKS*/
+  slider_circle_update_paint(widget);
+  slider_circle_update_text(widget);
 
   return widget;
 }
 
+widget_t* slider_circle_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
+  return slider_circle_create_with_vtable(parent, TK_REF_VTABLE(slider_circle), x, y, w, h);
+}
+
 widget_t* slider_circle_cast(widget_t* widget) {
   return_value_if_fail(WIDGET_IS_INSTANCE_OF(widget, slider_circle), NULL);
 
   return widget;
 }
+
+static ret_t gauge_circle_on_event(widget_t* widget, event_t* e) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  /*指针事件不会分发到这里，只需要处理主题变化*/
+  if (e->type == EVT_THEME_CHANGED) {
+    slider_circle->cached_style.valid = FALSE;
+  }
+
+  return RET_OK;
+}
+
+/*与slider_circle共用对象、属性和绘制函数，只是不可输入*/
+TK_DECL_VTABLE(gauge_circle) = {.size = sizeof(slider_circle_t),
+                                .type = WIDGET_TYPE_GAUGE_CIRCLE,
+#ifndef SLIDER_CIRCLE_WITHOUT_PROPS
+                                .clone_properties = s_slider_circle_properties,
+                                .persistent_properties = s_slider_circle_properties,
+                                .set_prop = slider_circle_set_prop,
+                                .get_prop = slider_circle_get_prop,
+#endif /*SLIDER_CIRCLE_WITHOUT_PROPS*/
+                                .parent = TK_PARENT_VTABLE(slider_circle),
+                                .create = gauge_circle_create,
+                                .on_paint_self = slider_circle_on_paint_self,
+                                .on_paint_background = slider_circle_on_paint_background,
+                                .on_event = gauge_circle_on_event,
+                                .on_copy = slider_circle_on_copy,
+                                .on_destroy = slider_circle_on_destroy};
+
+widget_t* gauge_circle_create(widget_t* parent, xy_t x, xy_t y, wh_t w, wh_t h) {
+  widget_t* widget =
+      slider_circle_create_with_vtable(parent, TK_REF_VTABLE(gauge_circle), x, y, w, h);
+  return_value_if_fail(widget != NULL, NULL);
+
+  /*不参与指针事件的分发，事件直接到后面的控件*/
+  widget->sensitive = FALSE;
+
+  return widget;
+}
+
+widget_t* gauge_circle_cast(widget_t* widget) {
+  return_value_if_fail(WIDGET_IS_INSTANCE_OF(widget, gauge_circle), NULL);
+
+  return widget;
+}
@@ -23,8 +23,71 @@
 #define TK_SLIDER_CIRCLE_H
 
 #include "base/widget.h"
+#include "slider_circle_ticks.h"
+#include "slider_circle_ingest.h"
+#include "slider_circle_backend.h"
+#include "slider_circle_mapping.h"
+#include "slider_circle_warmup.h"
 
 BEGIN_C_DECLS
+
+/*slider_circle_style_t中只用于比较的整数样式的个数*/
+#define SLIDER_CIRCLE_STYLE_INTS 9
+
+/**
+ * @class slider_circle_style_t
+ * 绘制时用到的样式值。
+ *
+ * 只在状态、主题或者样式变化时重新从style中解析，避免每次绘制都查找style。
+ * 可修改的样式(style_mutable)被直接修改时没有通知，每次绘制都重新解析。
+ */
+typedef struct _slider_circle_style_t {
+  const char* state;
+  style_t* astyle;
+  /*解析时widget使用的样式名(拷贝)，widget_use_style不改变astyle，只改变样式名*/
+  char* style_name;
+  color_t fg_color;
+  color_t bg_color;
+  color_t dragger_color;
+  color_t text_color;
+  color_t tick_color;
+  color_t peak_color;
+  /*边框由widget绘制，只用于判断状态变化之后是否需要重绘*/
+  color_t border_color;
+  /*边框、圆角和图片的绘制方式等整数样式，只用于判断状态变化之后是否需要重绘*/
+  int32_t ints[SLIDER_CIRCLE_STYLE_INTS];
+  const char* fg_image;
+  const char* bg_image;
+  const char* font_name;
+  uint16_t font_size;
+  uint8_t text_align_h;
+  uint8_t text_align_v;
+  bool_t valid;
+} slider_circle_style_t;
+
+/*圆弧终点的精度(每个像素分成几份)*/
+#define SLIDER_CIRCLE_RENDER_KEY_SUBPIXEL 4
+
+/**
+ * @class slider_circle_render_key_t
+ * 值决定的绘制结果(拖动点的像素位置、圆弧的终点和文本)。
+ *
+ * 值变化之后与上次绘制时的结果相同(如拖动点移动不到一个像素，文本也没有变化)时不重绘。
+ */
+typedef struct _slider_circle_render_key_t {
+  int32_t dragger_x;
+  int32_t dragger_y;
+  /*圆弧终点沿圆弧的位置(单位为1/SLIDER_CIRCLE_RENDER_KEY_SUBPIXEL像素)*/
+  int32_t arc_end;
+  char text[TK_NUM_MAX_LEN + 1];
+} slider_circle_render_key_t;
+
+/*
+ * 绘制前景(圆弧、拖动点和文本)的函数。
+ * 按方向、是否有拖动点、是否显示文本和线帽选择特化的版本，配置变化时重新选择。
+ */
+typedef ret_t (*slider_circle_paint_func_t)(widget_t* widget, canvas_t* c);
+
 /**
  * @class slider_circle_t
  * @parent widget_t
@@ -37,12 +100,19 @@ BEGIN_C_DECLS
  * <slider_circle start_angle="120" end_angle="420" line_cap="round" value="30" counter_clock_wise="true" bg_line_width="2" fg_line_width="8"/>
  * ```
  *
+ * 显示刻度和刻度标签(每10个步长一个主刻度)：
+ *
+ * ```xml
+ * <!-- ui -->
+ * <slider_circle start_angle="120" end_angle="420" show_ticks="true" major_ticks="10" tick_min_gap="4"/>
+ * ```
+ *
  * 可用通过style来设置控件的显示风格，如字体的大小和颜色等等。如：
  * 
  * ```xml
  * <!-- style -->
  * <style name="default" font_size="18" bg_color="black" fg_color="#00f000">
- *   <normal text_color="black" dragger_color="#E00000"/>
+ *   <normal text_color="black" dragger_color="#E00000" tick_color="gray"/>
  *   <pressed text_color="black" dragger_color="#FF0000"/>
  * </style>
  * ```
@@ -148,7 +218,90 @@ typedef struct _slider_circle_t {
    */
   char* format;
 
+  /**
+   * @property {bool_t} show_ticks
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 是否显示刻度和刻度标签(缺省为FALSE)。
+   */
+  bool_t show_ticks;
+
+  /**
+   * @property {uint8_t} major_ticks
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 每隔多少个步长显示一个主刻度(主刻度带标签，0表示没有主刻度)。
+   */
+  uint8_t major_ticks;
+
+  /**
+   * @property {uint8_t} tick_min_gap
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 相邻刻度的最小间距(像素)，间距小于它时自动抽稀。
+   */
+  uint8_t tick_min_gap;
+
+  /**
+   * @property {bool_t} track_dither
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 在单色屏上是否用有序抖动表示轨道颜色的灰度(缺省为FALSE，按亮度转换成黑或白)。
+   */
+  bool_t track_dither;
+
+  /**
+   * @property {char*} zones
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 轨道上的彩色区间(如告警区间)，格式为"起始值,结束值,颜色;..."，如"80,90,#ffbf00;90,100,red"。
+   */
+  char* zones;
+
+  /**
+   * @property {char*} mapping
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 值和圆弧上的位置之间的映射(缺省为线性)，如"log"、"curve:0,0;50,80;100,100"或者
+   * "list:1,2,5,10,20,50,100"(参考slider_circle_mapping_parse)。
+   * 离散值列表代替step的取整，值只能是列表中的值。
+   */
+  char* mapping;
+
+  /**
+   * @property {bool_t} peak_hold
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 是否在轨道上用标记显示通过slider_circle_ingest输入的采样的最大值和最小值。
+   */
+  bool_t peak_hold;
+
+  /**
+   * @property {float_t} peak_decay
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 峰值标记每秒向当前值回落的量(缺省为0，一直保持)。
+   */
+  float_t peak_decay;
+
+  /**
+   * @property {slider_circle_backend_t} render_backend
+   * @annotation ["set_prop","get_prop","readable","persitent","design","scriptable"]
+   * 指定的绘制方式："auto"(缺省)、"vgcanvas"、"direct"或者"sprite"(参考slider_circle_backend_t)。
+   * 实际使用的方式可以通过只读属性active_backend获取。
+   */
+  slider_circle_backend_t render_backend;
+
   /*private*/
+  slider_circle_backend_t backend;
+  lcd_t* backend_lcd;
+  slider_circle_raster_cap_t cap;
+  slider_circle_paint_func_t paint_self;
+  slider_circle_ingest_t* ingest;
+  bool_t ingest_pending;
+  uint32_t peak_idle;
+  struct _slider_circle_source_t* source;
+  uint32_t source_generation;
+  slider_circle_zones_t* zone_list;
+  slider_circle_mapping_t* value_map;
+  slider_circle_style_t cached_style;
+  slider_circle_render_key_t render_key;
+  bool_t render_key_valid;
+  slider_circle_ticks_t ticks;
+  slider_circle_layer_t* track_layer;
+  /*以下字段只用于拖动(gauge_circle不使用)*/
   double save_value;
   double prev_value;
   bool_t dragging;
@@ -332,6 +485,204 @@ ret_t slider_circle_set_show_text(widget_t* widget, bool_t show_text);
  */
 ret_t slider_circle_set_format(widget_t* widget, const char* format);
 
+/**
+ * @method slider_circle_set_show_ticks
+ * 设置 是否显示刻度和刻度标签。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {bool_t} show_ticks 是否显示刻度和刻度标签。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_set_show_ticks(widget_t* widget, bool_t show_ticks);
+
+/**
+ * @method slider_circle_set_major_ticks
+ * 设置 每隔多少个步长显示一个主刻度。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {uint8_t} major_ticks 每隔多少个步长显示一个主刻度。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_set_major_ticks(widget_t* widget, uint8_t major_ticks);
+
+/**
+ * @method slider_circle_set_tick_min_gap
+ * 设置 相邻刻度的最小间距。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {uint8_t} tick_min_gap 相邻刻度的最小间距(像素)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_set_tick_min_gap(widget_t* widget, uint8_t tick_min_gap);
+
+/**
+ * @method slider_circle_set_track_dither
+ * 设置 在单色屏上是否用有序抖动表示轨道颜色的灰度。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {bool_t} track_dither 是否用有序抖动表示轨道颜色的灰度。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_set_track_dither(widget_t* widget, bool_t track_dither);
+
+/**
+ * @method slider_circle_set_zones
+ * 设置 轨道上的彩色区间。
+ *
+ * 区间与轨道的半径和线宽相同，两端为平头，设置时解析一次，和轨道一起绘制(在缓存层中)。
+ * 颜色相同并且相连的区间合并，颜色相同的区间用一条路径描边。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {const char*} zones 区间，格式为"起始值,结束值,颜色;..."(为NULL或者空字符串时清除)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_set_zones(widget_t* widget, const char* zones);
+
+/**
+ * @method slider_circle_set_mapping
+ * 设置 值和圆弧上的位置之间的映射。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {const char*} mapping 映射，如"log"或者"list:1,2,5,10"(为NULL或者"linear"时为线性)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_set_mapping(widget_t* widget, const char* mapping);
+
+/**
+ * @method slider_circle_value_to_angle
+ * 把值转换成角度(弧度，考虑映射和方向)。
+ * @param {widget_t*} widget widget对象。
+ * @param {double} value 值。
+ *
+ * @return {float_t} 返回角度(弧度)。
+ */
+float_t slider_circle_value_to_angle(widget_t* widget, double value);
+
+/**
+ * @method slider_circle_set_render_backend
+ * 设置 绘制方式(不可用时自动退回到其它方式)。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {const char*} render_backend "auto"、"vgcanvas"、"direct"或者"sprite"。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_set_render_backend(widget_t* widget, const char* render_backend);
+
+/**
+ * @method slider_circle_update_paint
+ * 解析线帽，并按当前的配置重新选择绘制前景的函数。
+ * > 调用slider_circle_set_xxx时自动调用，直接修改counter_clock_wise、header_size、
+ * > show_text或者line_cap字段之后需要调用。
+ * @param {widget_t*} widget widget对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_update_paint(widget_t* widget);
+
+/**
+ * @method slider_circle_update_mapping
+ * 按mapping、min和max重新生成值的映射表，并把当前的值规整到min/max和step(不分发值变化事件)。
+ * > 直接修改min、max、step或者mapping字段之后需要调用。
+ * @param {widget_t*} widget widget对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_update_mapping(widget_t* widget);
+
+/**
+ * @method slider_circle_update_text
+ * 按当前的值和format更新widget的text(show_text为FALSE时不更新)。
+ * > 值、format或者show_text变化时自动调用，绘制时不再修改text。直接修改value字段之后需要调用。
+ * @param {widget_t*} widget widget对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_update_text(widget_t* widget);
+
+/**
+ * @method slider_circle_set_specialized_paint
+ * 设置是否使用特化的绘制函数。
+ *
+ * 缺省使用，关闭后全部使用通用的绘制函数(每次绘制时判断各个配置)，用于比较两者的速度。
+ * @param {bool_t} enabled 是否使用。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_set_specialized_paint(bool_t enabled);
+
+/**
+ * @method slider_circle_set_peak_hold
+ * 设置 是否显示峰值标记。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {bool_t} peak_hold 是否显示峰值标记。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_set_peak_hold(widget_t* widget, bool_t peak_hold);
+
+/**
+ * @method slider_circle_set_peak_decay
+ * 设置 峰值标记每秒向当前值回落的量。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ * @param {float_t} peak_decay 每秒回落的量(为0时一直保持)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_set_peak_decay(widget_t* widget, float_t peak_decay);
+
+/**
+ * @method slider_circle_ingest
+ * 输入一批高频的采样。
+ *
+ * 每个采样只更新统计值(O(1)，不分配内存)，每帧最多刷新一次，绘制时显示最后一个采样的值，
+ * 最大值和最小值并入峰值标记。不分发值变化的事件。
+ * @param {widget_t*} widget widget对象。
+ * @param {const double*} samples 采样。
+ * @param {uint32_t} nr 采样数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_ingest(widget_t* widget, const double* samples, uint32_t nr);
+
+/**
+ * @method slider_circle_reset_peaks
+ * 清除峰值标记。
+ * @annotation ["scriptable"]
+ * @param {widget_t*} widget widget对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_reset_peaks(widget_t* widget);
+
+/**
+ * @method slider_circle_sync_source
+ * 绑定了共享的值(参考slider_circle_source_t)并且共享的值有更新时，取共享的值。
+ * > 绘制和读取value属性时自动调用。
+ * @param {widget_t*} widget widget对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_sync_source(widget_t* widget);
+
+/**
+ * @method slider_circle_warmup_widget
+ * 安排在工作线程中生成轨道的缓存层，并预先生成拖动点的共享位图(参考slider_circle_warmup)。
+ * > 文本和刻度标签需要字体管理器，不能在工作线程中生成，仍然直接绘制。
+ * @param {widget_t*} widget widget对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_warmup_widget(widget_t* widget);
+
 #define SLIDER_CIRCLE_PROP_VALUE "value"
 #define SLIDER_CIRCLE_PROP_MIN "min"
 #define SLIDER_CIRCLE_PROP_MAX "max"
@@ -346,18 +697,62 @@ ret_t slider_circle_set_format(widget_t* widget, const char* format);
 #define SLIDER_CIRCLE_PROP_COUNTER_CLOCK_WISE "counter_clock_wise"
 #define SLIDER_CIRCLE_PROP_SHOW_TEXT "show_text"
 #define SLIDER_CIRCLE_PROP_FORMAT "format"
+#define SLIDER_CIRCLE_PROP_SHOW_TICKS "show_ticks"
+#define SLIDER_CIRCLE_PROP_MAJOR_TICKS "major_ticks"
+#define SLIDER_CIRCLE_PROP_TICK_MIN_GAP "tick_min_gap"
+#define SLIDER_CIRCLE_PROP_TRACK_DITHER "track_dither"
+#define SLIDER_CIRCLE_PROP_ZONES "zones"
+#define SLIDER_CIRCLE_PROP_MAPPING "mapping"
+#define SLIDER_CIRCLE_PROP_PEAK_HOLD "peak_hold"
+#define SLIDER_CIRCLE_PROP_PEAK_DECAY "peak_decay"
+#define SLIDER_CIRCLE_PROP_RENDER_BACKEND "render_backend"
+/*只读，实际使用的绘制方式*/
+#define SLIDER_CIRCLE_PROP_ACTIVE_BACKEND "active_backend"
+
+/**
+ * @const SLIDER_CIRCLE_STYLE_ID_TICK_COLOR
+ * 刻度颜色的style名称(未设置时使用text_color)。
+ */
+#define SLIDER_CIRCLE_STYLE_ID_TICK_COLOR "tick_color"
+
+/**
+ * @const SLIDER_CIRCLE_STYLE_ID_PEAK_COLOR
+ * 峰值标记颜色的style名称(未设置时使用dragger_color)。
+ */
+#define SLIDER_CIRCLE_STYLE_ID_PEAK_COLOR "peak_color"
 
 #define WIDGET_TYPE_SLIDER_CIRCLE "slider_circle"
 
 #define SLIDER_CIRCLE(widget) ((slider_circle_t*)(slider_circle_cast(WIDGET(widget))))
 
+/*
+ * 裁剪选项(定义后对应的功能不编译进库，用于flash很小的平台)：
+ * SLIDER_CIRCLE_WITHOUT_TEXT   不显示文本(show_text/format无效，刻度没有标签)。
+ * SLIDER_CIRCLE_WITHOUT_CCW    只支持顺时针方向(counter_clock_wise无效)。
+ * SLIDER_CIRCLE_WITHOUT_INPUT  只用于显示，不处理指针事件。
+ * SLIDER_CIRCLE_WITHOUT_PROPS  不支持通过属性名读写属性(不能在XML中设置属性，只能调用函数设置)。
+ * SLIDER_CIRCLE_WITHOUT_TICKS  不支持刻度和刻度标签。
+ * SLIDER_CIRCLE_WITHOUT_WARMUP 不支持在工作线程中预先生成缓存层(没有线程的平台)。
+ * SLIDER_CIRCLE_WITHOUT_DIRECT 不直接在framebuffer上绘制圆弧(全部通过vgcanvas绘制，track_dither无效)。
+ * SLIDER_CIRCLE_WITHOUT_SPECIALIZE 不生成特化的绘制函数(只用通用的绘制函数)。
+ */
+#ifdef SLIDER_CIRCLE_WITHOUT_CCW
+#define SLIDER_CIRCLE_IS_CCW(slider_circle) FALSE
+#else
+#define SLIDER_CIRCLE_IS_CCW(slider_circle) ((slider_circle)->counter_clock_wise)
+#endif /*SLIDER_CIRCLE_WITHOUT_CCW*/
+
+/*gauge_circle不可输入，不会进入拖动状态*/
+#define SLIDER_CIRCLE_IS_DRAGGING(widget, slider_circle) \
+  ((widget)->vt->inputable && (slider_circle)->dragging)
+
 /*public for subclass and runtime type check*/
 TK_EXTERN_VTABLE(slider_circle);
 
 /*public for test*/
 /**
  * @method slider_circle_is_point_in_dragger
- * 判断点是否在拖动区域内。
+ * 判断点是否在拖动区域内(不可输入的控件如gauge_circle总是返回FALSE)。
  * @param {widget_t*} widget widget对象。
  * @param {xy_t} x x坐标。
  * @param {xy_t} y y坐标。
@@ -379,7 +774,7 @@ double slider_circle_point_to_angle(widget_t* widget, xy_t x, xy_t y);
 
 /**
  * @method slider_circle_angle_to_value
- * 将角度转换为值。
+ * 将角度转换为值(不可输入的控件如gauge_circle返回0)。
  * @param {widget_t*} widget widget对象。
  * @param {double} angle 角度。
  * 
@@ -389,7 +784,7 @@ double slider_circle_angle_to_value(widget_t* widget, double angle);
 
 /**
  * @method slider_circle_point_to_value
- * 将点转换为值。
+ * 将点转换为值(不可输入的控件如gauge_circle返回0)。
  * @param {widget_t*} widget widget对象。
  * @param {xy_t} x x坐标。
  * @param {xy_t} y y坐标。
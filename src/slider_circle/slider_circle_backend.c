@@ -0,0 +1,105 @@
+﻿/**
+ * File:   slider_circle_backend.c
+ * Author: AWTK Develop Team
+ * Brief:  按画布的能力选择绘制方式。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include <stdlib.h>
+#include "tkc/utils.h"
+#include "slider_circle_mono.h"
+#include "slider_circle_direct.h"
+#include "slider_circle_backend.h"
+
+static const char* s_backend_names[] = {"auto", "vgcanvas", "direct", "sprite"};
+
+slider_circle_backend_t slider_circle_backend_from_str(const char* name) {
+  uint32_t i = 0;
+
+  for (i = 0; i < ARRAY_SIZE(s_backend_names); i++) {
+    if (tk_str_eq(name, s_backend_names[i])) {
+      return (slider_circle_backend_t)i;
+    }
+  }
+
+  return SLIDER_CIRCLE_BACKEND_AUTO;
+}
+
+const char* slider_circle_backend_to_str(slider_circle_backend_t backend) {
+  return_value_if_fail((uint32_t)backend < ARRAY_SIZE(s_backend_names), s_backend_names[0]);
+
+  return s_backend_names[backend];
+}
+
+static bool_t s_default_inited = FALSE;
+static slider_circle_backend_t s_default = SLIDER_CIRCLE_BACKEND_AUTO;
+
+ret_t slider_circle_backend_set_default(slider_circle_backend_t backend) {
+  return_value_if_fail((uint32_t)backend < ARRAY_SIZE(s_backend_names), RET_BAD_PARAMS);
+
+  s_default = backend;
+  s_default_inited = TRUE;
+
+  return RET_OK;
+}
+
+static slider_circle_backend_t slider_circle_backend_default(void) {
+  /*只在第一次使用时读取环境变量*/
+  if (!s_default_inited) {
+    s_default = slider_circle_backend_from_str(getenv(SLIDER_CIRCLE_BACKEND_ENV));
+    s_default_inited = TRUE;
+  }
+
+  return s_default;
+}
+
+slider_circle_backend_t slider_circle_backend_resolve(slider_circle_backend_t requested,
+                                                      canvas_t* c) {
+  bool_t gpu = FALSE;
+  bool_t direct = FALSE;
+  return_value_if_fail(c != NULL && c->lcd != NULL, SLIDER_CIRCLE_BACKEND_VGCANVAS);
+
+  gpu = c->lcd->type == LCD_VGCANVAS;
+#ifndef SLIDER_CIRCLE_WITHOUT_DIRECT
+  direct = slider_circle_direct_supported(c) || slider_circle_mono_supported(c);
+#endif /*SLIDER_CIRCLE_WITHOUT_DIRECT*/
+
+  if (requested == SLIDER_CIRCLE_BACKEND_AUTO) {
+    requested = slider_circle_backend_default();
+  }
+
+  switch (requested) {
+    case SLIDER_CIRCLE_BACKEND_VGCANVAS: {
+      return SLIDER_CIRCLE_BACKEND_VGCANVAS;
+    }
+    case SLIDER_CIRCLE_BACKEND_SPRITE: {
+      return gpu ? SLIDER_CIRCLE_BACKEND_VGCANVAS : SLIDER_CIRCLE_BACKEND_SPRITE;
+    }
+    case SLIDER_CIRCLE_BACKEND_DIRECT: {
+      return direct ? SLIDER_CIRCLE_BACKEND_DIRECT : SLIDER_CIRCLE_BACKEND_VGCANVAS;
+    }
+    default: {
+      /*能直接写framebuffer时原地光栅化比贴整个控件大小的位图快*/
+      if (gpu) {
+        return SLIDER_CIRCLE_BACKEND_VGCANVAS;
+      } else if (direct) {
+        return SLIDER_CIRCLE_BACKEND_DIRECT;
+      }
+      return SLIDER_CIRCLE_BACKEND_SPRITE;
+    }
+  }
+}
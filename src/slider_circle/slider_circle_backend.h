@@ -0,0 +1,105 @@
+﻿/**
+ * File:   slider_circle_backend.h
+ * Author: AWTK Develop Team
+ * Brief:  按画布的能力选择绘制方式。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SLIDER_CIRCLE_BACKEND_H
+#define TK_SLIDER_CIRCLE_BACKEND_H
+
+#include "base/canvas.h"
+
+BEGIN_C_DECLS
+
+/*指定缺省绘制方式的环境变量(取值与render_backend属性相同，用于测试)*/
+#define SLIDER_CIRCLE_BACKEND_ENV "SLIDER_CIRCLE_BACKEND"
+
+/**
+ * @enum slider_circle_backend_t
+ * @prefix SLIDER_CIRCLE_BACKEND_
+ * 绘制方式。
+ */
+typedef enum _slider_circle_backend_t {
+  /**
+   * @const SLIDER_CIRCLE_BACKEND_AUTO
+   * 按画布的能力自动选择("auto")。
+   */
+  SLIDER_CIRCLE_BACKEND_AUTO = 0,
+  /**
+   * @const SLIDER_CIRCLE_BACKEND_VGCANVAS
+   * 全部通过vgcanvas绘制("vgcanvas"，OpenGL等有GPU的平台最快)。
+   */
+  SLIDER_CIRCLE_BACKEND_VGCANVAS,
+  /**
+   * @const SLIDER_CIRCLE_BACKEND_DIRECT
+   * 纯色的圆弧直接光栅化到framebuffer上("direct"，BGR565/BGRA8888/MONO)。
+   */
+  SLIDER_CIRCLE_BACKEND_DIRECT,
+  /**
+   * @const SLIDER_CIRCLE_BACKEND_SPRITE
+   * 贴预先生成的位图("sprite"，软件渲染)：拖动点使用共享的位图，
+   * 调用过slider_circle_warmup的控件的轨道使用工作线程生成的位图。
+   */
+  SLIDER_CIRCLE_BACKEND_SPRITE
+} slider_circle_backend_t;
+
+/**
+ * @method slider_circle_backend_from_str
+ * 把名称转换成绘制方式(不认识的名称返回SLIDER_CIRCLE_BACKEND_AUTO)。
+ * @param {const char*} name 名称。
+ *
+ * @return {slider_circle_backend_t} 返回绘制方式。
+ */
+slider_circle_backend_t slider_circle_backend_from_str(const char* name);
+
+/**
+ * @method slider_circle_backend_to_str
+ * 获取绘制方式的名称。
+ * @param {slider_circle_backend_t} backend 绘制方式。
+ *
+ * @return {const char*} 返回名称。
+ */
+const char* slider_circle_backend_to_str(slider_circle_backend_t backend);
+
+/**
+ * @method slider_circle_backend_set_default
+ * 设置render_backend为auto时使用的绘制方式(覆盖环境变量SLIDER_CIRCLE_BACKEND，用于测试)。
+ * @param {slider_circle_backend_t} backend 绘制方式(auto表示按画布的能力选择)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_backend_set_default(slider_circle_backend_t backend);
+
+/**
+ * @method slider_circle_backend_resolve
+ * 按画布的能力确定实际的绘制方式。
+ *
+ * 指定的方式不可用时退回到vgcanvas；为auto时使用slider_circle_backend_set_default设置的方式或者环境变量SLIDER_CIRCLE_BACKEND，
+ * 仍然为auto时：vgcanvas类型的画布(OpenGL)使用vgcanvas，支持直接绘制的framebuffer使用direct，
+ * 其它使用sprite。
+ * @param {slider_circle_backend_t} requested 指定的绘制方式。
+ * @param {canvas_t*} c 画布。
+ *
+ * @return {slider_circle_backend_t} 返回实际的绘制方式(不会是auto)。
+ */
+slider_circle_backend_t slider_circle_backend_resolve(slider_circle_backend_t requested,
+                                                      canvas_t* c);
+
+END_C_DECLS
+
+#endif /*TK_SLIDER_CIRCLE_BACKEND_H*/
@@ -0,0 +1,375 @@
+﻿/**
+ * File:   slider_circle_direct.c
+ * Author: AWTK Develop Team
+ * Brief:  直接在BGR565/BGRA8888的framebuffer上绘制圆弧和圆(不经过vgcanvas)。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/utils.h"
+#include "lcd/lcd_mem.h"
+#include "base/system_info.h"
+#include "slider_circle_direct.h"
+
+#ifndef SLIDER_CIRCLE_WITHOUT_DIRECT
+
+#ifndef SLIDER_CIRCLE_WITHOUT_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SLIDER_CIRCLE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SLIDER_CIRCLE_NEON 1
+#include <arm_neon.h>
+#endif
+#endif /*SLIDER_CIRCLE_WITHOUT_SIMD*/
+
+#define DIRECT_SPAN_MAX 256
+
+/*t/255四舍五入(t <= 255 * 255)，SIMD的实现用同样的算法，保证结果一致*/
+#define DIV255(t) ((((t) + 128) + (((t) + 128) >> 8)) >> 8)
+
+static bool_t s_direct_enabled = TRUE;
+
+void slider_circle_blend_bgra8888_scalar(uint8_t* dst, const uint8_t* cov, uint32_t n,
+                                         color_t color) {
+  uint32_t i = 0;
+  uint8_t* p = dst;
+
+  for (i = 0; i < n; i++, p += 4) {
+    uint32_t a = DIV255(cov[i] * color.rgba.a);
+    uint32_t ia = 255 - a;
+
+    if (a == 0) {
+      continue;
+    }
+
+    p[0] = DIV255(color.rgba.b * a + p[0] * ia);
+    p[1] = DIV255(color.rgba.g * a + p[1] * ia);
+    p[2] = DIV255(color.rgba.r * a + p[2] * ia);
+    p[3] = DIV255(255 * a + p[3] * ia);
+  }
+}
+
+void slider_circle_blend_bgr565_scalar(uint8_t* dst, const uint8_t* cov, uint32_t n,
+                                       color_t color) {
+  uint32_t i = 0;
+  uint16_t* p = (uint16_t*)dst;
+  uint32_t sr = color.rgba.r >> 3;
+  uint32_t sg = color.rgba.g >> 2;
+  uint32_t sb = color.rgba.b >> 3;
+
+  for (i = 0; i < n; i++) {
+    uint32_t a = DIV255(cov[i] * color.rgba.a);
+    uint32_t ia = 255 - a;
+    uint32_t v = p[i];
+    uint32_t r = 0;
+    uint32_t g = 0;
+    uint32_t b = 0;
+
+    if (a == 0) {
+      continue;
+    }
+
+    r = DIV255(sr * a + (v >> 11) * ia);
+    g = DIV255(sg * a + ((v >> 5) & 0x3f) * ia);
+    b = DIV255(sb * a + (v & 0x1f) * ia);
+    p[i] = (uint16_t)((r << 11) | (g << 5) | b);
+  }
+}
+
+#if defined(SLIDER_CIRCLE_SSE2)
+static inline __m128i blend_div255_sse2(__m128i t) {
+  t = _mm_add_epi16(t, _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+}
+
+void slider_circle_blend_bgra8888(uint8_t* dst, const uint8_t* cov, uint32_t n, color_t color) {
+  uint32_t i = 0;
+  __m128i zero = _mm_setzero_si128();
+  __m128i ff = _mm_set1_epi16(255);
+  __m128i ca = _mm_set1_epi16(color.rgba.a);
+  __m128i src = _mm_set_epi16(255, color.rgba.r, color.rgba.g, color.rgba.b, 255, color.rgba.r,
+                              color.rgba.g, color.rgba.b);
+
+  for (i = 0; i + 4 <= n; i += 4) {
+    uint32_t c4 = 0;
+    __m128i a, a2, alo, ahi, d, dlo, dhi;
+
+    memcpy(&c4, cov + i, sizeof(c4));
+    if (c4 == 0) {
+      continue;
+    }
+
+    /*4个像素的alpha，每个扩展到4个通道*/
+    a = blend_div255_sse2(_mm_mullo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(c4), zero), ca));
+    a2 = _mm_unpacklo_epi16(a, a);
+    alo = _mm_unpacklo_epi32(a2, a2);
+    ahi = _mm_unpackhi_epi32(a2, a2);
+
+    d = _mm_loadu_si128((const __m128i*)(dst + i * 4));
+    dlo = _mm_unpacklo_epi8(d, zero);
+    dhi = _mm_unpackhi_epi8(d, zero);
+    dlo = blend_div255_sse2(_mm_add_epi16(_mm_mullo_epi16(src, alo),
+                                          _mm_mullo_epi16(dlo, _mm_sub_epi16(ff, alo))));
+    dhi = blend_div255_sse2(_mm_add_epi16(_mm_mullo_epi16(src, ahi),
+                                          _mm_mullo_epi16(dhi, _mm_sub_epi16(ff, ahi))));
+    _mm_storeu_si128((__m128i*)(dst + i * 4), _mm_packus_epi16(dlo, dhi));
+  }
+
+  slider_circle_blend_bgra8888_scalar(dst + i * 4, cov + i, n - i, color);
+}
+
+void slider_circle_blend_bgr565(uint8_t* dst, const uint8_t* cov, uint32_t n, color_t color) {
+  uint32_t i = 0;
+  __m128i zero = _mm_setzero_si128();
+  __m128i ff = _mm_set1_epi16(255);
+  __m128i m5 = _mm_set1_epi16(0x1f);
+  __m128i m6 = _mm_set1_epi16(0x3f);
+  __m128i ca = _mm_set1_epi16(color.rgba.a);
+  __m128i sr = _mm_set1_epi16(color.rgba.r >> 3);
+  __m128i sg = _mm_set1_epi16(color.rgba.g >> 2);
+  __m128i sb = _mm_set1_epi16(color.rgba.b >> 3);
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    __m128i c8, a, ia, d, r, g, b;
+
+    c8 = _mm_loadl_epi64((const __m128i*)(cov + i));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(c8, zero)) == 0xffff) {
+      continue;
+    }
+
+    a = blend_div255_sse2(_mm_mullo_epi16(_mm_unpacklo_epi8(c8, zero), ca));
+    ia = _mm_sub_epi16(ff, a);
+    d = _mm_loadu_si128((const __m128i*)(dst + i * 2));
+    r = _mm_srli_epi16(d, 11);
+    g = _mm_and_si128(_mm_srli_epi16(d, 5), m6);
+    b = _mm_and_si128(d, m5);
+
+    r = blend_div255_sse2(_mm_add_epi16(_mm_mullo_epi16(sr, a), _mm_mullo_epi16(r, ia)));
+    g = blend_div255_sse2(_mm_add_epi16(_mm_mullo_epi16(sg, a), _mm_mullo_epi16(g, ia)));
+    b = blend_div255_sse2(_mm_add_epi16(_mm_mullo_epi16(sb, a), _mm_mullo_epi16(b, ia)));
+    d = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+    _mm_storeu_si128((__m128i*)(dst + i * 2), d);
+  }
+
+  slider_circle_blend_bgr565_scalar(dst + i * 2, cov + i, n - i, color);
+}
+
+const char* slider_circle_blend_simd_name(void) {
+  return "sse2";
+}
+#elif defined(SLIDER_CIRCLE_NEON)
+static inline uint16x8_t blend_div255_neon(uint16x8_t t) {
+  t = vaddq_u16(t, vdupq_n_u16(128));
+  return vshrq_n_u16(vaddq_u16(t, vshrq_n_u16(t, 8)), 8);
+}
+
+static inline uint8x8_t blend_channel_neon(uint8x8_t s, uint8x8_t d, uint8x8_t a, uint8x8_t ia) {
+  return vmovn_u16(blend_div255_neon(vmlal_u8(vmull_u8(s, a), d, ia)));
+}
+
+void slider_circle_blend_bgra8888(uint8_t* dst, const uint8_t* cov, uint32_t n, color_t color) {
+  uint32_t i = 0;
+  uint8x8_t ff = vdup_n_u8(255);
+  uint8x8_t ca = vdup_n_u8(color.rgba.a);
+  uint8x8_t sr = vdup_n_u8(color.rgba.r);
+  uint8x8_t sg = vdup_n_u8(color.rgba.g);
+  uint8x8_t sb = vdup_n_u8(color.rgba.b);
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    uint8x8x4_t d;
+    uint8x8_t a, ia;
+    uint8x8_t c8 = vld1_u8(cov + i);
+
+    if (vget_lane_u64(vreinterpret_u64_u8(c8), 0) == 0) {
+      continue;
+    }
+
+    a = vmovn_u16(blend_div255_neon(vmull_u8(c8, ca)));
+    ia = vsub_u8(ff, a);
+    d = vld4_u8(dst + i * 4);
+    d.val[0] = blend_channel_neon(sb, d.val[0], a, ia);
+    d.val[1] = blend_channel_neon(sg, d.val[1], a, ia);
+    d.val[2] = blend_channel_neon(sr, d.val[2], a, ia);
+    d.val[3] = blend_channel_neon(ff, d.val[3], a, ia);
+    vst4_u8(dst + i * 4, d);
+  }
+
+  slider_circle_blend_bgra8888_scalar(dst + i * 4, cov + i, n - i, color);
+}
+
+void slider_circle_blend_bgr565(uint8_t* dst, const uint8_t* cov, uint32_t n, color_t color) {
+  uint32_t i = 0;
+  uint16x8_t ff = vdupq_n_u16(255);
+  uint16x8_t m5 = vdupq_n_u16(0x1f);
+  uint16x8_t m6 = vdupq_n_u16(0x3f);
+  uint8x8_t ca = vdup_n_u8(color.rgba.a);
+  uint16x8_t sr = vdupq_n_u16(color.rgba.r >> 3);
+  uint16x8_t sg = vdupq_n_u16(color.rgba.g >> 2);
+  uint16x8_t sb = vdupq_n_u16(color.rgba.b >> 3);
+
+  for (i = 0; i + 8 <= n; i += 8) {
+    uint16x8_t a, ia, d, r, g, b;
+    uint8x8_t c8 = vld1_u8(cov + i);
+
+    if (vget_lane_u64(vreinterpret_u64_u8(c8), 0) == 0) {
+      continue;
+    }
+
+    a = blend_div255_neon(vmull_u8(c8, ca));
+    ia = vsubq_u16(ff, a);
+    d = vld1q_u16((const uint16_t*)(dst + i * 2));
+    r = vshrq_n_u16(d, 11);
+    g = vandq_u16(vshrq_n_u16(d, 5), m6);
+    b = vandq_u16(d, m5);
+
+    r = blend_div255_neon(vmlaq_u16(vmulq_u16(sr, a), r, ia));
+    g = blend_div255_neon(vmlaq_u16(vmulq_u16(sg, a), g, ia));
+    b = blend_div255_neon(vmlaq_u16(vmulq_u16(sb, a), b, ia));
+    d = vorrq_u16(vorrq_u16(vshlq_n_u16(r, 11), vshlq_n_u16(g, 5)), b);
+    vst1q_u16((uint16_t*)(dst + i * 2), d);
+  }
+
+  slider_circle_blend_bgr565_scalar(dst + i * 2, cov + i, n - i, color);
+}
+
+const char* slider_circle_blend_simd_name(void) {
+  return "neon";
+}
+#else
+void slider_circle_blend_bgra8888(uint8_t* dst, const uint8_t* cov, uint32_t n, color_t color) {
+  slider_circle_blend_bgra8888_scalar(dst, cov, n, color);
+}
+
+void slider_circle_blend_bgr565(uint8_t* dst, const uint8_t* cov, uint32_t n, color_t color) {
+  slider_circle_blend_bgr565_scalar(dst, cov, n, color);
+}
+
+const char* slider_circle_blend_simd_name(void) {
+  return "none";
+}
+#endif /*SLIDER_CIRCLE_SSE2*/
+
+ret_t slider_circle_direct_draw_fb(uint8_t* fb, bitmap_format_t format, uint32_t line_length,
+                                   const rect_t* clip, const slider_circle_raster_arc_t* arc,
+                                   color_t color) {
+  rect_t r;
+  int32_t y = 0;
+  int32_t y1 = 0;
+  uint32_t bpp = 0;
+  uint8_t cov[DIRECT_SPAN_MAX];
+  slider_circle_raster_prepared_t prepared;
+  void (*blend)(uint8_t* dst, const uint8_t* cov, uint32_t n, color_t color) = NULL;
+  return_value_if_fail(fb != NULL && clip != NULL && arc != NULL, RET_BAD_PARAMS);
+
+  if (format == BITMAP_FMT_BGRA8888) {
+    bpp = 4;
+    blend = slider_circle_blend_bgra8888;
+  } else if (format == BITMAP_FMT_BGR565) {
+    bpp = 2;
+    blend = slider_circle_blend_bgr565;
+  }
+  return_value_if_fail(blend != NULL, RET_NOT_IMPL);
+
+  if (color.rgba.a == 0) {
+    return RET_OK;
+  }
+
+  slider_circle_raster_prepare(&prepared, arc);
+  slider_circle_raster_bounds(arc, &r);
+  y1 = tk_min(r.y + r.h, clip->y + clip->h);
+
+  for (y = tk_max(r.y, clip->y); y < y1; y++) {
+    int32_t k = 0;
+    int32_t xs[4];
+    int32_t spans = slider_circle_raster_row(arc, y, xs);
+
+    for (k = 0; k < spans; k++) {
+      int32_t x = tk_max(xs[2 * k], clip->x);
+      int32_t x1 = tk_min(xs[2 * k + 1], clip->x + clip->w);
+
+      for (; x < x1; x += DIRECT_SPAN_MAX) {
+        uint32_t n = tk_min(x1 - x, DIRECT_SPAN_MAX);
+
+        if (slider_circle_raster_span_prepared(&prepared, x, y, n, cov) > 0) {
+          blend(fb + y * line_length + x * bpp, cov, n, color);
+        }
+      }
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_direct_set_enabled(bool_t enabled) {
+  s_direct_enabled = enabled;
+
+  return RET_OK;
+}
+
+bool_t slider_circle_direct_is_enabled(void) {
+  return s_direct_enabled;
+}
+
+bool_t slider_circle_direct_supported(canvas_t* c) {
+  lcd_mem_t* mem = NULL;
+
+  if (!s_direct_enabled || c == NULL || c->lcd == NULL || c->lcd->type != LCD_FRAMEBUFFER) {
+    return FALSE;
+  }
+
+  /*旋转后framebuffer的坐标和画布的坐标不一致*/
+  if (system_info()->lcd_orientation != LCD_ORIENTATION_0) {
+    return FALSE;
+  }
+
+  mem = (lcd_mem_t*)(c->lcd);
+  if (mem->offline_fb == NULL) {
+    return FALSE;
+  }
+
+  return mem->format == BITMAP_FMT_BGR565 || mem->format == BITMAP_FMT_BGRA8888;
+}
+
+ret_t slider_circle_direct_draw(canvas_t* c, const slider_circle_raster_arc_t* arc,
+                                color_t color) {
+  rect_t clip;
+  rect_t screen;
+  lcd_mem_t* mem = NULL;
+  slider_circle_raster_arc_t a;
+  return_value_if_fail(slider_circle_direct_supported(c) && arc != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(arc->start_angle <= arc->end_angle, RET_BAD_PARAMS);
+
+  mem = (lcd_mem_t*)(c->lcd);
+  screen = rect_init(0, 0, c->lcd->w, c->lcd->h);
+  canvas_get_clip_rect(c, &clip);
+  clip = rect_intersect(&clip, &screen);
+  if (clip.w <= 0 || clip.h <= 0) {
+    return RET_OK;
+  }
+
+  a = *arc;
+  a.cx += c->ox;
+  a.cy += c->oy;
+  if (c->lcd->global_alpha < 0xff) {
+    color.rgba.a = (color.rgba.a * c->lcd->global_alpha + 127) / 255;
+  }
+
+  return slider_circle_direct_draw_fb(mem->offline_fb, mem->format, mem->line_length, &clip, &a,
+                                      color);
+}
+
+#endif /*SLIDER_CIRCLE_WITHOUT_DIRECT*/
@@ -0,0 +1,149 @@
+﻿/**
+ * File:   slider_circle_direct.h
+ * Author: AWTK Develop Team
+ * Brief:  直接在BGR565/BGRA8888的framebuffer上绘制圆弧和圆(不经过vgcanvas)。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SLIDER_CIRCLE_DIRECT_H
+#define TK_SLIDER_CIRCLE_DIRECT_H
+
+#include "base/canvas.h"
+#include "base/bitmap.h"
+#include "slider_circle_raster.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @method slider_circle_direct_set_enabled
+ * 设置是否允许直接在framebuffer上绘制(包括单色屏)。
+ *
+ * 缺省允许，关闭后全部通过vgcanvas绘制，用于比较两者的效果和速度。
+ * @param {bool_t} enabled 是否允许。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_direct_set_enabled(bool_t enabled);
+
+/**
+ * @method slider_circle_direct_is_enabled
+ * 检查是否允许直接在framebuffer上绘制。
+ *
+ * @return {bool_t} 返回TRUE表示允许。
+ */
+bool_t slider_circle_direct_is_enabled(void);
+
+/**
+ * @method slider_circle_direct_supported
+ * 检查画布是否可以直接绘制。
+ *
+ * 只支持没有旋转的BGR565和BGRA8888格式的内存LCD。
+ * @param {canvas_t*} c 画布对象。
+ *
+ * @return {bool_t} 返回TRUE表示可以直接绘制。
+ */
+bool_t slider_circle_direct_supported(canvas_t* c);
+
+/**
+ * @method slider_circle_direct_draw
+ * 在画布上绘制圆弧(start_angle必须小于等于end_angle)。
+ * @param {canvas_t*} c 画布对象(slider_circle_direct_supported返回TRUE)。
+ * @param {const slider_circle_raster_arc_t*} arc 圆弧(坐标相对于画布当前的原点)。
+ * @param {color_t} color 颜色。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_direct_draw(canvas_t* c, const slider_circle_raster_arc_t* arc,
+                                color_t color);
+
+/**
+ * @method slider_circle_direct_draw_fb
+ * 在framebuffer上绘制圆弧。
+ * @param {uint8_t*} fb framebuffer。
+ * @param {bitmap_format_t} format 格式(BITMAP_FMT_BGR565或BITMAP_FMT_BGRA8888)。
+ * @param {uint32_t} line_length 每行的字节数。
+ * @param {const rect_t*} clip 裁剪矩形(必须在framebuffer之内)。
+ * @param {const slider_circle_raster_arc_t*} arc 圆弧(坐标相对于framebuffer的左上角)。
+ * @param {color_t} color 颜色。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_direct_draw_fb(uint8_t* fb, bitmap_format_t format, uint32_t line_length,
+                                   const rect_t* clip, const slider_circle_raster_arc_t* arc,
+                                   color_t color);
+
+/**
+ * @method slider_circle_blend_bgra8888
+ * 按覆盖率把颜色混合到n个BGRA8888像素上(有SSE2/NEON时使用SIMD)。
+ * @param {uint8_t*} dst 目标像素。
+ * @param {const uint8_t*} cov 覆盖率。
+ * @param {uint32_t} n 像素个数。
+ * @param {color_t} color 颜色。
+ *
+ * @return {void} 无。
+ */
+void slider_circle_blend_bgra8888(uint8_t* dst, const uint8_t* cov, uint32_t n, color_t color);
+
+/**
+ * @method slider_circle_blend_bgra8888_scalar
+ * slider_circle_blend_bgra8888的C语言实现(结果与SIMD的实现完全一致)。
+ * @param {uint8_t*} dst 目标像素。
+ * @param {const uint8_t*} cov 覆盖率。
+ * @param {uint32_t} n 像素个数。
+ * @param {color_t} color 颜色。
+ *
+ * @return {void} 无。
+ */
+void slider_circle_blend_bgra8888_scalar(uint8_t* dst, const uint8_t* cov, uint32_t n,
+                                         color_t color);
+
+/**
+ * @method slider_circle_blend_bgr565
+ * 按覆盖率把颜色混合到n个BGR565像素上(有SSE2/NEON时使用SIMD)。
+ * @param {uint8_t*} dst 目标像素。
+ * @param {const uint8_t*} cov 覆盖率。
+ * @param {uint32_t} n 像素个数。
+ * @param {color_t} color 颜色。
+ *
+ * @return {void} 无。
+ */
+void slider_circle_blend_bgr565(uint8_t* dst, const uint8_t* cov, uint32_t n, color_t color);
+
+/**
+ * @method slider_circle_blend_bgr565_scalar
+ * slider_circle_blend_bgr565的C语言实现(结果与SIMD的实现完全一致)。
+ * @param {uint8_t*} dst 目标像素。
+ * @param {const uint8_t*} cov 覆盖率。
+ * @param {uint32_t} n 像素个数。
+ * @param {color_t} color 颜色。
+ *
+ * @return {void} 无。
+ */
+void slider_circle_blend_bgr565_scalar(uint8_t* dst, const uint8_t* cov, uint32_t n,
+                                       color_t color);
+
+/**
+ * @method slider_circle_blend_simd_name
+ * 获取混合函数使用的SIMD指令集的名称。
+ *
+ * @return {const char*} 返回"sse2"、"neon"或"none"。
+ */
+const char* slider_circle_blend_simd_name(void);
+
+END_C_DECLS
+
+#endif /*TK_SLIDER_CIRCLE_DIRECT_H*/
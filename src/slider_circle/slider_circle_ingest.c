@@ -0,0 +1,100 @@
+﻿/**
+ * File:   slider_circle_ingest.c
+ * Author: AWTK Develop Team
+ * Brief:  高频采样的抽取和峰值保持。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/utils.h"
+#include "slider_circle_ingest.h"
+
+ret_t slider_circle_ingest_reset(slider_circle_ingest_t* ingest) {
+  return_value_if_fail(ingest != NULL, RET_BAD_PARAMS);
+
+  memset(ingest, 0x00, sizeof(*ingest));
+
+  return RET_OK;
+}
+
+ret_t slider_circle_ingest_push(slider_circle_ingest_t* ingest, const double* samples,
+                                uint32_t nr) {
+  uint32_t i = 0;
+  double vmin = 0;
+  double vmax = 0;
+  return_value_if_fail(ingest != NULL && (samples != NULL || nr == 0), RET_BAD_PARAMS);
+
+  if (nr == 0) {
+    return RET_OK;
+  }
+
+  if (ingest->frame_count == 0) {
+    vmin = samples[0];
+    vmax = samples[0];
+  } else {
+    vmin = ingest->frame_min;
+    vmax = ingest->frame_max;
+  }
+
+  for (i = 0; i < nr; i++) {
+    double v = samples[i];
+
+    vmin = v < vmin ? v : vmin;
+    vmax = v > vmax ? v : vmax;
+  }
+
+  ingest->frame_min = vmin;
+  ingest->frame_max = vmax;
+  ingest->last = samples[nr - 1];
+  ingest->frame_count += nr;
+
+  return RET_OK;
+}
+
+ret_t slider_circle_ingest_commit(slider_circle_ingest_t* ingest, double value, double decay,
+                                  uint64_t now) {
+  double fmin = value;
+  double fmax = value;
+  return_value_if_fail(ingest != NULL, RET_BAD_PARAMS);
+
+  if (ingest->frame_count > 0) {
+    fmin = ingest->frame_min;
+    fmax = ingest->frame_max;
+  }
+
+  if (!ingest->has_peaks) {
+    if (ingest->frame_count == 0) {
+      return RET_OK;
+    }
+    ingest->peak_min = fmin;
+    ingest->peak_max = fmax;
+    ingest->has_peaks = TRUE;
+  } else {
+    if (decay > 0 && now > ingest->commit_time) {
+      double d = decay * (now - ingest->commit_time) / 1000.0;
+
+      ingest->peak_max = tk_max(ingest->peak_max - d, value);
+      ingest->peak_min = tk_min(ingest->peak_min + d, value);
+    }
+    ingest->peak_max = tk_max(ingest->peak_max, fmax);
+    ingest->peak_min = tk_min(ingest->peak_min, fmin);
+  }
+
+  ingest->frame_count = 0;
+  ingest->commit_time = now;
+
+  return RET_OK;
+}
@@ -0,0 +1,120 @@
+﻿/**
+ * File:   slider_circle_ingest.h
+ * Author: AWTK Develop Team
+ * Brief:  高频采样的抽取和峰值保持。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SLIDER_CIRCLE_INGEST_H
+#define TK_SLIDER_CIRCLE_INGEST_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class slider_circle_ingest_t
+ * 高频采样的抽取和峰值保持。
+ *
+ * 采样的频率(如1kHz)远高于刷新的频率(30~60Hz)，每个采样只更新本帧的最后值、最小值和最大值(O(1)，不分配内存)，
+ * 绘制时再一次性提交：显示最后的值，本帧的最小值和最大值并入峰值，峰值按decay向当前值回落。
+ */
+typedef struct _slider_circle_ingest_t {
+  /**
+   * @property {double} last
+   * @annotation ["readable"]
+   * 最后一个采样。
+   */
+  double last;
+  /**
+   * @property {double} frame_min
+   * @annotation ["readable"]
+   * 上次提交之后的最小值。
+   */
+  double frame_min;
+  /**
+   * @property {double} frame_max
+   * @annotation ["readable"]
+   * 上次提交之后的最大值。
+   */
+  double frame_max;
+  /**
+   * @property {uint32_t} frame_count
+   * @annotation ["readable"]
+   * 上次提交之后的采样数。
+   */
+  uint32_t frame_count;
+  /**
+   * @property {double} peak_min
+   * @annotation ["readable"]
+   * 保持的最小值。
+   */
+  double peak_min;
+  /**
+   * @property {double} peak_max
+   * @annotation ["readable"]
+   * 保持的最大值。
+   */
+  double peak_max;
+  /**
+   * @property {bool_t} has_peaks
+   * @annotation ["readable"]
+   * 是否已经有峰值(至少提交过一次采样)。
+   */
+  bool_t has_peaks;
+
+  /*private*/
+  uint64_t commit_time;
+} slider_circle_ingest_t;
+
+/**
+ * @method slider_circle_ingest_reset
+ * 清除采样和峰值。
+ * @param {slider_circle_ingest_t*} ingest ingest对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_ingest_reset(slider_circle_ingest_t* ingest);
+
+/**
+ * @method slider_circle_ingest_push
+ * 加入一批采样(只更新本帧的统计值)。
+ * @param {slider_circle_ingest_t*} ingest ingest对象。
+ * @param {const double*} samples 采样。
+ * @param {uint32_t} nr 采样数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_ingest_push(slider_circle_ingest_t* ingest, const double* samples,
+                                uint32_t nr);
+
+/**
+ * @method slider_circle_ingest_commit
+ * 提交本帧的采样：本帧的最小值和最大值并入峰值，峰值按decay向当前值回落。
+ * @param {slider_circle_ingest_t*} ingest ingest对象。
+ * @param {double} value 当前显示的值(本帧没有采样时峰值向它回落)。
+ * @param {double} decay 峰值每秒回落的量(为0时一直保持)。
+ * @param {uint64_t} now 当前时间(毫秒)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_ingest_commit(slider_circle_ingest_t* ingest, double value, double decay,
+                                  uint64_t now);
+
+END_C_DECLS
+
+#endif /*TK_SLIDER_CIRCLE_INGEST_H*/
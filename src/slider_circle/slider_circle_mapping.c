@@ -0,0 +1,279 @@
+﻿/**
+ * File:   slider_circle_mapping.c
+ * Author: AWTK Develop Team
+ * Brief:  值和圆弧上的位置之间的映射(线性、对数、分段线性和离散值列表)。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include <math.h>
+#include "tkc/utils.h"
+#include "slider_circle_mapping.h"
+
+#define MAPPING_PREFIX_CURVE "curve:"
+#define MAPPING_PREFIX_LIST "list:"
+
+/*返回i(0 <= i <= n - 2)，满足a[i] <= x < a[i + 1](超出范围时返回两端的区间)*/
+static uint32_t slider_circle_mapping_search(const double* a, uint32_t n, double x) {
+  uint32_t lo = 0;
+  uint32_t hi = n - 1;
+
+  while (hi - lo > 1) {
+    uint32_t mid = (lo + hi) / 2;
+    if (a[mid] <= x) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+
+  return lo;
+}
+
+static double slider_circle_mapping_lerp(const double* from, const double* to, uint32_t i,
+                                         double x) {
+  double t = (x - from[i]) / (from[i + 1] - from[i]);
+
+  return to[i] + (to[i + 1] - to[i]) * t;
+}
+
+static ret_t slider_circle_mapping_add(slider_circle_mapping_t* mapping, double value,
+                                       double pos) {
+  uint32_t n = mapping->size;
+
+  if (n >= SLIDER_CIRCLE_MAPPING_MAX) {
+    log_warn("slider_circle: too many mapping points, ignore %g\n", value);
+    return RET_FAIL;
+  }
+
+  /*值和位置都必须严格递增*/
+  if (n > 0 && (value <= mapping->values[n - 1] || pos <= mapping->positions[n - 1])) {
+    return RET_FAIL;
+  }
+
+  mapping->values[n] = value;
+  mapping->positions[n] = pos;
+  mapping->size++;
+
+  return RET_OK;
+}
+
+static ret_t slider_circle_mapping_init_linear(slider_circle_mapping_t* mapping, double min,
+                                               double max) {
+  memset(mapping, 0x00, sizeof(*mapping));
+  mapping->type = SLIDER_CIRCLE_MAPPING_LINEAR;
+  mapping->size = 2;
+  mapping->values[0] = min;
+  mapping->values[1] = max;
+  mapping->positions[0] = 0;
+  mapping->positions[1] = 1;
+
+  return RET_OK;
+}
+
+static ret_t slider_circle_mapping_init_log(slider_circle_mapping_t* mapping, double min,
+                                            double max) {
+  uint32_t i = 0;
+  uint32_t n = SLIDER_CIRCLE_MAPPING_MAX;
+
+  if (min <= 0 || max <= min) {
+    log_warn("slider_circle: log mapping needs 0 < min < max\n");
+    return RET_BAD_PARAMS;
+  }
+
+  /*只在解析时调用pow，运行时按折线插值*/
+  mapping->type = SLIDER_CIRCLE_MAPPING_LOG;
+  mapping->size = n;
+  for (i = 0; i < n; i++) {
+    double pos = (double)i / (n - 1);
+    mapping->values[i] = min * pow(max / min, pos);
+    mapping->positions[i] = pos;
+  }
+  mapping->values[0] = min;
+  mapping->values[n - 1] = max;
+
+  return RET_OK;
+}
+
+static ret_t slider_circle_mapping_init_curve(slider_circle_mapping_t* mapping, const char* str) {
+  uint32_t i = 0;
+  double start = 0;
+  double range = 0;
+  const char* p = str;
+
+  mapping->type = SLIDER_CIRCLE_MAPPING_CURVE;
+  while (p != NULL && *p) {
+    const char* comma = strchr(p, ',');
+    const char* end = strchr(p, ';');
+
+    if (comma != NULL && (end == NULL || comma < end)) {
+      slider_circle_mapping_add(mapping, tk_atof(p), tk_atof(comma + 1));
+    }
+    p = end != NULL ? end + 1 : NULL;
+  }
+
+  if (mapping->size < 2) {
+    return RET_BAD_PARAMS;
+  }
+
+  /*位置规范化到[0, 1]*/
+  start = mapping->positions[0];
+  range = mapping->positions[mapping->size - 1] - start;
+  for (i = 0; i < mapping->size; i++) {
+    mapping->positions[i] = (mapping->positions[i] - start) / range;
+  }
+  mapping->positions[mapping->size - 1] = 1;
+
+  return RET_OK;
+}
+
+static ret_t slider_circle_mapping_init_list(slider_circle_mapping_t* mapping, const char* str) {
+  uint32_t i = 0;
+  const char* p = str;
+
+  mapping->type = SLIDER_CIRCLE_MAPPING_LIST;
+  while (p != NULL && *p) {
+    const char* end = strchr(p, ',');
+
+    /*先用序号作为位置，值不递增的忽略*/
+    slider_circle_mapping_add(mapping, tk_atof(p), mapping->size);
+    p = end != NULL ? end + 1 : NULL;
+  }
+
+  if (mapping->size < 2) {
+    return RET_BAD_PARAMS;
+  }
+
+  /*离散值在圆弧上均匀分布*/
+  for (i = 0; i < mapping->size; i++) {
+    mapping->positions[i] = (double)i / (mapping->size - 1);
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_mapping_parse(slider_circle_mapping_t* mapping, const char* str, double min,
+                                  double max) {
+  ret_t ret = RET_OK;
+  return_value_if_fail(mapping != NULL, RET_BAD_PARAMS);
+
+  memset(mapping, 0x00, sizeof(*mapping));
+  if (str == NULL || *str == '\0' || tk_str_eq(str, "linear")) {
+    return slider_circle_mapping_init_linear(mapping, min, max);
+  } else if (tk_str_eq(str, "log")) {
+    ret = slider_circle_mapping_init_log(mapping, min, max);
+  } else if (tk_str_start_with(str, MAPPING_PREFIX_CURVE)) {
+    ret = slider_circle_mapping_init_curve(mapping, str + strlen(MAPPING_PREFIX_CURVE));
+  } else if (tk_str_start_with(str, MAPPING_PREFIX_LIST)) {
+    ret = slider_circle_mapping_init_list(mapping, str + strlen(MAPPING_PREFIX_LIST));
+  } else {
+    ret = RET_NOT_IMPL;
+  }
+
+  if (ret != RET_OK) {
+    log_warn("slider_circle: invalid mapping \"%s\", use linear\n", str);
+    slider_circle_mapping_init_linear(mapping, min, max);
+  }
+
+  return ret;
+}
+
+double slider_circle_mapping_to_pos(const slider_circle_mapping_t* mapping, double value) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+  return_value_if_fail(mapping != NULL, 0);
+
+  n = mapping->size;
+  if (n < 2 || value <= mapping->values[0]) {
+    return 0;
+  } else if (value >= mapping->values[n - 1]) {
+    return 1;
+  }
+
+  i = slider_circle_mapping_search(mapping->values, n, value);
+
+  return slider_circle_mapping_lerp(mapping->values, mapping->positions, i, value);
+}
+
+double slider_circle_mapping_to_angle(const slider_circle_mapping_t* mapping, double value,
+                                      double min, double max, double start_angle,
+                                      double end_angle, bool_t counter_clock_wise) {
+  double pos = 0;
+
+  if (mapping == NULL) {
+    return tk_value_to_angle(value, min, max, start_angle, end_angle, counter_clock_wise);
+  }
+
+  pos = slider_circle_mapping_to_pos(mapping, value);
+  if (counter_clock_wise) {
+    return TK_D2R(end_angle - (end_angle - start_angle) * pos);
+  } else {
+    return TK_D2R(start_angle + (end_angle - start_angle) * pos);
+  }
+}
+
+double slider_circle_mapping_to_value(const slider_circle_mapping_t* mapping, double pos) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+  return_value_if_fail(mapping != NULL, 0);
+
+  n = mapping->size;
+  if (n < 2) {
+    return n > 0 ? mapping->values[0] : 0;
+  }
+
+  pos = tk_clamp(pos, 0, 1);
+  switch (mapping->type) {
+    case SLIDER_CIRCLE_MAPPING_LIST: {
+      /*位置最近的离散值*/
+      return mapping->values[tk_roundi(pos * (n - 1))];
+    }
+    case SLIDER_CIRCLE_MAPPING_LOG: {
+      /*位置是均匀的，直接计算下标*/
+      double f = pos * (n - 1);
+      i = tk_min((uint32_t)f, n - 2);
+      return mapping->values[i] + (mapping->values[i + 1] - mapping->values[i]) * (f - i);
+    }
+    default: {
+      i = slider_circle_mapping_search(mapping->positions, n, pos);
+      return slider_circle_mapping_lerp(mapping->positions, mapping->values, i, pos);
+    }
+  }
+}
+
+double slider_circle_mapping_snap(const slider_circle_mapping_t* mapping, double value) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+  return_value_if_fail(mapping != NULL, value);
+
+  n = mapping->size;
+  if (mapping->type != SLIDER_CIRCLE_MAPPING_LIST || n < 2) {
+    return value;
+  }
+
+  if (value <= mapping->values[0]) {
+    return mapping->values[0];
+  } else if (value >= mapping->values[n - 1]) {
+    return mapping->values[n - 1];
+  }
+
+  i = slider_circle_mapping_search(mapping->values, n, value);
+  if (value - mapping->values[i] <= mapping->values[i + 1] - value) {
+    return mapping->values[i];
+  }
+
+  return mapping->values[i + 1];
+}
@@ -0,0 +1,165 @@
+﻿/**
+ * File:   slider_circle_mapping.h
+ * Author: AWTK Develop Team
+ * Brief:  值和圆弧上的位置之间的映射(线性、对数、分段线性和离散值列表)。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SLIDER_CIRCLE_MAPPING_H
+#define TK_SLIDER_CIRCLE_MAPPING_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+/*节点的最大数量(对数映射用64段折线逼近，3个数量级时误差约0.15%)*/
+#define SLIDER_CIRCLE_MAPPING_MAX 65
+
+/**
+ * @enum slider_circle_mapping_type_t
+ * @prefix SLIDER_CIRCLE_MAPPING_
+ * 映射的类型。
+ */
+typedef enum _slider_circle_mapping_type_t {
+  /**
+   * @const SLIDER_CIRCLE_MAPPING_LINEAR
+   * 线性(缺省)。
+   */
+  SLIDER_CIRCLE_MAPPING_LINEAR = 0,
+  /**
+   * @const SLIDER_CIRCLE_MAPPING_LOG
+   * 对数(min和max必须大于0)。
+   */
+  SLIDER_CIRCLE_MAPPING_LOG,
+  /**
+   * @const SLIDER_CIRCLE_MAPPING_CURVE
+   * 分段线性。
+   */
+  SLIDER_CIRCLE_MAPPING_CURVE,
+  /**
+   * @const SLIDER_CIRCLE_MAPPING_LIST
+   * 离散值列表(值只能是列表中的值，在圆弧上均匀分布)。
+   */
+  SLIDER_CIRCLE_MAPPING_LIST
+} slider_circle_mapping_type_t;
+
+/**
+ * @class slider_circle_mapping_t
+ * 解析后的映射。
+ *
+ * 在解析时生成节点表(值和位置都严格递增，位置的范围为[0, 1])，
+ * 运行时只做查表和线性插值(不调用log/pow等函数)：
+ *
+ * * 值到位置：二分查找，O(log n)。
+ * * 位置到值：对数映射和离散值列表的位置是均匀的，直接计算下标，O(1)；分段线性为二分查找。
+ */
+typedef struct _slider_circle_mapping_t {
+  /**
+   * @property {slider_circle_mapping_type_t} type
+   * 类型。
+   */
+  slider_circle_mapping_type_t type;
+  /**
+   * @property {uint32_t} size
+   * 节点的数量。
+   */
+  uint32_t size;
+  /**
+   * @property {double*} values
+   * 节点的值。
+   */
+  double values[SLIDER_CIRCLE_MAPPING_MAX];
+  /**
+   * @property {double*} positions
+   * 节点在圆弧上的位置(0为起点，1为终点)。
+   */
+  double positions[SLIDER_CIRCLE_MAPPING_MAX];
+} slider_circle_mapping_t;
+
+/**
+ * @method slider_circle_mapping_parse
+ * 解析映射字符串。
+ *
+ * 支持的格式：
+ *
+ * * "linear"或者空字符串：线性。
+ * * "log"：对数，在min和max之间生成节点表。
+ * * "curve:值,位置;值,位置;..."：分段线性，位置为百分比，如"curve:0,0;50,80;100,100"。
+ * * "list:值,值,..."：离散值列表，如"list:1,2,5,10,20,50,100"。
+ *
+ * > 值必须严格递增，不递增的节点忽略。格式不正确时退回到线性。
+ * > curve和list的第一个值和最后一个值应该与控件的min和max一致。
+ * @param {slider_circle_mapping_t*} mapping 返回解析的结果。
+ * @param {const char*} str 映射字符串。
+ * @param {double} min 最小值。
+ * @param {double} max 最大值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_mapping_parse(slider_circle_mapping_t* mapping, const char* str, double min,
+                                  double max);
+
+/**
+ * @method slider_circle_mapping_to_pos
+ * 把值转换成圆弧上的位置。
+ * @param {const slider_circle_mapping_t*} mapping 映射。
+ * @param {double} value 值。
+ *
+ * @return {double} 返回位置(0到1之间)。
+ */
+double slider_circle_mapping_to_pos(const slider_circle_mapping_t* mapping, double value);
+
+/**
+ * @method slider_circle_mapping_to_value
+ * 把圆弧上的位置转换成值(离散值列表返回位置最近的值)。
+ * @param {const slider_circle_mapping_t*} mapping 映射。
+ * @param {double} pos 位置(0到1之间)。
+ *
+ * @return {double} 返回值。
+ */
+double slider_circle_mapping_to_value(const slider_circle_mapping_t* mapping, double pos);
+
+/**
+ * @method slider_circle_mapping_snap
+ * 离散值列表返回最近的值，其它类型直接返回value。
+ * @param {const slider_circle_mapping_t*} mapping 映射。
+ * @param {double} value 值。
+ *
+ * @return {double} 返回值。
+ */
+double slider_circle_mapping_snap(const slider_circle_mapping_t* mapping, double value);
+
+/**
+ * @method slider_circle_mapping_to_angle
+ * 把值转换成圆弧上的角度。
+ * @param {const slider_circle_mapping_t*} mapping 映射(为NULL时为线性)。
+ * @param {double} value 值。
+ * @param {double} min 最小值。
+ * @param {double} max 最大值。
+ * @param {double} start_angle 起始角度(度)。
+ * @param {double} end_angle 结束角度(度)。
+ * @param {bool_t} counter_clock_wise 是否为逆时针方向。
+ *
+ * @return {double} 返回角度(弧度)。
+ */
+double slider_circle_mapping_to_angle(const slider_circle_mapping_t* mapping, double value,
+                                      double min, double max, double start_angle,
+                                      double end_angle, bool_t counter_clock_wise);
+
+END_C_DECLS
+
+#endif /*TK_SLIDER_CIRCLE_MAPPING_H*/
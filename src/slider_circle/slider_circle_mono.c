@@ -0,0 +1,306 @@
+﻿/**
+ * File:   slider_circle_mono.c
+ * Author: AWTK Develop Team
+ * Brief:  直接在单色(1bpp)的framebuffer上绘制圆弧和圆(不经过vgcanvas)。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include <math.h>
+#include "tkc/utils.h"
+#include "lcd/lcd_mono.h"
+#include "base/system_info.h"
+#include "slider_circle_mono.h"
+#include "slider_circle_direct.h"
+
+#ifndef SLIDER_CIRCLE_WITHOUT_DIRECT
+
+#ifndef TK_BITMAP_MONO_LINE_LENGTH
+#define TK_BITMAP_MONO_LINE_LENGTH(w) ((((w) + 15) >> 4) << 1)
+#endif /*TK_BITMAP_MONO_LINE_LENGTH*/
+
+#define MONO_2PI (2 * M_PI)
+#define MONO_INF 1e9f
+
+static const uint8_t s_mono_bayer4[4][4] = {
+    {0, 8, 2, 10},
+    {12, 4, 14, 6},
+    {3, 11, 1, 9},
+    {15, 7, 13, 5},
+};
+
+uint8_t slider_circle_mono_pattern(color_t color, int32_t y, bool_t dither) {
+  uint32_t k = 0;
+  uint8_t pattern = 0;
+  uint32_t gray = (color.rgba.r * 77 + color.rgba.g * 151 + color.rgba.b * 28) >> 8;
+
+  if (!dither) {
+    return gray >= 128 ? 0xff : 0x00;
+  }
+
+  /*阈值矩阵每4个像素重复一次，一个字节的图案对整行都适用*/
+  for (k = 0; k < 8; k++) {
+    if (gray > s_mono_bayer4[y & 3][k & 3] * 16 + 8) {
+      pattern |= 0x80 >> k;
+    }
+  }
+
+  return pattern;
+}
+
+void slider_circle_mono_fill(uint8_t* row, int32_t x0, int32_t x1, uint8_t pattern) {
+  int32_t i = 0;
+  int32_t b0 = 0;
+  int32_t b1 = 0;
+  uint8_t mask = 0;
+
+  if (x0 >= x1) {
+    return;
+  }
+
+  b0 = x0 >> 3;
+  b1 = (x1 - 1) >> 3;
+  mask = 0xff >> (x0 & 7);
+  if (b0 == b1) {
+    mask &= 0xff << (7 - ((x1 - 1) & 7));
+    row[b0] = (row[b0] & ~mask) | (pattern & mask);
+    return;
+  }
+
+  row[b0] = (row[b0] & ~mask) | (pattern & mask);
+  i = b0 + 1;
+
+  /*中间的整字节，对齐后每次写32个像素*/
+  while (i < b1 && ((uintptr_t)(row + i) & 3) != 0) {
+    row[i++] = pattern;
+  }
+  if (i + 4 <= b1) {
+    uint32_t pattern32 = pattern * 0x01010101u;
+    for (; i + 4 <= b1; i += 4) {
+      *(uint32_t*)(row + i) = pattern32;
+    }
+  }
+  while (i < b1) {
+    row[i++] = pattern;
+  }
+
+  mask = 0xff << (7 - ((x1 - 1) & 7));
+  row[b1] = (row[b1] & ~mask) | (pattern & mask);
+}
+
+/*把区间[*lo, *hi]和半平面k * px + m >= 0相交*/
+static void mono_clip_half_plane(float_t k, float_t m, float_t* lo, float_t* hi) {
+  if (k > 1e-6f) {
+    *lo = tk_max(*lo, -m / k);
+  } else if (k < -1e-6f) {
+    *hi = tk_min(*hi, -m / k);
+  } else if (m < 0) {
+    *hi = *lo - 1;
+  }
+}
+
+/*角度从a到b(b - a <= PI)的扇形与第py行相交的区间*/
+static bool_t mono_sector(float_t a, float_t b, float_t py, float_t* lo, float_t* hi) {
+  *lo = -MONO_INF;
+  *hi = MONO_INF;
+  mono_clip_half_plane(-sin(a), cos(a) * py, lo, hi);
+  mono_clip_half_plane(sin(b), -cos(b) * py, lo, hi);
+
+  return *lo <= *hi;
+}
+
+/*把相对圆心的区间转换成像素中心落在区间内的像素*/
+static uint32_t mono_emit(const slider_circle_raster_arc_t* arc, float_t lo, float_t hi,
+                          int32_t* xs, uint32_t n) {
+  int32_t x0 = (int32_t)ceil(lo + arc->cx - 0.5f);
+  int32_t x1 = (int32_t)floor(hi + arc->cx - 0.5f) + 1;
+
+  if (x0 < x1 && n < SLIDER_CIRCLE_MONO_MAX_SPANS) {
+    xs[2 * n] = x0;
+    xs[2 * n + 1] = x1;
+    n++;
+  }
+
+  return n;
+}
+
+uint32_t slider_circle_mono_row(const slider_circle_raster_arc_t* arc, int32_t y, int32_t* xs) {
+  uint32_t i = 0;
+  uint32_t j = 0;
+  uint32_t n = 0;
+  uint32_t radial_nr = 0;
+  uint32_t angle_nr = 0;
+  float_t radial[4];
+  float_t angle[4];
+  float_t hw = 0;
+  float_t outer = 0;
+  float_t inner = 0;
+  float_t start = 0;
+  float_t sweep = 0;
+  float_t py = 0;
+  return_value_if_fail(arc != NULL && xs != NULL, 0);
+
+  py = y + 0.5f - arc->cy;
+  hw = arc->line_width > 0 ? arc->line_width / 2 : 0;
+  outer = arc->r + hw;
+  inner = arc->line_width > 0 ? arc->r - hw : 0;
+  start = arc->start_angle;
+  sweep = arc->end_angle - arc->start_angle;
+  if (arc->line_width > 0 && arc->cap == SLIDER_CIRCLE_RASTER_CAP_SQUARE && arc->r > 0) {
+    /*方头近似为把圆弧两端各延长半个线宽，与slider_circle_raster_span相差不到一个像素*/
+    start -= hw / arc->r;
+    sweep += 2 * hw / arc->r;
+  }
+
+  /*圆环与这一行相交的区间*/
+  if (tk_abs(py) <= outer) {
+    float_t ro = sqrt(outer * outer - py * py);
+
+    if (inner > 0 && tk_abs(py) < inner) {
+      float_t ri = sqrt(inner * inner - py * py);
+      radial[0] = -ro;
+      radial[1] = -ri;
+      radial[2] = ri;
+      radial[3] = ro;
+      radial_nr = 2;
+    } else {
+      radial[0] = -ro;
+      radial[1] = ro;
+      radial_nr = 1;
+    }
+  }
+
+  /*扇形与这一行相交的区间，大于180度的扇形用补集计算*/
+  if (arc->line_width <= 0 || sweep >= MONO_2PI) {
+    angle[0] = -MONO_INF;
+    angle[1] = MONO_INF;
+    angle_nr = 1;
+  } else if (sweep <= M_PI) {
+    angle_nr = mono_sector(start, start + sweep, py, angle, angle + 1) ? 1 : 0;
+  } else if (mono_sector(start + sweep, start + MONO_2PI, py, angle + 1, angle + 2)) {
+    angle[0] = -MONO_INF;
+    angle[3] = MONO_INF;
+    angle_nr = 2;
+  } else {
+    angle[0] = -MONO_INF;
+    angle[1] = MONO_INF;
+    angle_nr = 1;
+  }
+
+  for (i = 0; i < radial_nr; i++) {
+    for (j = 0; j < angle_nr; j++) {
+      float_t lo = tk_max(radial[2 * i], angle[2 * j]);
+      float_t hi = tk_min(radial[2 * i + 1], angle[2 * j + 1]);
+
+      if (lo <= hi) {
+        n = mono_emit(arc, lo, hi, xs, n);
+      }
+    }
+  }
+
+  if (arc->line_width > 0 && arc->cap == SLIDER_CIRCLE_RASTER_CAP_ROUND && sweep < MONO_2PI) {
+    float_t ends[2];
+
+    ends[0] = arc->start_angle;
+    ends[1] = arc->end_angle;
+    for (i = 0; i < ARRAY_SIZE(ends); i++) {
+      float_t dy = py - arc->r * sin(ends[i]);
+
+      if (tk_abs(dy) <= hw) {
+        float_t ex = arc->r * cos(ends[i]);
+        float_t h = sqrt(hw * hw - dy * dy);
+        n = mono_emit(arc, ex - h, ex + h, xs, n);
+      }
+    }
+  }
+
+  return n;
+}
+
+ret_t slider_circle_mono_draw_fb(uint8_t* fb, uint32_t line_length, const rect_t* clip,
+                                 const slider_circle_raster_arc_t* arc, color_t color,
+                                 bool_t dither) {
+  rect_t r;
+  int32_t y = 0;
+  int32_t y1 = 0;
+  return_value_if_fail(fb != NULL && clip != NULL && arc != NULL, RET_BAD_PARAMS);
+
+  /*单色屏没有半透明，alpha小于一半时不画*/
+  if (color.rgba.a < 0x80) {
+    return RET_OK;
+  }
+
+  slider_circle_raster_bounds(arc, &r);
+  y1 = tk_min(r.y + r.h, clip->y + clip->h);
+
+  for (y = tk_max(r.y, clip->y); y < y1; y++) {
+    uint32_t k = 0;
+    int32_t xs[2 * SLIDER_CIRCLE_MONO_MAX_SPANS];
+    uint32_t spans = slider_circle_mono_row(arc, y, xs);
+    uint8_t pattern = slider_circle_mono_pattern(color, y, dither);
+
+    for (k = 0; k < spans; k++) {
+      int32_t x0 = tk_max(xs[2 * k], clip->x);
+      int32_t x1 = tk_min(xs[2 * k + 1], clip->x + clip->w);
+
+      slider_circle_mono_fill(fb + y * line_length, x0, x1, pattern);
+    }
+  }
+
+  return RET_OK;
+}
+
+bool_t slider_circle_mono_supported(canvas_t* c) {
+  if (!slider_circle_direct_is_enabled() || c == NULL || c->lcd == NULL ||
+      c->lcd->type != LCD_MONO) {
+    return FALSE;
+  }
+
+  if (system_info()->lcd_orientation != LCD_ORIENTATION_0) {
+    return FALSE;
+  }
+
+  return ((lcd_mono_t*)(c->lcd))->data != NULL;
+}
+
+ret_t slider_circle_mono_draw(canvas_t* c, const slider_circle_raster_arc_t* arc, color_t color,
+                              bool_t dither) {
+  rect_t clip;
+  rect_t screen;
+  slider_circle_raster_arc_t a;
+  return_value_if_fail(slider_circle_mono_supported(c) && arc != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(arc->start_angle <= arc->end_angle, RET_BAD_PARAMS);
+
+  screen = rect_init(0, 0, c->lcd->w, c->lcd->h);
+  canvas_get_clip_rect(c, &clip);
+  clip = rect_intersect(&clip, &screen);
+  if (clip.w <= 0 || clip.h <= 0) {
+    return RET_OK;
+  }
+
+  a = *arc;
+  a.cx += c->ox;
+  a.cy += c->oy;
+  if (c->lcd->global_alpha < 0xff) {
+    color.rgba.a = (color.rgba.a * c->lcd->global_alpha + 127) / 255;
+  }
+
+  return slider_circle_mono_draw_fb(((lcd_mono_t*)(c->lcd))->data,
+                                    TK_BITMAP_MONO_LINE_LENGTH(c->lcd->w), &clip, &a, color,
+                                    dither);
+}
+
+#endif /*SLIDER_CIRCLE_WITHOUT_DIRECT*/
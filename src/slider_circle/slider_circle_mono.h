@@ -0,0 +1,107 @@
+﻿/**
+ * File:   slider_circle_mono.h
+ * Author: AWTK Develop Team
+ * Brief:  直接在单色(1bpp)的framebuffer上绘制圆弧和圆(不经过vgcanvas)。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SLIDER_CIRCLE_MONO_H
+#define TK_SLIDER_CIRCLE_MONO_H
+
+#include "base/canvas.h"
+#include "slider_circle_raster.h"
+
+BEGIN_C_DECLS
+
+/*每行最多的区间数(圆环与扇形相交最多4个，两个圆头各1个)*/
+#define SLIDER_CIRCLE_MONO_MAX_SPANS 6
+
+/**
+ * @method slider_circle_mono_supported
+ * 检查画布是否为可以直接绘制的单色LCD(没有旋转)。
+ * @param {canvas_t*} c 画布对象。
+ *
+ * @return {bool_t} 返回TRUE表示可以直接绘制。
+ */
+bool_t slider_circle_mono_supported(canvas_t* c);
+
+/**
+ * @method slider_circle_mono_draw
+ * 在单色画布上绘制圆弧(start_angle必须小于等于end_angle)。
+ * @param {canvas_t*} c 画布对象(slider_circle_mono_supported返回TRUE)。
+ * @param {const slider_circle_raster_arc_t*} arc 圆弧(坐标相对于画布当前的原点)。
+ * @param {color_t} color 颜色(按亮度转换成黑白)。
+ * @param {bool_t} dither 是否按亮度用4x4的有序抖动表示灰度(否则亮度大于等于128为亮)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_mono_draw(canvas_t* c, const slider_circle_raster_arc_t* arc, color_t color,
+                              bool_t dither);
+
+/**
+ * @method slider_circle_mono_draw_fb
+ * 在1bpp的framebuffer(每个字节的最高位是最左边的像素，1为亮)上绘制圆弧。
+ * @param {uint8_t*} fb framebuffer。
+ * @param {uint32_t} line_length 每行的字节数。
+ * @param {const rect_t*} clip 裁剪矩形(必须在framebuffer之内)。
+ * @param {const slider_circle_raster_arc_t*} arc 圆弧(坐标相对于framebuffer的左上角)。
+ * @param {color_t} color 颜色。
+ * @param {bool_t} dither 是否使用有序抖动。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_mono_draw_fb(uint8_t* fb, uint32_t line_length, const rect_t* clip,
+                                 const slider_circle_raster_arc_t* arc, color_t color,
+                                 bool_t dither);
+
+/**
+ * @method slider_circle_mono_row
+ * 计算第y行中像素中心落在圆弧内的区间(区间可能重叠，没有裁剪)。
+ * @param {const slider_circle_raster_arc_t*} arc 圆弧。
+ * @param {int32_t} y y坐标。
+ * @param {int32_t*} xs 返回区间[xs[0], xs[1])、[xs[2], xs[3])...(至少2*SLIDER_CIRCLE_MONO_MAX_SPANS个)。
+ *
+ * @return {uint32_t} 返回区间的个数。
+ */
+uint32_t slider_circle_mono_row(const slider_circle_raster_arc_t* arc, int32_t y, int32_t* xs);
+
+/**
+ * @method slider_circle_mono_fill
+ * 用pattern填充一行中[x0, x1)的像素(中间部分每次写32个像素)。
+ * @param {uint8_t*} row 行的起始地址。
+ * @param {int32_t} x0 起始x坐标。
+ * @param {int32_t} x1 结束x坐标(不包括)。
+ * @param {uint8_t} pattern 8个像素的值(0x00全暗，0xff全亮，抖动时为当前行的图案)。
+ *
+ * @return {void} 无。
+ */
+void slider_circle_mono_fill(uint8_t* row, int32_t x0, int32_t x1, uint8_t pattern);
+
+/**
+ * @method slider_circle_mono_pattern
+ * 计算颜色在第y行的8像素图案。
+ * @param {color_t} color 颜色。
+ * @param {int32_t} y y坐标。
+ * @param {bool_t} dither 是否使用有序抖动。
+ *
+ * @return {uint8_t} 返回图案。
+ */
+uint8_t slider_circle_mono_pattern(color_t color, int32_t y, bool_t dither);
+
+END_C_DECLS
+
+#endif /*TK_SLIDER_CIRCLE_MONO_H*/
@@ -0,0 +1,207 @@
+﻿/**
+ * File:   slider_circle_pointer_trace.c
+ * Author: AWTK Develop Team
+ * Brief:  记录指针事件序列(用于回放和测量拖动的延迟)。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-14 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/fs.h"
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "tkc/time_now.h"
+#include "slider_circle_pointer_trace.h"
+
+static const uint32_t s_pointer_events[] = {EVT_POINTER_DOWN, EVT_POINTER_MOVE, EVT_POINTER_UP,
+                                            EVT_POINTER_DOWN_ABORT};
+
+ret_t slider_circle_pointer_trace_init(slider_circle_pointer_trace_t* trace) {
+  return_value_if_fail(trace != NULL, RET_BAD_PARAMS);
+
+  memset(trace, 0x00, sizeof(*trace));
+
+  return RET_OK;
+}
+
+static ret_t slider_circle_pointer_trace_extend(slider_circle_pointer_trace_t* trace,
+                                                uint32_t capacity) {
+  slider_circle_pointer_record_t* records = NULL;
+
+  if (capacity <= trace->capacity) {
+    return RET_OK;
+  }
+
+  capacity = tk_max(capacity, trace->capacity + (trace->capacity >> 1) + 64);
+  records = TKMEM_REALLOCT(slider_circle_pointer_record_t, trace->records, capacity);
+  return_value_if_fail(records != NULL, RET_OOM);
+
+  trace->records = records;
+  trace->capacity = capacity;
+
+  return RET_OK;
+}
+
+ret_t slider_circle_pointer_trace_append(slider_circle_pointer_trace_t* trace,
+                                         slider_circle_pointer_type_t type, xy_t x, xy_t y,
+                                         uint32_t time) {
+  slider_circle_pointer_record_t* record = NULL;
+  return_value_if_fail(trace != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(slider_circle_pointer_trace_extend(trace, trace->size + 1) == RET_OK,
+                       RET_OOM);
+
+  record = trace->records + trace->size++;
+  record->time = time;
+  record->type = type;
+  record->x = x;
+  record->y = y;
+  record->reserved = 0;
+
+  return RET_OK;
+}
+
+static ret_t slider_circle_pointer_trace_on_event(void* ctx, event_t* e) {
+  uint32_t i = 0;
+  uint64_t now = 0;
+  point_t p = {0, 0};
+  slider_circle_pointer_trace_t* trace = (slider_circle_pointer_trace_t*)ctx;
+  pointer_event_t* evt = pointer_event_cast(e);
+  return_value_if_fail(evt != NULL && trace->target != NULL, RET_OK);
+
+  for (i = 0; i < ARRAY_SIZE(s_pointer_events); i++) {
+    if (s_pointer_events[i] == e->type) {
+      break;
+    }
+  }
+  return_value_if_fail(i < ARRAY_SIZE(s_pointer_events), RET_OK);
+
+  now = e->time != 0 ? e->time : time_now_ms();
+  if (trace->size == 0) {
+    trace->start_time = now;
+    trace->w = trace->target->w;
+    trace->h = trace->target->h;
+  }
+
+  p.x = evt->x;
+  p.y = evt->y;
+  widget_to_local(trace->target, &p);
+  slider_circle_pointer_trace_append(trace, (slider_circle_pointer_type_t)i, p.x, p.y,
+                                     (uint32_t)(now - trace->start_time));
+
+  return RET_OK;
+}
+
+ret_t slider_circle_pointer_trace_start(slider_circle_pointer_trace_t* trace, widget_t* source,
+                                        widget_t* target) {
+  uint32_t i = 0;
+  return_value_if_fail(trace != NULL && source != NULL && target != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(trace->source == NULL, RET_BUSY);
+
+  trace->source = source;
+  trace->target = target;
+  for (i = 0; i < ARRAY_SIZE(s_pointer_events); i++) {
+    trace->event_ids[i] =
+        widget_on(source, s_pointer_events[i], slider_circle_pointer_trace_on_event, trace);
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_pointer_trace_stop(slider_circle_pointer_trace_t* trace) {
+  uint32_t i = 0;
+  return_value_if_fail(trace != NULL, RET_BAD_PARAMS);
+
+  if (trace->source != NULL) {
+    for (i = 0; i < ARRAY_SIZE(s_pointer_events); i++) {
+      widget_off(trace->source, trace->event_ids[i]);
+      trace->event_ids[i] = 0;
+    }
+  }
+  trace->source = NULL;
+  trace->target = NULL;
+
+  return RET_OK;
+}
+
+ret_t slider_circle_pointer_trace_save(slider_circle_pointer_trace_t* trace, const char* filename) {
+  ret_t ret = RET_OK;
+  uint8_t* buff = NULL;
+  uint32_t size = 0;
+  slider_circle_pointer_trace_header_t header;
+  return_value_if_fail(trace != NULL && filename != NULL, RET_BAD_PARAMS);
+
+  memset(&header, 0x00, sizeof(header));
+  header.magic = SLIDER_CIRCLE_POINTER_TRACE_MAGIC;
+  header.version = SLIDER_CIRCLE_POINTER_TRACE_VERSION;
+  header.record_size = sizeof(slider_circle_pointer_record_t);
+  header.count = trace->size;
+  header.w = trace->w;
+  header.h = trace->h;
+
+  size = sizeof(header) + trace->size * sizeof(slider_circle_pointer_record_t);
+  buff = (uint8_t*)TKMEM_ALLOC(size);
+  return_value_if_fail(buff != NULL, RET_OOM);
+
+  memcpy(buff, &header, sizeof(header));
+  if (trace->size > 0) {
+    memcpy(buff + sizeof(header), trace->records,
+           trace->size * sizeof(slider_circle_pointer_record_t));
+  }
+  ret = file_write(filename, buff, size);
+  TKMEM_FREE(buff);
+
+  return ret;
+}
+
+ret_t slider_circle_pointer_trace_load(slider_circle_pointer_trace_t* trace, const char* filename) {
+  ret_t ret = RET_OK;
+  uint32_t size = 0;
+  uint8_t* buff = NULL;
+  slider_circle_pointer_trace_header_t* header = NULL;
+  return_value_if_fail(trace != NULL && filename != NULL, RET_BAD_PARAMS);
+
+  buff = (uint8_t*)file_read(filename, &size);
+  return_value_if_fail(buff != NULL, RET_IO);
+
+  header = (slider_circle_pointer_trace_header_t*)buff;
+  if (size < sizeof(*header) || header->magic != SLIDER_CIRCLE_POINTER_TRACE_MAGIC ||
+      header->version != SLIDER_CIRCLE_POINTER_TRACE_VERSION ||
+      header->record_size != sizeof(slider_circle_pointer_record_t) ||
+      size < sizeof(*header) + header->count * sizeof(slider_circle_pointer_record_t)) {
+    ret = RET_BAD_PARAMS;
+  } else {
+    ret = slider_circle_pointer_trace_extend(trace, trace->size + header->count);
+    if (ret == RET_OK) {
+      memcpy(trace->records + trace->size, header + 1,
+             header->count * sizeof(slider_circle_pointer_record_t));
+      trace->size += header->count;
+      trace->w = header->w;
+      trace->h = header->h;
+    }
+  }
+  TKMEM_FREE(buff);
+
+  return ret;
+}
+
+ret_t slider_circle_pointer_trace_deinit(slider_circle_pointer_trace_t* trace) {
+  return_value_if_fail(trace != NULL, RET_BAD_PARAMS);
+
+  slider_circle_pointer_trace_stop(trace);
+  TKMEM_FREE(trace->records);
+  memset(trace, 0x00, sizeof(*trace));
+
+  return RET_OK;
+}
@@ -0,0 +1,176 @@
+﻿/**
+ * File:   slider_circle_pointer_trace.h
+ * Author: AWTK Develop Team
+ * Brief:  记录指针事件序列(用于回放和测量拖动的延迟)。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-14 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SLIDER_CIRCLE_POINTER_TRACE_H
+#define TK_SLIDER_CIRCLE_POINTER_TRACE_H
+
+#include "base/widget.h"
+
+BEGIN_C_DECLS
+
+#define SLIDER_CIRCLE_POINTER_TRACE_MAGIC 0x54504353 /*SCPT*/
+#define SLIDER_CIRCLE_POINTER_TRACE_VERSION 1
+
+/**
+ * @enum slider_circle_pointer_type_t
+ * 记录的指针事件类型(与AWTK的事件编号无关，文件在不同版本之间通用)。
+ */
+typedef enum _slider_circle_pointer_type_t {
+  SLIDER_CIRCLE_POINTER_DOWN = 0,
+  SLIDER_CIRCLE_POINTER_MOVE,
+  SLIDER_CIRCLE_POINTER_UP,
+  SLIDER_CIRCLE_POINTER_DOWN_ABORT
+} slider_circle_pointer_type_t;
+
+/**
+ * @class slider_circle_pointer_trace_header_t
+ * 指针事件文件的文件头，后面紧跟count个slider_circle_pointer_record_t。
+ */
+typedef struct _slider_circle_pointer_trace_header_t {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t record_size;
+  uint32_t count;
+  /*录制时目标控件的大小*/
+  uint16_t w;
+  uint16_t h;
+} slider_circle_pointer_trace_header_t;
+
+/**
+ * @class slider_circle_pointer_record_t
+ * 一个指针事件。
+ */
+typedef struct _slider_circle_pointer_record_t {
+  /*相对第一个事件的时间(毫秒)*/
+  uint32_t time;
+  uint16_t type;
+  /*相对目标控件左上角的坐标*/
+  int16_t x;
+  int16_t y;
+  uint16_t reserved;
+} slider_circle_pointer_record_t;
+
+/**
+ * @class slider_circle_pointer_trace_t
+ * 指针事件序列。
+ *
+ * 可以挂到窗口上录制真实设备上的指针事件，保存到文件，再用tests/pointer_replay回放。
+ *
+ * ```c
+ * slider_circle_pointer_trace_init(&trace);
+ * slider_circle_pointer_trace_start(&trace, win, slider_circle);
+ * ...
+ * slider_circle_pointer_trace_stop(&trace);
+ * slider_circle_pointer_trace_save(&trace, "drag.trace");
+ * slider_circle_pointer_trace_deinit(&trace);
+ * ```
+ */
+typedef struct _slider_circle_pointer_trace_t {
+  wh_t w;
+  wh_t h;
+  uint32_t size;
+  uint32_t capacity;
+  slider_circle_pointer_record_t* records;
+
+  /*private*/
+  widget_t* source;
+  widget_t* target;
+  uint64_t start_time;
+  uint32_t event_ids[4];
+} slider_circle_pointer_trace_t;
+
+/**
+ * @method slider_circle_pointer_trace_init
+ * 初始化。
+ * @param {slider_circle_pointer_trace_t*} trace 指针事件序列。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_pointer_trace_init(slider_circle_pointer_trace_t* trace);
+
+/**
+ * @method slider_circle_pointer_trace_append
+ * 追加一个事件。
+ * @param {slider_circle_pointer_trace_t*} trace 指针事件序列。
+ * @param {slider_circle_pointer_type_t} type 事件类型。
+ * @param {xy_t} x 相对目标控件的x坐标。
+ * @param {xy_t} y 相对目标控件的y坐标。
+ * @param {uint32_t} time 相对第一个事件的时间(毫秒)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_pointer_trace_append(slider_circle_pointer_trace_t* trace,
+                                         slider_circle_pointer_type_t type, xy_t x, xy_t y,
+                                         uint32_t time);
+
+/**
+ * @method slider_circle_pointer_trace_start
+ * 开始录制source收到的指针事件(通常是窗口)，坐标转换为相对target的坐标。
+ * @param {slider_circle_pointer_trace_t*} trace 指针事件序列。
+ * @param {widget_t*} source 监听事件的控件。
+ * @param {widget_t*} target 目标控件。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_pointer_trace_start(slider_circle_pointer_trace_t* trace, widget_t* source,
+                                        widget_t* target);
+
+/**
+ * @method slider_circle_pointer_trace_stop
+ * 停止录制。
+ * @param {slider_circle_pointer_trace_t*} trace 指针事件序列。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_pointer_trace_stop(slider_circle_pointer_trace_t* trace);
+
+/**
+ * @method slider_circle_pointer_trace_save
+ * 保存到文件。
+ * @param {slider_circle_pointer_trace_t*} trace 指针事件序列。
+ * @param {const char*} filename 文件名。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_pointer_trace_save(slider_circle_pointer_trace_t* trace, const char* filename);
+
+/**
+ * @method slider_circle_pointer_trace_load
+ * 从文件加载(追加到现有的事件之后)。
+ * @param {slider_circle_pointer_trace_t*} trace 指针事件序列。
+ * @param {const char*} filename 文件名。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_pointer_trace_load(slider_circle_pointer_trace_t* trace, const char* filename);
+
+/**
+ * @method slider_circle_pointer_trace_deinit
+ * 停止录制并释放资源。
+ * @param {slider_circle_pointer_trace_t*} trace 指针事件序列。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_pointer_trace_deinit(slider_circle_pointer_trace_t* trace);
+
+END_C_DECLS
+
+#endif /*TK_SLIDER_CIRCLE_POINTER_TRACE_H*/
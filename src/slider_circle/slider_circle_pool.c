@@ -0,0 +1,193 @@
+﻿/**
+ * File:   slider_circle_pool.c
+ * Author: AWTK Develop Team
+ * Brief:  slider_circle字符串(format/line_cap)的小块内存池。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "slider_circle_pool.h"
+
+typedef union _pool_slot_t {
+  union _pool_slot_t* next;
+  char str[SLIDER_CIRCLE_POOL_SLOT_SIZE];
+} pool_slot_t;
+
+typedef struct _pool_block_t {
+  struct _pool_block_t* next;
+  uint32_t used;
+  pool_slot_t slots[SLIDER_CIRCLE_POOL_BLOCK_SLOTS];
+} pool_block_t;
+
+typedef struct _slider_circle_pool_t {
+  pool_block_t* blocks;
+  pool_slot_t* free_slots;
+  uint32_t free_nr;
+  slider_circle_pool_stats_t stats;
+} slider_circle_pool_t;
+
+static slider_circle_pool_t s_pool;
+
+static pool_block_t* pool_find_block(const void* p) {
+  pool_block_t* iter = s_pool.blocks;
+
+  while (iter != NULL) {
+    if ((const char*)p >= (const char*)(iter->slots) &&
+        (const char*)p < (const char*)(iter->slots + SLIDER_CIRCLE_POOL_BLOCK_SLOTS)) {
+      return iter;
+    }
+    iter = iter->next;
+  }
+
+  return NULL;
+}
+
+static ret_t pool_add_block(void) {
+  uint32_t i = 0;
+  pool_block_t* block = TKMEM_ZALLOC(pool_block_t);
+  return_value_if_fail(block != NULL, RET_OOM);
+
+  for (i = 0; i < SLIDER_CIRCLE_POOL_BLOCK_SLOTS; i++) {
+    block->slots[i].next = s_pool.free_slots;
+    s_pool.free_slots = block->slots + i;
+  }
+  s_pool.free_nr += SLIDER_CIRCLE_POOL_BLOCK_SLOTS;
+
+  block->next = s_pool.blocks;
+  s_pool.blocks = block;
+  s_pool.stats.blocks++;
+  s_pool.stats.slots += SLIDER_CIRCLE_POOL_BLOCK_SLOTS;
+
+  return RET_OK;
+}
+
+ret_t slider_circle_pool_reserve(uint32_t widgets) {
+  uint32_t need = widgets * SLIDER_CIRCLE_POOL_SLOTS_PER_WIDGET;
+
+  while (s_pool.free_nr < need) {
+    return_value_if_fail(pool_add_block() == RET_OK, RET_OOM);
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_pool_release(void) {
+  pool_slot_t* iter = NULL;
+  pool_block_t** block = &(s_pool.blocks);
+
+  /*先把空闲块中的槽从空闲链表中去掉，再释放空闲块*/
+  iter = s_pool.free_slots;
+  s_pool.free_slots = NULL;
+  s_pool.free_nr = 0;
+  while (iter != NULL) {
+    pool_slot_t* next = iter->next;
+    if (pool_find_block(iter)->used > 0) {
+      iter->next = s_pool.free_slots;
+      s_pool.free_slots = iter;
+      s_pool.free_nr++;
+    }
+    iter = next;
+  }
+
+  while (*block != NULL) {
+    pool_block_t* b = *block;
+    if (b->used == 0) {
+      *block = b->next;
+      s_pool.stats.blocks--;
+      s_pool.stats.slots -= SLIDER_CIRCLE_POOL_BLOCK_SLOTS;
+      TKMEM_FREE(b);
+    } else {
+      block = &(b->next);
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_pool_get_stats(slider_circle_pool_stats_t* stats) {
+  return_value_if_fail(stats != NULL, RET_BAD_PARAMS);
+
+  *stats = s_pool.stats;
+
+  return RET_OK;
+}
+
+ret_t slider_circle_pool_str_free(char* str) {
+  pool_block_t* block = NULL;
+
+  if (str == NULL) {
+    return RET_OK;
+  }
+
+  block = pool_find_block(str);
+  if (block != NULL) {
+    pool_slot_t* slot = (pool_slot_t*)str;
+
+    slot->next = s_pool.free_slots;
+    s_pool.free_slots = slot;
+    s_pool.free_nr++;
+    block->used--;
+    s_pool.stats.used--;
+  } else {
+    TKMEM_FREE(str);
+  }
+
+  return RET_OK;
+}
+
+char* slider_circle_pool_str_copy(char* dst, const char* src) {
+  char* str = NULL;
+  uint32_t size = 0;
+
+  if (tk_str_eq(dst, src)) {
+    return dst;
+  }
+
+  if (src == NULL) {
+    slider_circle_pool_str_free(dst);
+    return NULL;
+  }
+
+  size = strlen(src) + 1;
+  if (size <= SLIDER_CIRCLE_POOL_SLOT_SIZE && dst != NULL && pool_find_block(dst) != NULL) {
+    /*原来就在池中，直接覆盖*/
+    memcpy(dst, src, size);
+    return dst;
+  }
+
+  slider_circle_pool_str_free(dst);
+  if (size <= SLIDER_CIRCLE_POOL_SLOT_SIZE && s_pool.free_slots != NULL) {
+    pool_slot_t* slot = s_pool.free_slots;
+    pool_block_t* block = pool_find_block(slot);
+
+    s_pool.free_slots = slot->next;
+    s_pool.free_nr--;
+    block->used++;
+    s_pool.stats.used++;
+    s_pool.stats.peak = tk_max(s_pool.stats.peak, s_pool.stats.used);
+    s_pool.stats.pooled_allocs++;
+    str = slot->str;
+  } else {
+    str = (char*)TKMEM_ALLOC(size);
+    return_value_if_fail(str != NULL, NULL);
+    s_pool.stats.heap_allocs++;
+  }
+  memcpy(str, src, size);
+
+  return str;
+}
@@ -0,0 +1,143 @@
+﻿/**
+ * File:   slider_circle_pool.h
+ * Author: AWTK Develop Team
+ * Brief:  slider_circle字符串(format/line_cap)的小块内存池。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SLIDER_CIRCLE_POOL_H
+#define TK_SLIDER_CIRCLE_POOL_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+/*每个槽的大小(包括结尾的0，更长的字符串从堆中分配)*/
+#define SLIDER_CIRCLE_POOL_SLOT_SIZE 16
+
+/*每块的槽数*/
+#define SLIDER_CIRCLE_POOL_BLOCK_SLOTS 64
+
+/*每个控件使用的槽数(format和line_cap)*/
+#define SLIDER_CIRCLE_POOL_SLOTS_PER_WIDGET 2
+
+/**
+ * @class slider_circle_pool_stats_t
+ * 内存池的统计信息。
+ */
+typedef struct _slider_circle_pool_stats_t {
+  /**
+   * @property {uint32_t} blocks
+   * 块数。
+   */
+  uint32_t blocks;
+  /**
+   * @property {uint32_t} slots
+   * 总的槽数。
+   */
+  uint32_t slots;
+  /**
+   * @property {uint32_t} used
+   * 正在使用的槽数。
+   */
+  uint32_t used;
+  /**
+   * @property {uint32_t} peak
+   * 同时使用的槽数的最大值。
+   */
+  uint32_t peak;
+  /**
+   * @property {uint32_t} pooled_allocs
+   * 从池中分配的次数(也就是避免了的小块堆分配的次数)。
+   */
+  uint32_t pooled_allocs;
+  /**
+   * @property {uint32_t} heap_allocs
+   * 池中没有空闲的槽或者字符串太长，从堆中分配的次数。
+   */
+  uint32_t heap_allocs;
+} slider_circle_pool_stats_t;
+
+/**
+ * @class slider_circle_pool_t
+ * @annotation ["fake"]
+ * slider_circle字符串的内存池。
+ *
+ * 没有预留时所有字符串都从TKMEM分配(与不使用内存池时一样)。
+ * 打开界面之前按控件的数量预留，字符串就从整块的内存中分配，
+ * 关闭界面之后一次释放所有空闲的块，避免长期运行的设备上堆的碎片化。
+ *
+ * ```c
+ * slider_circle_pool_reserve(40);
+ * win = window_open("gauges");
+ * ...
+ * window_close(win);
+ * slider_circle_pool_release();
+ * ```
+ *
+ * > 控件对象本身由widget_create/widget_destroy分配和释放，不能放到内存池中。
+ * > 只能在GUI线程中使用。
+ */
+
+/**
+ * @method slider_circle_pool_reserve
+ * 预留至少能容纳widgets个控件的字符串的空闲槽。
+ * @param {uint32_t} widgets 控件的数量。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_pool_reserve(uint32_t widgets);
+
+/**
+ * @method slider_circle_pool_release
+ * 释放所有空闲的块(还在使用的块保留)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_pool_release(void);
+
+/**
+ * @method slider_circle_pool_get_stats
+ * 获取统计信息。
+ * @param {slider_circle_pool_stats_t*} stats 返回统计信息。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_pool_get_stats(slider_circle_pool_stats_t* stats);
+
+/**
+ * @method slider_circle_pool_str_copy
+ * 与tk_str_copy类似，把src拷贝到dst，返回新的字符串(内容相同时直接返回dst)。
+ * @param {char*} dst 原来的字符串(来自slider_circle_pool_str_copy，可以为NULL)。
+ * @param {const char*} src 新的字符串(为NULL时释放dst并返回NULL)。
+ *
+ * @return {char*} 返回新的字符串。
+ */
+char* slider_circle_pool_str_copy(char* dst, const char* src);
+
+/**
+ * @method slider_circle_pool_str_free
+ * 释放slider_circle_pool_str_copy返回的字符串。
+ * @param {char*} str 字符串。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_pool_str_free(char* str);
+
+END_C_DECLS
+
+#endif /*TK_SLIDER_CIRCLE_POOL_H*/
@@ -0,0 +1,396 @@
+﻿/**
+ * File:   slider_circle_raster.c
+ * Author: AWTK Develop Team
+ * Brief:  圆弧和圆的软件光栅化(计算每个像素的覆盖率，不依赖vgcanvas，可以在其它线程中使用)。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-15 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include <math.h>
+#include "tkc/utils.h"
+#include "slider_circle_raster.h"
+
+#ifndef SLIDER_CIRCLE_WITHOUT_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SLIDER_CIRCLE_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SLIDER_CIRCLE_NEON 1
+#include <arm_neon.h>
+#endif
+#endif /*SLIDER_CIRCLE_WITHOUT_SIMD*/
+
+#define RASTER_2PI (2 * M_PI)
+#define RASTER_SPAN_MAX 256
+#define RASTER_LANES 4
+
+slider_circle_raster_cap_t slider_circle_raster_cap_from_str(const char* line_cap) {
+  if (tk_str_eq(line_cap, "round")) {
+    return SLIDER_CIRCLE_RASTER_CAP_ROUND;
+  } else if (tk_str_eq(line_cap, "square")) {
+    return SLIDER_CIRCLE_RASTER_CAP_SQUARE;
+  }
+
+  return SLIDER_CIRCLE_RASTER_CAP_BUTT;
+}
+
+const char* slider_circle_raster_cap_to_str(slider_circle_raster_cap_t cap) {
+  switch (cap) {
+    case SLIDER_CIRCLE_RASTER_CAP_ROUND:
+      return "round";
+    case SLIDER_CIRCLE_RASTER_CAP_SQUARE:
+      return "square";
+    default:
+      return "butt";
+  }
+}
+
+ret_t slider_circle_raster_bounds(const slider_circle_raster_arc_t* arc, rect_t* r) {
+  float_t outer = 0;
+  return_value_if_fail(arc != NULL && r != NULL, RET_BAD_PARAMS);
+
+  /*按整圆计算，多出来的部分覆盖率为0*/
+  outer = arc->r + arc->line_width / 2 + 1;
+  r->x = (xy_t)floor(arc->cx - outer);
+  r->y = (xy_t)floor(arc->cy - outer);
+  r->w = (wh_t)ceil(arc->cx + outer) - r->x;
+  r->h = (wh_t)ceil(arc->cy + outer) - r->y;
+
+  return RET_OK;
+}
+
+uint32_t slider_circle_raster_row(const slider_circle_raster_arc_t* arc, int32_t y, int32_t* xs) {
+  float_t dy = 0;
+  float_t half = 0;
+  float_t inner = 0;
+  float_t outer = 0;
+  return_value_if_fail(arc != NULL && xs != NULL, 0);
+
+  dy = tk_abs(y + 0.5f - arc->cy);
+  outer = arc->r + arc->line_width / 2 + 1;
+  inner = arc->line_width > 0 ? arc->r - arc->line_width / 2 - 1 : 0;
+  if (dy >= outer) {
+    return 0;
+  }
+
+  half = sqrt(outer * outer - dy * dy);
+  xs[0] = (int32_t)floor(arc->cx - half);
+  xs[3] = (int32_t)ceil(arc->cx + half);
+
+  if (inner > dy + 1) {
+    /*中心到空洞边界不超过inner的像素覆盖率一定为0*/
+    half = sqrt(inner * inner - dy * dy);
+    xs[1] = (int32_t)ceil(arc->cx - half);
+    xs[2] = (int32_t)floor(arc->cx + half - 1) + 1;
+    if (xs[1] < xs[2]) {
+      return 2;
+    }
+  }
+
+  xs[1] = xs[3];
+
+  return 1;
+}
+
+static float_t raster_clamp01(float_t v) {
+  return v <= 0 ? 0 : (v >= 1 ? 1 : v);
+}
+
+ret_t slider_circle_raster_prepare(slider_circle_raster_prepared_t* prepared,
+                                   const slider_circle_raster_arc_t* arc) {
+  float_t sweep = 0;
+  return_value_if_fail(prepared != NULL && arc != NULL, RET_BAD_PARAMS);
+
+  memset(prepared, 0x00, sizeof(*prepared));
+  prepared->arc = *arc;
+  prepared->hw = arc->line_width / 2;
+  prepared->inner = arc->line_width > 0 ? arc->r - prepared->hw - 1 : -1;
+  prepared->outer = arc->line_width > 0 ? arc->r + prepared->hw + 1 : arc->r + 1;
+
+  sweep = arc->end_angle - arc->start_angle;
+  prepared->full = arc->line_width <= 0 || sweep >= RASTER_2PI;
+  prepared->wide = sweep > M_PI;
+  prepared->sx = cos(arc->start_angle);
+  prepared->sy = sin(arc->start_angle);
+  prepared->ex = cos(arc->end_angle);
+  prepared->ey = sin(arc->end_angle);
+
+  if (arc->cap == SLIDER_CIRCLE_RASTER_CAP_SQUARE) {
+    /*方头把两条边沿切线方向各向外平移半个线宽*/
+    prepared->extend = prepared->hw;
+  }
+
+  return RET_OK;
+}
+
+/*
+ * 到两条径向边(从圆心出发的射线)的距离，在圆弧内为正。
+ * 叉积是到边所在直线的距离，点积为负时点在圆心的另一侧，到射线最近的是圆心。
+ */
+static float_t raster_edge(const slider_circle_raster_prepared_t* p, float_t px, float_t py,
+                           float_t d) {
+  float_t ds = p->sx * py - p->sy * px;
+  float_t de = p->ey * px - p->ex * py;
+  float_t ls = (p->sx * px + p->sy * py) >= 0 ? tk_abs(ds) : d;
+  float_t le = (p->ex * px + p->ey * py) >= 0 ? tk_abs(de) : d;
+  bool_t inside = p->wide ? (ds >= 0 || de >= 0) : (ds >= 0 && de >= 0);
+  float_t edge = tk_min(ls, le);
+
+  return (inside ? edge : -edge) + p->extend;
+}
+
+static float_t raster_cap_coverage(float_t hw, float_t dx, float_t dy) {
+  float_t d2 = dx * dx + dy * dy;
+  float_t limit = hw + 0.5f;
+
+  /*离圆心太远时不开方*/
+  if (d2 >= limit * limit) {
+    return 0;
+  }
+
+  return raster_clamp01(limit - sqrt(d2));
+}
+
+/*不是整圆时乘上到两条径向边的覆盖率，圆头另外计算*/
+static float_t raster_ends(const slider_circle_raster_prepared_t* p, float_t px, float_t py,
+                           float_t d, float_t c) {
+  const slider_circle_raster_arc_t* arc = &(p->arc);
+
+  c *= raster_clamp01(0.5f + raster_edge(p, px, py, d));
+  if (arc->cap == SLIDER_CIRCLE_RASTER_CAP_ROUND && c < 1) {
+    float_t r = arc->r;
+
+    c = tk_max(c, raster_cap_coverage(p->hw, px - r * p->sx, py - r * p->sy));
+    c = tk_max(c, raster_cap_coverage(p->hw, px - r * p->ex, py - r * p->ey));
+  }
+
+  return c;
+}
+
+/*
+ * 一次计算RASTER_LANES个相邻像素(px, px+1, ...)到圆心的距离和只考虑半径方向的覆盖率。
+ * 用倒数平方根的近似值代替逐个像素开方，覆盖率在圆环外和空洞内自然为0。
+ */
+#if defined(SLIDER_CIRCLE_SSE2)
+static void raster_radial(const slider_circle_raster_prepared_t* p, float px, float py, float* d,
+                          float* c) {
+  const slider_circle_raster_arc_t* arc = &(p->arc);
+  __m128 x = _mm_add_ps(_mm_set1_ps(px), _mm_set_ps(3, 2, 1, 0));
+  __m128 d2 = _mm_max_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_set1_ps(py * py)),
+                         _mm_set1_ps(1e-12f));
+  __m128 rs = _mm_rsqrt_ps(d2);
+  __m128 v;
+
+  /*rsqrt只有12位精度，牛顿迭代一次后半径几百像素时误差也远小于1/255*/
+  v = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), d2), _mm_mul_ps(rs, rs));
+  rs = _mm_mul_ps(rs, _mm_sub_ps(_mm_set1_ps(1.5f), v));
+  d2 = _mm_mul_ps(d2, rs);
+
+  if (arc->line_width <= 0) {
+    v = _mm_sub_ps(_mm_set1_ps(arc->r + 0.5f), d2);
+  } else {
+    __m128 t = _mm_sub_ps(d2, _mm_set1_ps(arc->r));
+
+    t = _mm_andnot_ps(_mm_set1_ps(-0.0f), t);
+    v = _mm_sub_ps(_mm_set1_ps(p->hw + 0.5f), t);
+  }
+  v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+
+  _mm_storeu_ps(d, d2);
+  _mm_storeu_ps(c, v);
+}
+#elif defined(SLIDER_CIRCLE_NEON)
+static void raster_radial(const slider_circle_raster_prepared_t* p, float px, float py, float* d,
+                          float* c) {
+  static const float s_lanes[RASTER_LANES] = {0, 1, 2, 3};
+  const slider_circle_raster_arc_t* arc = &(p->arc);
+  float32x4_t x = vaddq_f32(vdupq_n_f32(px), vld1q_f32(s_lanes));
+  float32x4_t d2 = vmaxq_f32(vmlaq_f32(vdupq_n_f32(py * py), x, x), vdupq_n_f32(1e-12f));
+  float32x4_t rs = vrsqrteq_f32(d2);
+  float32x4_t v;
+
+  /*vrsqrte只有8位精度，牛顿迭代两次*/
+  rs = vmulq_f32(rs, vrsqrtsq_f32(vmulq_f32(d2, rs), rs));
+  rs = vmulq_f32(rs, vrsqrtsq_f32(vmulq_f32(d2, rs), rs));
+  d2 = vmulq_f32(d2, rs);
+
+  if (arc->line_width <= 0) {
+    v = vsubq_f32(vdupq_n_f32(arc->r + 0.5f), d2);
+  } else {
+    v = vsubq_f32(vdupq_n_f32(p->hw + 0.5f), vabdq_f32(d2, vdupq_n_f32(arc->r)));
+  }
+  v = vminq_f32(vmaxq_f32(v, vdupq_n_f32(0)), vdupq_n_f32(1.0f));
+
+  vst1q_f32(d, d2);
+  vst1q_f32(c, v);
+}
+#endif /*SLIDER_CIRCLE_SSE2*/
+
+uint32_t slider_circle_raster_span_prepared(const slider_circle_raster_prepared_t* prepared,
+                                            int32_t x, int32_t y, uint32_t n, uint8_t* cov) {
+  uint32_t i = 0;
+  uint32_t nr = 0;
+  float_t py = 0;
+  const slider_circle_raster_arc_t* arc = NULL;
+  return_value_if_fail(prepared != NULL && cov != NULL, 0);
+
+  arc = &(prepared->arc);
+  py = y + 0.5f - arc->cy;
+
+#if defined(SLIDER_CIRCLE_SSE2) || defined(SLIDER_CIRCLE_NEON)
+  for (i = 0; i < n; i += RASTER_LANES) {
+    uint32_t k = 0;
+    float d[RASTER_LANES];
+    float cs[RASTER_LANES];
+    float_t px = x + i + 0.5f - arc->cx;
+    uint32_t m = tk_min(n - i, RASTER_LANES);
+
+    raster_radial(prepared, px, py, d, cs);
+
+    for (k = 0; k < m; k++, px++) {
+      float_t c = cs[k];
+
+      if (!prepared->full && c > 0) {
+        c = raster_ends(prepared, px, py, d[k], c);
+      }
+
+      cov[i + k] = (uint8_t)(c * 255 + 0.5f);
+      if (cov[i + k] != 0) {
+        nr++;
+      }
+    }
+  }
+#else
+  {
+    float_t inner2 = prepared->inner > 0 ? prepared->inner * prepared->inner : -1;
+    float_t outer2 = prepared->outer * prepared->outer;
+
+    for (i = 0; i < n; i++) {
+      float_t c = 0;
+      float_t d = 0;
+      float_t px = x + i + 0.5f - arc->cx;
+      float_t d2 = px * px + py * py;
+
+      if (d2 >= outer2 || d2 <= inner2) {
+        cov[i] = 0;
+        continue;
+      }
+
+      d = sqrt(d2);
+      if (arc->line_width <= 0) {
+        c = raster_clamp01(arc->r + 0.5f - d);
+      } else {
+        c = raster_clamp01(prepared->hw + 0.5f - tk_abs(d - arc->r));
+        if (!prepared->full && c > 0) {
+          c = raster_ends(prepared, px, py, d, c);
+        }
+      }
+
+      cov[i] = (uint8_t)(c * 255 + 0.5f);
+      if (cov[i] != 0) {
+        nr++;
+      }
+    }
+  }
+#endif /*SLIDER_CIRCLE_SSE2*/
+
+  return nr;
+}
+
+uint32_t slider_circle_raster_span(const slider_circle_raster_arc_t* arc, int32_t x, int32_t y,
+                                   uint32_t n, uint8_t* cov) {
+  slider_circle_raster_prepared_t prepared;
+  return_value_if_fail(arc != NULL && cov != NULL, 0);
+
+  slider_circle_raster_prepare(&prepared, arc);
+
+  return slider_circle_raster_span_prepared(&prepared, x, y, n, cov);
+}
+
+static void slider_circle_raster_put(uint8_t* p, color_t color, uint8_t cov, bool_t over) {
+  uint32_t sa = (color.rgba.a * cov + 127) / 255;
+
+  if (over && p[3] != 0 && sa < 0xff) {
+    /*不预乘alpha的src-over*/
+    uint32_t da = (p[3] * (255 - sa) + 127) / 255;
+    uint32_t oa = sa + da;
+
+    p[0] = (color.rgba.r * sa + p[0] * da + oa / 2) / oa;
+    p[1] = (color.rgba.g * sa + p[1] * da + oa / 2) / oa;
+    p[2] = (color.rgba.b * sa + p[2] * da + oa / 2) / oa;
+    p[3] = oa;
+  } else if (!over || sa != 0) {
+    p[0] = color.rgba.r;
+    p[1] = color.rgba.g;
+    p[2] = color.rgba.b;
+    p[3] = sa;
+  }
+}
+
+static ret_t slider_circle_raster_rgba_impl(const slider_circle_raster_arc_t* arc, color_t color,
+                                            uint8_t* data, uint32_t w, uint32_t h,
+                                            uint32_t line_length, bool_t over) {
+  rect_t r;
+  int32_t y = 0;
+  int32_t y1 = 0;
+  uint8_t cov[RASTER_SPAN_MAX];
+  slider_circle_raster_prepared_t prepared;
+  return_value_if_fail(arc != NULL && data != NULL, RET_BAD_PARAMS);
+
+  slider_circle_raster_prepare(&prepared, arc);
+  slider_circle_raster_bounds(arc, &r);
+  y1 = tk_min(r.y + r.h, (int32_t)h);
+
+  for (y = tk_max(r.y, 0); y < y1; y++) {
+    int32_t k = 0;
+    int32_t xs[4];
+    int32_t spans = slider_circle_raster_row(arc, y, xs);
+
+    for (k = 0; k < spans; k++) {
+      int32_t x = tk_max(xs[2 * k], 0);
+      int32_t x1 = tk_min(xs[2 * k + 1], (int32_t)w);
+
+      for (; x < x1; x += RASTER_SPAN_MAX) {
+        uint32_t i = 0;
+        uint32_t n = tk_min(x1 - x, RASTER_SPAN_MAX);
+        uint8_t* p = data + y * line_length + x * 4;
+
+        if (slider_circle_raster_span_prepared(&prepared, x, y, n, cov) == 0) {
+          continue;
+        }
+
+        for (i = 0; i < n; i++, p += 4) {
+          if (cov[i] != 0) {
+            slider_circle_raster_put(p, color, cov[i], over);
+          }
+        }
+      }
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_raster_rgba(const slider_circle_raster_arc_t* arc, color_t color,
+                                uint8_t* data, uint32_t w, uint32_t h, uint32_t line_length) {
+  return slider_circle_raster_rgba_impl(arc, color, data, w, h, line_length, FALSE);
+}
+
+ret_t slider_circle_raster_rgba_over(const slider_circle_raster_arc_t* arc, color_t color,
+                                     uint8_t* data, uint32_t w, uint32_t h,
+                                     uint32_t line_length) {
+  return slider_circle_raster_rgba_impl(arc, color, data, w, h, line_length, TRUE);
+}
@@ -0,0 +1,190 @@
+﻿/**
+ * File:   slider_circle_raster.h
+ * Author: AWTK Develop Team
+ * Brief:  圆弧和圆的软件光栅化(计算每个像素的覆盖率，不依赖vgcanvas，可以在其它线程中使用)。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-15 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SLIDER_CIRCLE_RASTER_H
+#define TK_SLIDER_CIRCLE_RASTER_H
+
+#include "tkc/rect.h"
+#include "tkc/color.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @enum slider_circle_raster_cap_t
+ * 线帽类型。
+ */
+typedef enum _slider_circle_raster_cap_t {
+  SLIDER_CIRCLE_RASTER_CAP_BUTT = 0,
+  SLIDER_CIRCLE_RASTER_CAP_ROUND,
+  SLIDER_CIRCLE_RASTER_CAP_SQUARE
+} slider_circle_raster_cap_t;
+
+/**
+ * @class slider_circle_raster_arc_t
+ * 圆弧(角度为弧度，顺时针，end_angle - start_angle >= 2 * M_PI时为整圆)。
+ * line_width为0时表示半径为r的实心圆。
+ */
+typedef struct _slider_circle_raster_arc_t {
+  float_t cx;
+  float_t cy;
+  float_t r;
+  float_t line_width;
+  float_t start_angle;
+  float_t end_angle;
+  uint32_t cap;
+} slider_circle_raster_arc_t;
+
+/**
+ * @class slider_circle_raster_prepared_t
+ * 按圆弧预先算好的参数(两条径向边的方向、方头平移的距离)。
+ * 逐个像素计算覆盖率时只用乘加和一次开方，不再调用三角函数。
+ * 有SSE2/NEON时4个像素一组，用倒数平方根的近似值代替开方。
+ */
+typedef struct _slider_circle_raster_prepared_t {
+  slider_circle_raster_arc_t arc;
+  float_t hw;
+  float_t inner;
+  float_t outer;
+  /*起点和终点的方向(单位向量)，圆头的圆心为r倍的方向*/
+  float_t sx;
+  float_t sy;
+  float_t ex;
+  float_t ey;
+  /*方头时两条边向外平移的距离*/
+  float_t extend;
+  /*整圆或者实心圆，不用计算两条边*/
+  bool_t full;
+  /*大于180度*/
+  bool_t wide;
+} slider_circle_raster_prepared_t;
+
+/**
+ * @method slider_circle_raster_cap_from_str
+ * 把线帽的名称(round/square/butt)转换成线帽类型(NULL和未知的名称为butt，与vgcanvas一致)。
+ * @param {const char*} line_cap 线帽的名称。
+ *
+ * @return {slider_circle_raster_cap_t} 返回线帽类型。
+ */
+slider_circle_raster_cap_t slider_circle_raster_cap_from_str(const char* line_cap);
+
+/**
+ * @method slider_circle_raster_cap_to_str
+ * 把线帽类型转换成vgcanvas_set_line_cap使用的名称。
+ * @param {slider_circle_raster_cap_t} cap 线帽类型。
+ *
+ * @return {const char*} 返回线帽的名称。
+ */
+const char* slider_circle_raster_cap_to_str(slider_circle_raster_cap_t cap);
+
+/**
+ * @method slider_circle_raster_bounds
+ * 计算圆弧(包括抗锯齿的边缘)可能覆盖的矩形。
+ * @param {const slider_circle_raster_arc_t*} arc 圆弧。
+ * @param {rect_t*} r 返回矩形。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_raster_bounds(const slider_circle_raster_arc_t* arc, rect_t* r);
+
+/**
+ * @method slider_circle_raster_row
+ * 计算第y行可能有覆盖的区间(去掉圆环外面和中间的空洞)。
+ * @param {const slider_circle_raster_arc_t*} arc 圆弧。
+ * @param {int32_t} y y坐标。
+ * @param {int32_t*} xs 返回区间[xs[0], xs[1])和[xs[2], xs[3])。
+ *
+ * @return {uint32_t} 返回区间的个数(0-2)。
+ */
+uint32_t slider_circle_raster_row(const slider_circle_raster_arc_t* arc, int32_t y, int32_t* xs);
+
+/**
+ * @method slider_circle_raster_span
+ * 计算第y行从x开始的n个像素的覆盖率(0-255)。
+ * @param {const slider_circle_raster_arc_t*} arc 圆弧。
+ * @param {int32_t} x 起始x坐标。
+ * @param {int32_t} y y坐标。
+ * @param {uint32_t} n 像素个数。
+ * @param {uint8_t*} cov 返回覆盖率。
+ *
+ * @return {uint32_t} 返回覆盖率不为0的像素个数。
+ */
+uint32_t slider_circle_raster_span(const slider_circle_raster_arc_t* arc, int32_t x, int32_t y,
+                                   uint32_t n, uint8_t* cov);
+
+/**
+ * @method slider_circle_raster_prepare
+ * 预先计算圆弧的参数，同一个圆弧的多行只需要计算一次。
+ * @param {slider_circle_raster_prepared_t*} prepared 返回预先计算的参数。
+ * @param {const slider_circle_raster_arc_t*} arc 圆弧。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_raster_prepare(slider_circle_raster_prepared_t* prepared,
+                                   const slider_circle_raster_arc_t* arc);
+
+/**
+ * @method slider_circle_raster_span_prepared
+ * 与slider_circle_raster_span一样，使用预先计算的参数。
+ * @param {const slider_circle_raster_prepared_t*} prepared 预先计算的参数。
+ * @param {int32_t} x 起始x坐标。
+ * @param {int32_t} y y坐标。
+ * @param {uint32_t} n 像素个数。
+ * @param {uint8_t*} cov 返回覆盖率。
+ *
+ * @return {uint32_t} 返回覆盖率不为0的像素个数。
+ */
+uint32_t slider_circle_raster_span_prepared(const slider_circle_raster_prepared_t* prepared,
+                                            int32_t x, int32_t y, uint32_t n, uint8_t* cov);
+
+/**
+ * @method slider_circle_raster_rgba
+ * 把圆弧画到(清空的)RGBA8888缓冲区中(颜色不预乘alpha)。
+ * @param {const slider_circle_raster_arc_t*} arc 圆弧(坐标相对缓冲区的左上角)。
+ * @param {color_t} color 颜色。
+ * @param {uint8_t*} data 缓冲区。
+ * @param {uint32_t} w 宽度。
+ * @param {uint32_t} h 高度。
+ * @param {uint32_t} line_length 每行的字节数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_raster_rgba(const slider_circle_raster_arc_t* arc, color_t color,
+                                uint8_t* data, uint32_t w, uint32_t h, uint32_t line_length);
+
+/**
+ * @method slider_circle_raster_rgba_over
+ * 把圆弧叠加到RGBA8888缓冲区中已有的内容上(颜色不预乘alpha)。
+ * @param {const slider_circle_raster_arc_t*} arc 圆弧(坐标相对缓冲区的左上角)。
+ * @param {color_t} color 颜色。
+ * @param {uint8_t*} data 缓冲区。
+ * @param {uint32_t} w 宽度。
+ * @param {uint32_t} h 高度。
+ * @param {uint32_t} line_length 每行的字节数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_raster_rgba_over(const slider_circle_raster_arc_t* arc, color_t color,
+                                     uint8_t* data, uint32_t w, uint32_t h,
+                                     uint32_t line_length);
+
+END_C_DECLS
+
+#endif /*TK_SLIDER_CIRCLE_RASTER_H*/
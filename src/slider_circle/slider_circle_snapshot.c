@@ -0,0 +1,327 @@
+﻿/**
+ * File:   slider_circle_snapshot.c
+ * Author: AWTK Develop Team
+ * Brief:  环形slider状态的二进制快照。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-13 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "slider_circle.h"
+#include "slider_circle_pool.h"
+#include "slider_circle_snapshot.h"
+
+static const char* s_line_caps[] = {NULL, VGCANVAS_LINE_CAP_ROUND, VGCANVAS_LINE_CAP_SQUARE,
+                                    VGCANVAS_LINE_CAP_BUTT};
+
+typedef struct _snapshot_ctx_t {
+  wbuffer_t* wb;
+  wbuffer_t strings_wb;
+  const slider_circle_snapshot_record_t* records;
+  const char* strings;
+  uint32_t strings_size;
+  uint32_t count;
+  uint32_t index;
+  ret_t ret;
+} snapshot_ctx_t;
+
+static uint32_t slider_circle_snapshot_hash(const char* name) {
+  uint32_t hash = 2166136261u;
+
+  if (name == NULL) {
+    return 0;
+  }
+
+  while (*name) {
+    hash ^= (uint8_t)(*name++);
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
+static bool_t slider_circle_snapshot_is_slider_circle(widget_t* widget) {
+  return widget != NULL && widget_is_instance_of(widget, TK_REF_VTABLE(slider_circle));
+}
+
+/*把字符串追加到字符串表中，返回偏移(空字符串为0)*/
+static ret_t slider_circle_snapshot_write_str(wbuffer_t* strings, const char* str,
+                                             uint32_t* offset) {
+  *offset = 0;
+  if (str == NULL || *str == '\0') {
+    return RET_OK;
+  }
+
+  *offset = strings->cursor;
+  return wbuffer_write_binary(strings, str, strlen(str) + 1);
+}
+
+/*字符串表以0结尾时，任何不越界的偏移都是以0结尾的字符串*/
+static const char* slider_circle_snapshot_read_str(const char* strings, uint32_t size,
+                                                   uint32_t offset) {
+  if (strings == NULL || size == 0 || strings[size - 1] != '\0' || offset >= size) {
+    return NULL;
+  }
+
+  return strings + offset;
+}
+
+ret_t slider_circle_snapshot_save(widget_t* widget, slider_circle_snapshot_record_t* record) {
+  return slider_circle_snapshot_save_ex(widget, record, NULL);
+}
+
+ret_t slider_circle_snapshot_save_ex(widget_t* widget, slider_circle_snapshot_record_t* record,
+                                     wbuffer_t* strings) {
+  uint32_t i = 0;
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL && record != NULL, RET_BAD_PARAMS);
+
+  /*绑定了共享的值时，保存最新的值*/
+  slider_circle_sync_source(widget);
+  memset(record, 0x00, sizeof(*record));
+  record->value = slider_circle->value;
+  record->min = slider_circle->min;
+  record->max = slider_circle->max;
+  record->step = slider_circle->step;
+  record->name_hash = slider_circle_snapshot_hash(widget->name);
+  record->start_angle = slider_circle->start_angle;
+  record->end_angle = slider_circle->end_angle;
+  record->fg_line_width = slider_circle->fg_line_width;
+  record->bg_line_width = slider_circle->bg_line_width;
+  record->header_size = slider_circle->header_size;
+  record->dragger_size = slider_circle->dragger_size;
+  record->major_ticks = slider_circle->major_ticks;
+  record->tick_min_gap = slider_circle->tick_min_gap;
+  record->peak_decay = slider_circle->peak_decay;
+  record->render_backend = slider_circle->render_backend;
+
+  if (slider_circle->counter_clock_wise) {
+    record->flags |= SLIDER_CIRCLE_SNAPSHOT_FLAG_CCW;
+  }
+  if (slider_circle->show_text) {
+    record->flags |= SLIDER_CIRCLE_SNAPSHOT_FLAG_SHOW_TEXT;
+  }
+  if (slider_circle->show_ticks) {
+    record->flags |= SLIDER_CIRCLE_SNAPSHOT_FLAG_SHOW_TICKS;
+  }
+  if (slider_circle->track_dither) {
+    record->flags |= SLIDER_CIRCLE_SNAPSHOT_FLAG_TRACK_DITHER;
+  }
+  if (slider_circle->peak_hold) {
+    record->flags |= SLIDER_CIRCLE_SNAPSHOT_FLAG_PEAK_HOLD;
+  }
+
+  for (i = 1; i < ARRAY_SIZE(s_line_caps); i++) {
+    if (tk_str_eq(slider_circle->line_cap, s_line_caps[i])) {
+      record->line_cap = i;
+      break;
+    }
+  }
+
+  if (slider_circle->format != NULL) {
+    tk_strncpy(record->format, slider_circle->format, SLIDER_CIRCLE_SNAPSHOT_FORMAT_LEN);
+  }
+
+  if (strings != NULL) {
+    ret_t ret = slider_circle_snapshot_write_str(strings, slider_circle->zones, &(record->zones));
+
+    if (ret == RET_OK) {
+      ret = slider_circle_snapshot_write_str(strings, slider_circle->mapping, &(record->mapping));
+    }
+    return_value_if_fail(ret == RET_OK, RET_OOM);
+    record->flags |= SLIDER_CIRCLE_SNAPSHOT_FLAG_STRINGS;
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_snapshot_restore(widget_t* widget,
+                                     const slider_circle_snapshot_record_t* record) {
+  return slider_circle_snapshot_restore_ex(widget, record, NULL, 0);
+}
+
+ret_t slider_circle_snapshot_restore_ex(widget_t* widget,
+                                        const slider_circle_snapshot_record_t* record,
+                                        const char* strings, uint32_t strings_size) {
+  const char* line_cap = NULL;
+  char format[SLIDER_CIRCLE_SNAPSHOT_FORMAT_LEN + 1];
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL && record != NULL, RET_BAD_PARAMS);
+
+  /*直接写字段，不经过set_prop和值变化事件，最后只刷新一次*/
+  slider_circle->value = record->value;
+  slider_circle->min = record->min;
+  slider_circle->max = record->max;
+  slider_circle->step = record->step;
+  slider_circle->start_angle = record->start_angle;
+  slider_circle->end_angle = record->end_angle;
+  slider_circle->fg_line_width = record->fg_line_width;
+  slider_circle->bg_line_width = record->bg_line_width;
+  slider_circle->header_size = record->header_size;
+  slider_circle->dragger_size = record->dragger_size;
+  slider_circle->major_ticks = record->major_ticks;
+  slider_circle->tick_min_gap = record->tick_min_gap;
+  slider_circle->counter_clock_wise = (record->flags & SLIDER_CIRCLE_SNAPSHOT_FLAG_CCW) != 0;
+  slider_circle->show_text = (record->flags & SLIDER_CIRCLE_SNAPSHOT_FLAG_SHOW_TEXT) != 0;
+  slider_circle->show_ticks = (record->flags & SLIDER_CIRCLE_SNAPSHOT_FLAG_SHOW_TICKS) != 0;
+  slider_circle->track_dither = (record->flags & SLIDER_CIRCLE_SNAPSHOT_FLAG_TRACK_DITHER) != 0;
+  slider_circle->peak_hold = (record->flags & SLIDER_CIRCLE_SNAPSHOT_FLAG_PEAK_HOLD) != 0;
+  slider_circle->peak_decay = record->peak_decay;
+  if (record->render_backend <= SLIDER_CIRCLE_BACKEND_SPRITE &&
+      slider_circle->render_backend != record->render_backend) {
+    slider_circle->render_backend = (slider_circle_backend_t)(record->render_backend);
+    slider_circle->backend_lcd = NULL;
+  }
+
+  if (record->flags & SLIDER_CIRCLE_SNAPSHOT_FLAG_STRINGS) {
+    const char* zones = slider_circle_snapshot_read_str(strings, strings_size, record->zones);
+    const char* mapping = slider_circle_snapshot_read_str(strings, strings_size, record->mapping);
+
+    if (zones != NULL) {
+      /*区间没有变化时不重新解析*/
+      slider_circle_set_zones(widget, zones);
+    }
+    if (mapping != NULL) {
+      /*映射表在后面和min/max一起重新生成*/
+      if (*mapping == '\0') {
+        TKMEM_FREE(slider_circle->mapping);
+      } else if (!tk_str_eq(slider_circle->mapping, mapping)) {
+        slider_circle->mapping = tk_str_copy(slider_circle->mapping, mapping);
+      }
+    }
+  }
+
+  if (record->line_cap < ARRAY_SIZE(s_line_caps)) {
+    line_cap = s_line_caps[record->line_cap];
+  }
+  slider_circle->line_cap = slider_circle_pool_str_copy(slider_circle->line_cap, line_cap);
+
+  /*记录中的format不一定以0结尾(来自flash时)，最多取SLIDER_CIRCLE_SNAPSHOT_FORMAT_LEN个字符*/
+  tk_strncpy(format, record->format, SLIDER_CIRCLE_SNAPSHOT_FORMAT_LEN);
+  slider_circle->format = slider_circle_pool_str_copy(slider_circle->format, format);
+  slider_circle_update_paint(widget);
+  /*记录可能来自旧的或者损坏的快照，值按恢复的min/max/step规整*/
+  slider_circle_update_mapping(widget);
+
+  return widget_invalidate(widget, NULL);
+}
+
+static ret_t slider_circle_snapshot_on_save(void* ctx, const void* data) {
+  widget_t* widget = WIDGET(data);
+  snapshot_ctx_t* info = (snapshot_ctx_t*)ctx;
+
+  if (slider_circle_snapshot_is_slider_circle(widget)) {
+    slider_circle_snapshot_record_t record;
+
+    if (slider_circle_snapshot_save_ex(widget, &record, &(info->strings_wb)) != RET_OK ||
+        wbuffer_write_binary(info->wb, &record, sizeof(record)) != RET_OK) {
+      info->ret = RET_OOM;
+      return RET_STOP;
+    }
+    info->count++;
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_snapshot_save_tree(widget_t* root, wbuffer_t* wb) {
+  snapshot_ctx_t ctx;
+  uint32_t start = 0;
+  slider_circle_snapshot_header_t header;
+  return_value_if_fail(root != NULL && wb != NULL, RET_BAD_PARAMS);
+
+  memset(&ctx, 0x00, sizeof(ctx));
+  memset(&header, 0x00, sizeof(header));
+  ctx.wb = wb;
+  ctx.ret = RET_OK;
+
+  start = wb->cursor;
+  return_value_if_fail(wbuffer_write_binary(wb, &header, sizeof(header)) == RET_OK, RET_OOM);
+
+  /*字符串表先写到单独的缓冲区中，记录写完后追加到后面*/
+  wbuffer_init_extendable(&(ctx.strings_wb));
+  if (wbuffer_write_binary(&(ctx.strings_wb), "", 1) == RET_OK) {
+    widget_foreach(root, slider_circle_snapshot_on_save, &ctx);
+  } else {
+    ctx.ret = RET_OOM;
+  }
+  if (ctx.ret == RET_OK &&
+      wbuffer_write_binary(wb, ctx.strings_wb.data, ctx.strings_wb.cursor) != RET_OK) {
+    ctx.ret = RET_OOM;
+  }
+  header.strings_size = ctx.strings_wb.cursor;
+  wbuffer_deinit(&(ctx.strings_wb));
+  return_value_if_fail(ctx.ret == RET_OK, ctx.ret);
+
+  /*全部写完后再回填文件头*/
+  header.magic = SLIDER_CIRCLE_SNAPSHOT_MAGIC;
+  header.version = SLIDER_CIRCLE_SNAPSHOT_VERSION;
+  header.record_size = sizeof(slider_circle_snapshot_record_t);
+  header.count = ctx.count;
+  memcpy(wb->data + start, &header, sizeof(header));
+
+  return RET_OK;
+}
+
+static ret_t slider_circle_snapshot_on_restore(void* ctx, const void* data) {
+  widget_t* widget = WIDGET(data);
+  snapshot_ctx_t* info = (snapshot_ctx_t*)ctx;
+
+  if (slider_circle_snapshot_is_slider_circle(widget)) {
+    const slider_circle_snapshot_record_t* record = NULL;
+
+    if (info->index >= info->count) {
+      info->ret = RET_NOT_FOUND;
+      return RET_STOP;
+    }
+
+    record = info->records + info->index++;
+    if (record->name_hash == slider_circle_snapshot_hash(widget->name)) {
+      slider_circle_snapshot_restore_ex(widget, record, info->strings, info->strings_size);
+    } else {
+      info->ret = RET_NOT_FOUND;
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_snapshot_restore_tree(widget_t* root, const void* data, uint32_t size) {
+  snapshot_ctx_t ctx;
+  const slider_circle_snapshot_header_t* header = (const slider_circle_snapshot_header_t*)data;
+  return_value_if_fail(root != NULL && data != NULL && size >= sizeof(*header), RET_BAD_PARAMS);
+  return_value_if_fail(header->magic == SLIDER_CIRCLE_SNAPSHOT_MAGIC, RET_BAD_PARAMS);
+  return_value_if_fail(header->version == SLIDER_CIRCLE_SNAPSHOT_VERSION, RET_BAD_PARAMS);
+  return_value_if_fail(header->record_size == sizeof(slider_circle_snapshot_record_t),
+                       RET_BAD_PARAMS);
+  /*count来自外部数据，用除法检查，避免count * record_size溢出*/
+  return_value_if_fail(header->count <= (size - sizeof(*header)) / header->record_size,
+                       RET_BAD_PARAMS);
+  return_value_if_fail(header->strings_size <=
+                           size - sizeof(*header) - header->count * header->record_size,
+                       RET_BAD_PARAMS);
+
+  memset(&ctx, 0x00, sizeof(ctx));
+  ctx.ret = RET_OK;
+  ctx.count = header->count;
+  ctx.records = (const slider_circle_snapshot_record_t*)(header + 1);
+  ctx.strings = (const char*)(ctx.records + header->count);
+  ctx.strings_size = header->strings_size;
+  widget_foreach(root, slider_circle_snapshot_on_restore, &ctx);
+
+  return ctx.ret;
+}
@@ -0,0 +1,163 @@
+﻿/**
+ * File:   slider_circle_snapshot.h
+ * Author: AWTK Develop Team
+ * Brief:  环形slider状态的二进制快照。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-13 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SLIDER_CIRCLE_SNAPSHOT_H
+#define TK_SLIDER_CIRCLE_SNAPSHOT_H
+
+#include "tkc/buffer.h"
+#include "base/widget.h"
+
+BEGIN_C_DECLS
+
+#define SLIDER_CIRCLE_SNAPSHOT_MAGIC 0x53534353 /*SCSS*/
+/*记录或者文件的格式变化时增加版本号，旧版本的快照不能恢复*/
+#define SLIDER_CIRCLE_SNAPSHOT_VERSION 2
+#define SLIDER_CIRCLE_SNAPSHOT_FORMAT_LEN 15
+
+#define SLIDER_CIRCLE_SNAPSHOT_FLAG_CCW 0x01
+#define SLIDER_CIRCLE_SNAPSHOT_FLAG_SHOW_TEXT 0x02
+#define SLIDER_CIRCLE_SNAPSHOT_FLAG_SHOW_TICKS 0x04
+#define SLIDER_CIRCLE_SNAPSHOT_FLAG_TRACK_DITHER 0x08
+#define SLIDER_CIRCLE_SNAPSHOT_FLAG_PEAK_HOLD 0x10
+/*记录中的zones和mapping是字符串表中的偏移(没有字符串表时不保存和恢复zones和mapping)*/
+#define SLIDER_CIRCLE_SNAPSHOT_FLAG_STRINGS 0x20
+
+/**
+ * @class slider_circle_snapshot_header_t
+ * 快照文件头。
+ *
+ * 快照由文件头、count个定长的记录和strings_size字节的字符串表组成，
+ * 字段按本机字节序存放并且自然对齐，可以直接映射到内存中使用。
+ * 长度不定的zones和mapping放在字符串表中，字符串表的第一个字节为0(偏移为0表示空字符串)。
+ */
+typedef struct _slider_circle_snapshot_header_t {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t record_size;
+  uint32_t count;
+  uint32_t strings_size;
+} slider_circle_snapshot_header_t;
+
+/**
+ * @class slider_circle_snapshot_record_t
+ * 一个slider_circle的状态。
+ */
+typedef struct _slider_circle_snapshot_record_t {
+  double value;
+  double min;
+  double max;
+  double step;
+  /*控件名的hash，恢复时用来检查控件是否对应*/
+  uint32_t name_hash;
+  int16_t start_angle;
+  int16_t end_angle;
+  uint8_t fg_line_width;
+  uint8_t bg_line_width;
+  uint8_t header_size;
+  uint8_t dragger_size;
+  uint8_t flags;
+  uint8_t major_ticks;
+  uint8_t tick_min_gap;
+  /*0:缺省 1:round 2:square 3:butt*/
+  uint8_t line_cap;
+  char format[SLIDER_CIRCLE_SNAPSHOT_FORMAT_LEN + 1];
+  /*zones和mapping在字符串表中的偏移*/
+  uint32_t zones;
+  uint32_t mapping;
+  float peak_decay;
+  /*slider_circle_backend_t*/
+  uint8_t render_backend;
+  uint8_t reserved[3];
+} slider_circle_snapshot_record_t;
+
+/**
+ * @method slider_circle_snapshot_save
+ * 保存一个slider_circle的状态。
+ * @param {widget_t*} widget slider_circle对象。
+ * @param {slider_circle_snapshot_record_t*} record 用于返回状态。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_snapshot_save(widget_t* widget, slider_circle_snapshot_record_t* record);
+
+/**
+ * @method slider_circle_snapshot_save_ex
+ * 保存一个slider_circle的状态，zones和mapping追加到字符串表中。
+ * @param {widget_t*} widget slider_circle对象。
+ * @param {slider_circle_snapshot_record_t*} record 用于返回状态。
+ * @param {wbuffer_t*} strings 字符串表(第一个字节必须为0)，为NULL时不保存zones和mapping。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_snapshot_save_ex(widget_t* widget, slider_circle_snapshot_record_t* record,
+                                     wbuffer_t* strings);
+
+/**
+ * @method slider_circle_snapshot_restore
+ * 恢复一个slider_circle的状态(不分发值变化事件，只刷新一次)。
+ * @param {widget_t*} widget slider_circle对象。
+ * @param {const slider_circle_snapshot_record_t*} record 状态。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_snapshot_restore(widget_t* widget,
+                                     const slider_circle_snapshot_record_t* record);
+
+/**
+ * @method slider_circle_snapshot_restore_ex
+ * 恢复一个slider_circle的状态，zones和mapping从字符串表中读取(不分发值变化事件，只刷新一次)。
+ * > 字符串表无效或者偏移越界时不恢复zones和mapping。
+ * @param {widget_t*} widget slider_circle对象。
+ * @param {const slider_circle_snapshot_record_t*} record 状态。
+ * @param {const char*} strings 字符串表，为NULL时不恢复zones和mapping。
+ * @param {uint32_t} strings_size 字符串表的长度。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_snapshot_restore_ex(widget_t* widget,
+                                        const slider_circle_snapshot_record_t* record,
+                                        const char* strings, uint32_t strings_size);
+
+/**
+ * @method slider_circle_snapshot_save_tree
+ * 按深度优先的顺序保存root(包括root自己)下所有slider_circle的状态。
+ * @param {widget_t*} root 根控件。
+ * @param {wbuffer_t*} wb 用于输出快照(文件头+记录+字符串表)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_snapshot_save_tree(widget_t* root, wbuffer_t* wb);
+
+/**
+ * @method slider_circle_snapshot_restore_tree
+ * 按深度优先的顺序恢复root(包括root自己)下所有slider_circle的状态。
+ * > 名称和记录不一致的控件不会被恢复。
+ * @param {widget_t*} root 根控件。
+ * @param {const void*} data 快照数据(可以是直接映射到内存的flash)。
+ * @param {uint32_t} size 快照数据的长度。
+ *
+ * @return {ret_t} 全部恢复返回RET_OK，有控件没有对应的记录返回RET_NOT_FOUND，快照无效返回RET_BAD_PARAMS。
+ */
+ret_t slider_circle_snapshot_restore_tree(widget_t* root, const void* data, uint32_t size);
+
+END_C_DECLS
+
+#endif /*TK_SLIDER_CIRCLE_SNAPSHOT_H*/
@@ -0,0 +1,121 @@
+﻿/**
+ * File:   slider_circle_source.c
+ * Author: AWTK Develop Team
+ * Brief:  多个slider_circle共享的值。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "slider_circle.h"
+#include "slider_circle_source.h"
+
+static bool_t slider_circle_source_is_shown(widget_t* widget) {
+  widget_t* iter = widget;
+
+  /*控件自己、父控件或者窗口不可见时都看不到*/
+  while (iter != NULL) {
+    if (!iter->visible) {
+      return FALSE;
+    }
+    iter = iter->parent;
+  }
+
+  return TRUE;
+}
+
+static ret_t slider_circle_source_remove(slider_circle_source_t* source, widget_t* widget) {
+  uint32_t i = 0;
+
+  for (i = 0; i < source->widgets.size; i++) {
+    if (source->widgets.elms[i] == widget) {
+      return darray_remove_index(&(source->widgets), i);
+    }
+  }
+
+  return RET_NOT_FOUND;
+}
+
+slider_circle_source_t* slider_circle_source_create(void) {
+  slider_circle_source_t* source = TKMEM_ZALLOC(slider_circle_source_t);
+  return_value_if_fail(source != NULL, NULL);
+
+  darray_init(&(source->widgets), 4, NULL, NULL);
+
+  return source;
+}
+
+ret_t slider_circle_source_publish(slider_circle_source_t* source, double value) {
+  uint32_t i = 0;
+  return_value_if_fail(source != NULL, RET_BAD_PARAMS);
+
+  if (source->value == value && source->generation > 0) {
+    return RET_OK;
+  }
+
+  source->value = value;
+  source->generation++;
+
+  for (i = 0; i < source->widgets.size; i++) {
+    widget_t* widget = WIDGET(source->widgets.elms[i]);
+
+    if (slider_circle_source_is_shown(widget)) {
+      widget_invalidate(widget, NULL);
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_source_destroy(slider_circle_source_t* source) {
+  uint32_t i = 0;
+  return_value_if_fail(source != NULL, RET_BAD_PARAMS);
+
+  for (i = 0; i < source->widgets.size; i++) {
+    slider_circle_t* slider_circle = SLIDER_CIRCLE(source->widgets.elms[i]);
+
+    slider_circle_sync_source(WIDGET(slider_circle));
+    slider_circle->source = NULL;
+  }
+  darray_deinit(&(source->widgets));
+  TKMEM_FREE(source);
+
+  return RET_OK;
+}
+
+ret_t slider_circle_bind_source(widget_t* widget, slider_circle_source_t* source) {
+  slider_circle_t* slider_circle = SLIDER_CIRCLE(widget);
+  return_value_if_fail(slider_circle != NULL, RET_BAD_PARAMS);
+
+  if (slider_circle->source == source) {
+    return RET_OK;
+  }
+
+  if (slider_circle->source != NULL) {
+    slider_circle_source_remove(slider_circle->source, widget);
+    slider_circle->source = NULL;
+  }
+
+  if (source != NULL) {
+    return_value_if_fail(darray_push(&(source->widgets), widget) == RET_OK, RET_OOM);
+    slider_circle->source = source;
+    slider_circle->source_generation = 0;
+
+    return widget_invalidate(widget, NULL);
+  }
+
+  return RET_OK;
+}
@@ -0,0 +1,106 @@
+﻿/**
+ * File:   slider_circle_source.h
+ * Author: AWTK Develop Team
+ * Brief:  多个slider_circle共享的值。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SLIDER_CIRCLE_SOURCE_H
+#define TK_SLIDER_CIRCLE_SOURCE_H
+
+#include "tkc/darray.h"
+#include "base/widget.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class slider_circle_source_t
+ * 多个slider_circle共享的值(如同一个过程值显示在总览、详情等多个界面上)。
+ *
+ * 发布新的值时只把绑定的控件标记为需要重绘，不分发任何事件，也不逐个调用slider_circle_set_value。
+ * 控件在绘制(或者读取value属性)时才从共享的值中取值(按自己的min/max/step处理)。
+ * 不可见(或者所在的窗口不可见)的控件不刷新，重新可见时窗口整体重绘，自然取到最新的值。
+ *
+ * ```c
+ * slider_circle_source_t* source = slider_circle_source_create();
+ * slider_circle_bind_source(widget_lookup(overview, "temp", TRUE), source);
+ * slider_circle_bind_source(widget_lookup(detail, "temp", TRUE), source);
+ * ...
+ * slider_circle_source_publish(source, 36.5);
+ * ```
+ *
+ * > 绑定后控件的值跟随共享的值，不会触发值变化的事件。只能在GUI线程中使用。
+ */
+typedef struct _slider_circle_source_t {
+  /**
+   * @property {double} value
+   * @annotation ["readable"]
+   * 当前的值。
+   */
+  double value;
+  /**
+   * @property {uint32_t} generation
+   * @annotation ["readable"]
+   * 每发布一次加1，控件用它判断自己的值是否是最新的。
+   */
+  uint32_t generation;
+
+  /*private*/
+  darray_t widgets;
+} slider_circle_source_t;
+
+/**
+ * @method slider_circle_source_create
+ * 创建共享的值。
+ * @annotation ["constructor"]
+ *
+ * @return {slider_circle_source_t*} 返回共享的值。
+ */
+slider_circle_source_t* slider_circle_source_create(void);
+
+/**
+ * @method slider_circle_source_publish
+ * 发布新的值(值没有变化时什么也不做)。
+ * @param {slider_circle_source_t*} source 共享的值。
+ * @param {double} value 新的值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_source_publish(slider_circle_source_t* source, double value);
+
+/**
+ * @method slider_circle_source_destroy
+ * 销毁共享的值(所有绑定的控件自动解除绑定，保留最后的值)。
+ * @param {slider_circle_source_t*} source 共享的值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_source_destroy(slider_circle_source_t* source);
+
+/**
+ * @method slider_circle_bind_source
+ * 把slider_circle(或者gauge_circle)绑定到共享的值(控件销毁时自动解除绑定)。
+ * @param {widget_t*} widget slider_circle对象。
+ * @param {slider_circle_source_t*} source 共享的值(为NULL时解除绑定)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_bind_source(widget_t* widget, slider_circle_source_t* source);
+
+END_C_DECLS
+
+#endif /*TK_SLIDER_CIRCLE_SOURCE_H*/
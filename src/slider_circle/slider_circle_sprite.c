@@ -0,0 +1,198 @@
+﻿/**
+ * File:   slider_circle_sprite.c
+ * Author: AWTK Develop Team
+ * Brief:  拖动块(实心圆)的共享位图缓存。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/utils.h"
+#include "slider_circle_raster.h"
+#include "slider_circle_sprite.h"
+
+#define SPRITE_PHASES_NR (SLIDER_CIRCLE_SPRITE_PHASES * SLIDER_CIRCLE_SPRITE_PHASES)
+
+typedef struct _sprite_entry_t {
+  uint32_t r;
+  color_t color;
+  uint32_t last_used;
+  /*按需光栅化，没有用到的相位为NULL*/
+  bitmap_t* phases[SPRITE_PHASES_NR];
+} sprite_entry_t;
+
+typedef struct _slider_circle_sprite_cache_t {
+  uint32_t clock;
+  uint32_t count;
+  sprite_entry_t entries[SLIDER_CIRCLE_SPRITE_CACHE_MAX];
+} slider_circle_sprite_cache_t;
+
+static slider_circle_sprite_cache_t s_sprites;
+
+static void sprite_entry_reset(sprite_entry_t* entry) {
+  uint32_t i = 0;
+
+  for (i = 0; i < SPRITE_PHASES_NR; i++) {
+    if (entry->phases[i] != NULL) {
+      bitmap_destroy(entry->phases[i]);
+    }
+  }
+  memset(entry, 0x00, sizeof(*entry));
+}
+
+static sprite_entry_t* sprite_entry_find(uint32_t r, color_t color) {
+  uint32_t i = 0;
+  sprite_entry_t* lru = s_sprites.entries;
+
+  for (i = 0; i < s_sprites.count; i++) {
+    sprite_entry_t* iter = s_sprites.entries + i;
+    if (iter->r == r && iter->color.color == color.color) {
+      return iter;
+    }
+    if (iter->last_used < lru->last_used) {
+      lru = iter;
+    }
+  }
+
+  if (s_sprites.count < SLIDER_CIRCLE_SPRITE_CACHE_MAX) {
+    lru = s_sprites.entries + s_sprites.count;
+    s_sprites.count++;
+  } else {
+    sprite_entry_reset(lru);
+  }
+  lru->r = r;
+  lru->color = color;
+
+  return lru;
+}
+
+static bitmap_t* sprite_rasterize(uint32_t r, color_t color, uint32_t px, uint32_t py) {
+  uint8_t* data = NULL;
+  uint32_t size = 2 * r + 3;
+  slider_circle_raster_arc_t arc;
+  bitmap_t* bitmap = bitmap_create_ex(size, size, 0, BITMAP_FMT_RGBA8888);
+  return_value_if_fail(bitmap != NULL, NULL);
+
+  data = bitmap_lock_buffer_for_write(bitmap);
+  if (data == NULL) {
+    bitmap_destroy(bitmap);
+    return NULL;
+  }
+
+  /*留出一个像素的边给抗锯齿，再按相位把中心往右下偏移*/
+  memset(&arc, 0x00, sizeof(arc));
+  arc.cx = r + 1 + (float_t)px / SLIDER_CIRCLE_SPRITE_PHASES;
+  arc.cy = r + 1 + (float_t)py / SLIDER_CIRCLE_SPRITE_PHASES;
+  arc.r = r;
+  slider_circle_raster_rgba(&arc, color, data, size, size, bitmap_get_line_length(bitmap));
+  bitmap_unlock_buffer(bitmap);
+  bitmap->flags |= BITMAP_FLAG_CHANGED;
+
+  return bitmap;
+}
+
+static int32_t sprite_split(float_t v, uint32_t* phase) {
+  int32_t i = (int32_t)floor(v);
+  int32_t p = tk_roundi((v - i) * SLIDER_CIRCLE_SPRITE_PHASES);
+
+  if (p >= SLIDER_CIRCLE_SPRITE_PHASES) {
+    i++;
+    p = 0;
+  }
+  *phase = p;
+
+  return i;
+}
+
+bitmap_t* slider_circle_sprite_get(uint32_t r, color_t color, float_t x, float_t y,
+                                   point_t* pos) {
+  uint32_t px = 0;
+  uint32_t py = 0;
+  int32_t ix = 0;
+  int32_t iy = 0;
+  bitmap_t** bitmap = NULL;
+  sprite_entry_t* entry = NULL;
+  return_value_if_fail(pos != NULL, NULL);
+
+  if (r == 0 || r > SLIDER_CIRCLE_SPRITE_MAX_SIZE || color.rgba.a == 0) {
+    return NULL;
+  }
+
+  ix = sprite_split(x, &px);
+  iy = sprite_split(y, &py);
+  entry = sprite_entry_find(r, color);
+  entry->last_used = ++s_sprites.clock;
+
+  bitmap = entry->phases + py * SLIDER_CIRCLE_SPRITE_PHASES + px;
+  if (*bitmap == NULL) {
+    *bitmap = sprite_rasterize(r, color, px, py);
+    return_value_if_fail(*bitmap != NULL, NULL);
+  }
+
+  pos->x = ix - (int32_t)r - 1;
+  pos->y = iy - (int32_t)r - 1;
+
+  return *bitmap;
+}
+
+ret_t slider_circle_sprite_prepare(uint32_t r, color_t color) {
+  uint32_t i = 0;
+  sprite_entry_t* entry = NULL;
+
+  if (r == 0 || r > SLIDER_CIRCLE_SPRITE_MAX_SIZE || color.rgba.a == 0) {
+    return RET_FAIL;
+  }
+
+  entry = sprite_entry_find(r, color);
+  entry->last_used = ++s_sprites.clock;
+  for (i = 0; i < SPRITE_PHASES_NR; i++) {
+    if (entry->phases[i] == NULL) {
+      entry->phases[i] = sprite_rasterize(r, color, i % SLIDER_CIRCLE_SPRITE_PHASES,
+                                          i / SLIDER_CIRCLE_SPRITE_PHASES);
+      return_value_if_fail(entry->phases[i] != NULL, RET_OOM);
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_sprite_draw(canvas_t* c, uint32_t r, color_t color, float_t x, float_t y) {
+  point_t pos = {0, 0};
+  bitmap_t* bitmap = NULL;
+  return_value_if_fail(c != NULL, RET_BAD_PARAMS);
+
+  bitmap = slider_circle_sprite_get(r, color, x, y, &pos);
+  if (bitmap == NULL) {
+    return RET_FAIL;
+  }
+
+  return canvas_draw_image_at(c, bitmap, pos.x, pos.y);
+}
+
+uint32_t slider_circle_sprite_count(void) {
+  return s_sprites.count;
+}
+
+ret_t slider_circle_sprite_clear(void) {
+  uint32_t i = 0;
+
+  for (i = 0; i < s_sprites.count; i++) {
+    sprite_entry_reset(s_sprites.entries + i);
+  }
+  s_sprites.count = 0;
+  s_sprites.clock = 0;
+
+  return RET_OK;
+}
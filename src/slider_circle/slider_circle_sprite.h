@@ -0,0 +1,112 @@
+﻿/**
+ * File:   slider_circle_sprite.h
+ * Author: AWTK Develop Team
+ * Brief:  拖动块(实心圆)的共享位图缓存。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SLIDER_CIRCLE_SPRITE_H
+#define TK_SLIDER_CIRCLE_SPRITE_H
+
+#include "base/canvas.h"
+#include "base/bitmap.h"
+
+BEGIN_C_DECLS
+
+/*每个方向上的亚像素相位数(4表示1/4像素)*/
+#ifndef SLIDER_CIRCLE_SPRITE_PHASES
+#define SLIDER_CIRCLE_SPRITE_PHASES 4
+#endif /*SLIDER_CIRCLE_SPRITE_PHASES*/
+
+/*缓存的外观(半径+颜色)的最大个数，超出时淘汰最久没有使用的*/
+#ifndef SLIDER_CIRCLE_SPRITE_CACHE_MAX
+#define SLIDER_CIRCLE_SPRITE_CACHE_MAX 4
+#endif /*SLIDER_CIRCLE_SPRITE_CACHE_MAX*/
+
+/*可以缓存的最大半径(更大的拖动块仍然用路径填充)*/
+#ifndef SLIDER_CIRCLE_SPRITE_MAX_SIZE
+#define SLIDER_CIRCLE_SPRITE_MAX_SIZE 32
+#endif /*SLIDER_CIRCLE_SPRITE_MAX_SIZE*/
+
+/**
+ * @class slider_circle_sprite_t
+ * @annotation ["fake"]
+ * 拖动块的共享位图缓存。
+ *
+ * 拖动块是一个实心圆，外观只由半径(header_size)和颜色(随状态变化的dragger_color)决定。
+ * 第一次用到时按亚像素相位光栅化成RGBA8888的小位图，之后每次绘制只是一次贴图。
+ * 外观相同的控件共用同一组位图。
+ *
+ * > 只能在GUI线程中使用。
+ */
+
+/**
+ * @method slider_circle_sprite_get
+ * 获取中心在(x, y)的拖动块的位图(没有时光栅化并放入缓存)。
+ * @param {uint32_t} r 半径。
+ * @param {color_t} color 颜色。
+ * @param {float_t} x 中心的x坐标。
+ * @param {float_t} y 中心的y坐标。
+ * @param {point_t*} pos 返回位图左上角的坐标。
+ *
+ * @return {bitmap_t*} 返回位图(由缓存管理，不能释放)，失败返回NULL。
+ */
+bitmap_t* slider_circle_sprite_get(uint32_t r, color_t color, float_t x, float_t y,
+                                   point_t* pos);
+
+/**
+ * @method slider_circle_sprite_prepare
+ * 预先生成一种外观所有相位的位图(slider_circle_warmup时调用，绘制时不再光栅化)。
+ * @param {uint32_t} r 半径。
+ * @param {color_t} color 颜色。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败(该外观不缓存)。
+ */
+ret_t slider_circle_sprite_prepare(uint32_t r, color_t color);
+
+/**
+ * @method slider_circle_sprite_draw
+ * 用缓存的位图绘制中心在(x, y)的拖动块。
+ * @param {canvas_t*} c 画布对象。
+ * @param {uint32_t} r 半径。
+ * @param {color_t} color 颜色。
+ * @param {float_t} x 中心的x坐标(相对控件)。
+ * @param {float_t} y 中心的y坐标(相对控件)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败(调用者应改用路径填充)。
+ */
+ret_t slider_circle_sprite_draw(canvas_t* c, uint32_t r, color_t color, float_t x, float_t y);
+
+/**
+ * @method slider_circle_sprite_count
+ * 获取缓存中外观的个数。
+ *
+ * @return {uint32_t} 返回外观的个数。
+ */
+uint32_t slider_circle_sprite_count(void);
+
+/**
+ * @method slider_circle_sprite_clear
+ * 释放缓存的全部位图(退出前或者内存紧张时调用)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_sprite_clear(void);
+
+END_C_DECLS
+
+#endif /*TK_SLIDER_CIRCLE_SPRITE_H*/
@@ -0,0 +1,455 @@
+﻿/**
+ * File:   slider_circle_ticks.c
+ * Author: AWTK Develop Team
+ * Brief:  环形slider的刻度和刻度标签缓存。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-13 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "slider_circle_ticks.h"
+#include "slider_circle_mapping.h"
+
+#define SLIDER_CIRCLE_TICK_MARGIN 2
+#define SLIDER_CIRCLE_TICK_MINOR_LEN 3
+#define SLIDER_CIRCLE_TICK_MAJOR_LEN 6
+#define SLIDER_CIRCLE_TICK_LABEL_GAP 2
+
+#ifndef SLIDER_CIRCLE_WITHOUT_TEXT
+ret_t slider_circle_format_value(char* buff, uint32_t size, const char* format, double value) {
+  const char* p = NULL;
+  const char* len = NULL;
+  uint32_t len_nr = 0;
+  return_value_if_fail(buff != NULL && size > 0, RET_BAD_PARAMS);
+
+  if (format == NULL) {
+    format = "%d";
+  }
+
+  /*找到第一个转换符，整数类型的格式需要传入整数*/
+  p = strchr(format, '%');
+  while (p != NULL && p[1] == '%') {
+    p = strchr(p + 2, '%');
+  }
+
+  if (p != NULL) {
+    for (p++; *p && strchr("-+ #0123456789.", *p) != NULL; p++) {
+    }
+    for (len = p; *p && strchr("hlLjzt", *p) != NULL; p++) {
+    }
+    len_nr = p - len;
+  }
+
+  /*传入的参数类型必须与长度修饰符一致，否则是未定义的行为*/
+  buff[0] = '\0';
+  if (p != NULL && *p && strchr("diouxXc", *p) != NULL) {
+    if (len_nr == 0 || (len_nr == 1 && *len == 'h') || (len_nr == 2 && strncmp(len, "hh", 2) == 0)) {
+      tk_snprintf(buff, size, format, tk_roundi(value));
+    } else if (len_nr == 1 && *len == 'l' && *p != 'c') {
+      tk_snprintf(buff, size, format, (long)floor(value + 0.5));
+    } else if (len_nr == 2 && strncmp(len, "ll", 2) == 0 && *p != 'c') {
+      tk_snprintf(buff, size, format, (long long)floor(value + 0.5));
+    } else {
+      return RET_BAD_PARAMS;
+    }
+  } else if (p != NULL && *p && len_nr > 0) {
+    if (len_nr == 1 && *len == 'l') {
+      tk_snprintf(buff, size, format, value);
+    } else if (len_nr == 1 && *len == 'L') {
+      tk_snprintf(buff, size, format, (long double)value);
+    } else {
+      return RET_BAD_PARAMS;
+    }
+  } else {
+    tk_snprintf(buff, size, format, value);
+  }
+
+  return RET_OK;
+}
+#endif /*SLIDER_CIRCLE_WITHOUT_TEXT*/
+
+#ifndef SLIDER_CIRCLE_WITHOUT_TICKS
+/*返回1,2,5,10,20,50...中使间距不小于min_gap的最小倍数*/
+static uint32_t slider_circle_ticks_stride(double gap, double min_gap) {
+  uint32_t base = 1;
+
+  if (gap <= 0) {
+    return 0;
+  }
+
+  while (base < 100000) {
+    if (gap * base >= min_gap) {
+      return base;
+    } else if (gap * base * 2 >= min_gap) {
+      return base * 2;
+    } else if (gap * base * 5 >= min_gap) {
+      return base * 5;
+    }
+    base *= 10;
+  }
+
+  return 0;
+}
+
+static ret_t slider_circle_ticks_ensure_capacity(slider_circle_ticks_t* ticks) {
+  if (ticks->lines == NULL) {
+    ticks->lines = TKMEM_ZALLOCN(pointf_t, SLIDER_CIRCLE_TICKS_MAX_NR * 2);
+    return_value_if_fail(ticks->lines != NULL, RET_OOM);
+  }
+
+  if (ticks->labels == NULL) {
+    ticks->labels = TKMEM_ZALLOCN(slider_circle_tick_label_t, SLIDER_CIRCLE_TICKS_MAX_NR);
+    return_value_if_fail(ticks->labels != NULL, RET_OOM);
+  }
+
+  return RET_OK;
+}
+
+static void slider_circle_ticks_add_line(slider_circle_ticks_t* ticks, uint32_t index, double cx,
+                                         double cy, double r, double len, double angle) {
+  double c = cos(angle);
+  double s = sin(angle);
+  pointf_t* p = ticks->lines + index * 2;
+
+  p[0].x = cx + r * c;
+  p[0].y = cy + r * s;
+  p[1].x = cx + (r - len) * c;
+  p[1].y = cy + (r - len) * s;
+}
+
+static double slider_circle_ticks_angle(const slider_circle_ticks_params_t* p,
+                                        const slider_circle_mapping_t* map, double v) {
+  return slider_circle_mapping_to_angle(map, v, p->min, p->max, p->start_angle, p->end_angle,
+                                        p->counter_clock_wise);
+}
+
+static bool_t slider_circle_ticks_in_range(const slider_circle_ticks_params_t* p, double v,
+                                           uint32_t i, bool_t full_circle) {
+  double epsilon = p->step * 0.001;
+
+  if (v > p->max + epsilon) {
+    return FALSE;
+  }
+
+  /*整圆时最后一个刻度和第一个刻度重合*/
+  if (full_circle && i > 0 && v >= p->max - epsilon) {
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+#ifndef SLIDER_CIRCLE_WITHOUT_TEXT
+/*主刻度的标签，先测量最宽的标签，再根据间距抽稀*/
+static ret_t slider_circle_ticks_layout_labels(slider_circle_ticks_t* ticks, canvas_t* c,
+                                               const slider_circle_mapping_t* map, double r,
+                                               double major_gap, uint32_t major_units) {
+  uint32_t i = 0;
+  uint32_t label_stride = 0;
+  double label_w = 0;
+  const slider_circle_ticks_params_t* p = &(ticks->params);
+  double cx = p->w / 2.0;
+  double cy = p->h / 2.0;
+
+  canvas_set_font(c, p->font_name, p->font_size);
+  for (i = 0; i < ticks->major_nr; i++) {
+    char text[TK_NUM_MAX_LEN + 1];
+    slider_circle_tick_label_t* label = ticks->labels + i;
+
+    slider_circle_format_value(text, sizeof(text), p->format, p->min + i * major_units * p->step);
+    tk_utf8_to_utf16(text, label->text, ARRAY_SIZE(label->text));
+    label->len = wcslen(label->text);
+    label->r.w = tk_roundi(canvas_measure_text(c, label->text, label->len));
+    label->r.h = p->font_size;
+    label_w = tk_max(label_w, label->r.w);
+  }
+
+  r = r - SLIDER_CIRCLE_TICK_LABEL_GAP;
+  label_stride = slider_circle_ticks_stride(major_gap, label_w + SLIDER_CIRCLE_TICK_LABEL_GAP);
+  if (label_stride == 0) {
+    return RET_OK;
+  }
+
+  for (i = 0; i < ticks->major_nr; i += label_stride) {
+    double angle = slider_circle_ticks_angle(p, map, p->min + i * major_units * p->step);
+    slider_circle_tick_label_t* label = ticks->labels + ticks->labels_nr;
+    double ca = cos(angle);
+    double sa = sin(angle);
+    double w = ticks->labels[i].r.w;
+    double h = ticks->labels[i].r.h;
+    /*标签框沿半径方向的半宽，保证标签不压到刻度上*/
+    double lr = r - (tk_abs(ca) * w + tk_abs(sa) * h) / 2;
+
+    if (lr <= 0) {
+      break;
+    }
+
+    if (label != ticks->labels + i) {
+      *label = ticks->labels[i];
+    }
+    label->r.x = tk_roundi(cx + lr * ca - w / 2);
+    label->r.y = tk_roundi(cy + lr * sa - h / 2);
+    ticks->labels_nr++;
+  }
+
+  return RET_OK;
+}
+#endif /*SLIDER_CIRCLE_WITHOUT_TEXT*/
+
+static bool_t slider_circle_ticks_str_eq(const char* a, const char* b) {
+  return a == b || tk_str_eq(a, b);
+}
+
+/*字符串按内容比较(调用者可能原地修改了字符串，指针相同不能说明内容相同)*/
+static bool_t slider_circle_ticks_params_equal(const slider_circle_ticks_params_t* a,
+                                               const slider_circle_ticks_params_t* b) {
+  slider_circle_ticks_params_t ta = *a;
+  slider_circle_ticks_params_t tb = *b;
+
+  ta.format = NULL;
+  ta.mapping = NULL;
+  ta.font_name = NULL;
+  tb.format = NULL;
+  tb.mapping = NULL;
+  tb.font_name = NULL;
+
+  return memcmp(&ta, &tb, sizeof(ta)) == 0 && slider_circle_ticks_str_eq(a->format, b->format) &&
+         slider_circle_ticks_str_eq(a->mapping, b->mapping) &&
+         slider_circle_ticks_str_eq(a->font_name, b->font_name);
+}
+
+static void slider_circle_ticks_own_strs(slider_circle_ticks_t* ticks, const char* format,
+                                         const char* mapping, const char* font_name) {
+  if (format == NULL) {
+    TKMEM_FREE(ticks->format);
+  } else if (format != ticks->format) {
+    ticks->format = tk_str_copy(ticks->format, format);
+  }
+  if (mapping == NULL) {
+    TKMEM_FREE(ticks->mapping);
+  } else if (mapping != ticks->mapping) {
+    ticks->mapping = tk_str_copy(ticks->mapping, mapping);
+  }
+  if (font_name == NULL) {
+    TKMEM_FREE(ticks->font_name);
+  } else if (font_name != ticks->font_name) {
+    ticks->font_name = tk_str_copy(ticks->font_name, font_name);
+  }
+  ticks->params.format = ticks->format;
+  ticks->params.mapping = ticks->mapping;
+  ticks->params.font_name = ticks->font_name;
+}
+
+ret_t slider_circle_ticks_init(slider_circle_ticks_t* ticks) {
+  return_value_if_fail(ticks != NULL, RET_BAD_PARAMS);
+
+  memset(ticks, 0x00, sizeof(*ticks));
+  ticks->dirty = TRUE;
+
+  return RET_OK;
+}
+
+ret_t slider_circle_ticks_update(slider_circle_ticks_t* ticks, canvas_t* c,
+                                 const slider_circle_ticks_params_t* params) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+  uint32_t major_n = 0;
+  uint32_t minor_stride = 0;
+  uint32_t major_units = 0;
+  double cx = 0;
+  double cy = 0;
+  double r = 0;
+  double range = 0;
+  double sweep = 0;
+  double min_gap = 0;
+  double unit_gap = 0;
+  bool_t full_circle = FALSE;
+  slider_circle_mapping_t mapping;
+  const slider_circle_mapping_t* map = NULL;
+  const slider_circle_ticks_params_t* p = params;
+  return_value_if_fail(ticks != NULL && c != NULL && params != NULL, RET_BAD_PARAMS);
+
+  if (!ticks->dirty && slider_circle_ticks_params_equal(&(ticks->params), params)) {
+    return RET_OK;
+  }
+
+  memcpy(&(ticks->params), params, sizeof(*params));
+  slider_circle_ticks_own_strs(ticks, params->format, params->mapping, params->font_name);
+  ticks->dirty = FALSE;
+  ticks->minor_nr = 0;
+  ticks->major_nr = 0;
+  ticks->labels_nr = 0;
+
+  cx = p->w / 2.0;
+  cy = p->h / 2.0;
+  r = tk_min(cx, cy) - p->line_width - SLIDER_CIRCLE_TICK_MARGIN;
+  range = p->max - p->min;
+  sweep = TK_D2R(tk_abs(p->end_angle - p->start_angle));
+  full_circle = tk_abs(p->end_angle - p->start_angle) >= 360;
+
+  if (range <= 0 || p->step <= 0 || sweep <= 0 || r <= SLIDER_CIRCLE_TICK_MAJOR_LEN) {
+    return RET_OK;
+  }
+  return_value_if_fail(slider_circle_ticks_ensure_capacity(ticks) == RET_OK, RET_OOM);
+
+  /*非线性映射只在重新计算时解析，间距按平均值估算*/
+  slider_circle_mapping_parse(&mapping, p->mapping, p->min, p->max);
+  if (mapping.type != SLIDER_CIRCLE_MAPPING_LINEAR) {
+    map = &mapping;
+  }
+
+  /*相邻两个步长在圆周上的间距(像素)，间距太小或者数量太多时按1,2,5,10...的倍数抽稀*/
+  unit_gap = r * sweep * p->step / range;
+  min_gap = tk_max(p->min_gap, r * sweep / (SLIDER_CIRCLE_TICKS_MAX_NR - 1));
+  minor_stride = slider_circle_ticks_stride(unit_gap, min_gap);
+  if (minor_stride == 0) {
+    return RET_OK;
+  }
+
+  if (p->major_ticks > 0) {
+    major_units = p->major_ticks * slider_circle_ticks_stride(unit_gap * p->major_ticks, min_gap);
+    if (major_units < minor_stride) {
+      major_units = minor_stride;
+    }
+  }
+
+  /*次刻度(和主刻度重合的跳过)*/
+  for (i = 0; n < SLIDER_CIRCLE_TICKS_MAX_NR; i += minor_stride) {
+    double v = p->min + i * p->step;
+
+    if (!slider_circle_ticks_in_range(p, v, i, full_circle)) {
+      break;
+    }
+    if (major_units > 0 && (i % major_units) == 0) {
+      continue;
+    }
+
+    slider_circle_ticks_add_line(ticks, n, cx, cy, r, SLIDER_CIRCLE_TICK_MINOR_LEN,
+                                 slider_circle_ticks_angle(p, map, v));
+    n++;
+  }
+
+  /*主刻度放在次刻度后面*/
+  for (i = 0; major_units > 0 && n + major_n < SLIDER_CIRCLE_TICKS_MAX_NR; i += major_units) {
+    double v = p->min + i * p->step;
+
+    if (!slider_circle_ticks_in_range(p, v, i, full_circle)) {
+      break;
+    }
+
+    slider_circle_ticks_add_line(ticks, n + major_n, cx, cy, r, SLIDER_CIRCLE_TICK_MAJOR_LEN,
+                                 slider_circle_ticks_angle(p, map, v));
+    major_n++;
+  }
+  ticks->minor_nr = n;
+  ticks->major_nr = major_n;
+
+#ifndef SLIDER_CIRCLE_WITHOUT_TEXT
+  if (major_n > 0 && p->font_size > 0) {
+    slider_circle_ticks_layout_labels(ticks, c, map, r - SLIDER_CIRCLE_TICK_MAJOR_LEN,
+                                      r * sweep * major_units * p->step / range, major_units);
+  }
+#endif /*SLIDER_CIRCLE_WITHOUT_TEXT*/
+
+  return RET_OK;
+}
+
+ret_t slider_circle_ticks_paint(slider_circle_ticks_t* ticks, canvas_t* c, color_t tick_color,
+                                color_t text_color) {
+  uint32_t i = 0;
+  vgcanvas_t* vg = NULL;
+  return_value_if_fail(ticks != NULL && c != NULL, RET_BAD_PARAMS);
+
+  vg = canvas_get_vgcanvas(c);
+  if (vg != NULL && tick_color.rgba.a > 0 && ticks->minor_nr + ticks->major_nr > 0) {
+    vgcanvas_save(vg);
+    vgcanvas_translate(vg, c->ox, c->oy);
+    vgcanvas_set_stroke_color(vg, tick_color);
+
+    /*所有次刻度一条路径，所有主刻度一条路径*/
+    if (ticks->minor_nr > 0) {
+      vgcanvas_set_line_width(vg, 1);
+      vgcanvas_begin_path(vg);
+      for (i = 0; i < ticks->minor_nr; i++) {
+        pointf_t* p = ticks->lines + i * 2;
+        vgcanvas_move_to(vg, p[0].x, p[0].y);
+        vgcanvas_line_to(vg, p[1].x, p[1].y);
+      }
+      vgcanvas_stroke(vg);
+    }
+
+    if (ticks->major_nr > 0) {
+      vgcanvas_set_line_width(vg, 2);
+      vgcanvas_begin_path(vg);
+      for (i = ticks->minor_nr; i < ticks->minor_nr + ticks->major_nr; i++) {
+        pointf_t* p = ticks->lines + i * 2;
+        vgcanvas_move_to(vg, p[0].x, p[0].y);
+        vgcanvas_line_to(vg, p[1].x, p[1].y);
+      }
+      vgcanvas_stroke(vg);
+    }
+
+    vgcanvas_restore(vg);
+  }
+
+  if (ticks->labels_nr > 0 && text_color.rgba.a > 0) {
+    canvas_set_font(c, ticks->params.font_name, ticks->params.font_size);
+    canvas_set_text_color(c, text_color);
+    canvas_set_text_align(c, ALIGN_H_CENTER, ALIGN_V_MIDDLE);
+    for (i = 0; i < ticks->labels_nr; i++) {
+      slider_circle_tick_label_t* label = ticks->labels + i;
+      canvas_draw_text_in_rect(c, label->text, label->len, &(label->r));
+    }
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_ticks_copy(slider_circle_ticks_t* ticks, const slider_circle_ticks_t* other) {
+  return_value_if_fail(ticks != NULL && other != NULL, RET_BAD_PARAMS);
+
+  ticks->dirty = TRUE;
+  if (other->dirty || other->lines == NULL || other->labels == NULL) {
+    return RET_OK;
+  }
+  return_value_if_fail(slider_circle_ticks_ensure_capacity(ticks) == RET_OK, RET_OOM);
+
+  memcpy(ticks->lines, other->lines, (other->minor_nr + other->major_nr) * 2 * sizeof(pointf_t));
+  memcpy(ticks->labels, other->labels, other->labels_nr * sizeof(slider_circle_tick_label_t));
+  ticks->params = other->params;
+  slider_circle_ticks_own_strs(ticks, other->format, other->mapping, other->font_name);
+  ticks->minor_nr = other->minor_nr;
+  ticks->major_nr = other->major_nr;
+  ticks->labels_nr = other->labels_nr;
+  ticks->dirty = FALSE;
+
+  return RET_OK;
+}
+
+ret_t slider_circle_ticks_deinit(slider_circle_ticks_t* ticks) {
+  return_value_if_fail(ticks != NULL, RET_BAD_PARAMS);
+
+  TKMEM_FREE(ticks->lines);
+  TKMEM_FREE(ticks->labels);
+  TKMEM_FREE(ticks->format);
+  TKMEM_FREE(ticks->mapping);
+  TKMEM_FREE(ticks->font_name);
+  memset(ticks, 0x00, sizeof(*ticks));
+
+  return RET_OK;
+}
+#endif /*SLIDER_CIRCLE_WITHOUT_TICKS*/
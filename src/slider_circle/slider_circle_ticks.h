@@ -0,0 +1,159 @@
+﻿/**
+ * File:   slider_circle_ticks.h
+ * Author: AWTK Develop Team
+ * Brief:  环形slider的刻度和刻度标签缓存。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-13 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SLIDER_CIRCLE_TICKS_H
+#define TK_SLIDER_CIRCLE_TICKS_H
+
+#include "base/widget.h"
+
+BEGIN_C_DECLS
+
+/*刻度的最大数量(超过时自动抽稀)*/
+#define SLIDER_CIRCLE_TICKS_MAX_NR 256
+/*刻度标签的最大长度*/
+#define SLIDER_CIRCLE_TICK_LABEL_MAX_LEN 15
+
+/**
+ * @class slider_circle_ticks_params_t
+ * 计算刻度布局所需的参数，参数不变时直接使用缓存的布局。
+ */
+typedef struct _slider_circle_ticks_params_t {
+  double min;
+  double max;
+  double step;
+  const char* format;
+  /*值到角度的映射(见slider_circle_mapping.h)，刻度和填充部分、拖动点使用同样的映射*/
+  const char* mapping;
+  const char* font_name;
+  wh_t w;
+  wh_t h;
+  int16_t start_angle;
+  int16_t end_angle;
+  uint16_t font_size;
+  uint8_t line_width;
+  uint8_t major_ticks;
+  uint8_t min_gap;
+  bool_t counter_clock_wise;
+} slider_circle_ticks_params_t;
+
+/**
+ * @class slider_circle_tick_label_t
+ * 布局好的刻度标签。
+ */
+typedef struct _slider_circle_tick_label_t {
+  rect_t r;
+  uint32_t len;
+  wchar_t text[SLIDER_CIRCLE_TICK_LABEL_MAX_LEN + 1];
+} slider_circle_tick_label_t;
+
+/**
+ * @class slider_circle_ticks_t
+ * 刻度和刻度标签的缓存。
+ *
+ * 只有在范围、角度、尺寸等参数变化时才重新计算刻度的位置和标签的文本。
+ */
+typedef struct _slider_circle_ticks_t {
+  /*params中的字符串指向下面自己的拷贝(调用者的字符串可能原地修改或者释放)*/
+  slider_circle_ticks_params_t params;
+  bool_t dirty;
+  char* format;
+  char* mapping;
+  char* font_name;
+
+  /*每个刻度两个点，次刻度在前，主刻度在后*/
+  pointf_t* lines;
+  uint32_t minor_nr;
+  uint32_t major_nr;
+
+  slider_circle_tick_label_t* labels;
+  uint32_t labels_nr;
+} slider_circle_ticks_t;
+
+/**
+ * @method slider_circle_ticks_init
+ * 初始化刻度缓存。
+ * @param {slider_circle_ticks_t*} ticks 刻度缓存。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_ticks_init(slider_circle_ticks_t* ticks);
+
+/**
+ * @method slider_circle_ticks_update
+ * 参数变化时重新计算刻度的位置和标签。
+ * @param {slider_circle_ticks_t*} ticks 刻度缓存。
+ * @param {canvas_t*} c 画布对象(用于测量标签的宽度)。
+ * @param {const slider_circle_ticks_params_t*} params 参数。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_ticks_update(slider_circle_ticks_t* ticks, canvas_t* c,
+                                 const slider_circle_ticks_params_t* params);
+
+/**
+ * @method slider_circle_ticks_paint
+ * 绘制缓存的刻度和标签。
+ * @param {slider_circle_ticks_t*} ticks 刻度缓存。
+ * @param {canvas_t*} c 画布对象。
+ * @param {color_t} tick_color 刻度的颜色。
+ * @param {color_t} text_color 标签的颜色。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_ticks_paint(slider_circle_ticks_t* ticks, canvas_t* c, color_t tick_color,
+                                color_t text_color);
+
+/**
+ * @method slider_circle_ticks_copy
+ * 拷贝另外一个刻度缓存的布局(克隆控件时使用，避免重新计算)。
+ * @param {slider_circle_ticks_t*} ticks 刻度缓存。
+ * @param {const slider_circle_ticks_t*} other 被拷贝的刻度缓存。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_ticks_copy(slider_circle_ticks_t* ticks, const slider_circle_ticks_t* other);
+
+/**
+ * @method slider_circle_ticks_deinit
+ * 释放刻度缓存。
+ * @param {slider_circle_ticks_t*} ticks 刻度缓存。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_ticks_deinit(slider_circle_ticks_t* ticks);
+
+/**
+ * @method slider_circle_format_value
+ * 按格式字符串格式化值(格式为整数类型时先四舍五入)。
+ *
+ * 整数类型支持hh、h、l和ll长度修饰符，浮点类型支持l和L，其它的长度修饰符返回RET_BAD_PARAMS(输出为空)。
+ * @param {char*} buff 输出缓冲区。
+ * @param {uint32_t} size 缓冲区大小。
+ * @param {const char*} format 格式字符串。
+ * @param {double} value 值。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_format_value(char* buff, uint32_t size, const char* format, double value);
+
+END_C_DECLS
+
+#endif /*TK_SLIDER_CIRCLE_TICKS_H*/
@@ -0,0 +1,137 @@
+﻿/**
+ * File:   slider_circle_trace.c
+ * Author: AWTK Develop Team
+ * Brief:  热点路径的耗时记录(导出为Chrome trace格式)。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/fs.h"
+#include "tkc/utils.h"
+#include "tkc/thread.h"
+#include "slider_circle_trace.h"
+
+#ifdef WITH_SLIDER_CIRCLE_TRACE
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TRACE_FETCH_INC(p) __atomic_fetch_add(p, 1, __ATOMIC_RELAXED)
+#define TRACE_STORE(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#define TRACE_LOAD(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#elif defined(_MSC_VER)
+#include <intrin.h>
+#define TRACE_FETCH_INC(p) ((uint32_t)_InterlockedIncrement((volatile long*)(p)) - 1)
+#define TRACE_STORE(p, v) (*(p) = (v))
+#define TRACE_LOAD(p) (*(p))
+#else
+/*没有原子操作的平台(一般也没有多线程)*/
+#define TRACE_FETCH_INC(p) ((*(p))++)
+#define TRACE_STORE(p, v) (*(p) = (v))
+#define TRACE_LOAD(p) (*(p))
+#endif
+
+typedef struct _trace_event_t {
+  const char* name;
+  uint64_t tid;
+  uint64_t start;
+  uint32_t dur;
+  /*写完之后设置为序号+1，导出时用来跳过正在写或者已经被覆盖的事件*/
+  volatile uint32_t seq;
+} trace_event_t;
+
+static volatile uint32_t s_trace_next;
+static trace_event_t s_trace_events[SLIDER_CIRCLE_TRACE_CAPACITY];
+
+ret_t slider_circle_trace_record(const char* name, uint64_t start) {
+  uint32_t seq = 0;
+  trace_event_t* e = NULL;
+  uint64_t end = time_now_us();
+  return_value_if_fail(name != NULL, RET_BAD_PARAMS);
+
+  seq = TRACE_FETCH_INC(&s_trace_next);
+  e = s_trace_events + (seq % SLIDER_CIRCLE_TRACE_CAPACITY);
+  TRACE_STORE(&(e->seq), 0);
+  e->name = name;
+  e->tid = tk_thread_self();
+  e->start = start;
+  e->dur = (uint32_t)(end - start);
+  TRACE_STORE(&(e->seq), seq + 1);
+
+  return RET_OK;
+}
+
+ret_t slider_circle_trace_reset(void) {
+  memset(s_trace_events, 0x00, sizeof(s_trace_events));
+  TRACE_STORE(&s_trace_next, 0);
+
+  return RET_OK;
+}
+
+uint32_t slider_circle_trace_count(void) {
+  return tk_min(TRACE_LOAD(&s_trace_next), SLIDER_CIRCLE_TRACE_CAPACITY);
+}
+
+ret_t slider_circle_trace_dump(str_t* str) {
+  uint32_t i = 0;
+  bool_t first = TRUE;
+  uint32_t end = TRACE_LOAD(&s_trace_next);
+  uint32_t begin = end > SLIDER_CIRCLE_TRACE_CAPACITY ? end - SLIDER_CIRCLE_TRACE_CAPACITY : 0;
+  return_value_if_fail(str != NULL, RET_BAD_PARAMS);
+
+  str_append(str, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+  for (i = begin; i != end; i++) {
+    trace_event_t e;
+    trace_event_t* p = s_trace_events + (i % SLIDER_CIRCLE_TRACE_CAPACITY);
+
+    /*拷贝前后序号都不变才是完整的事件*/
+    if (TRACE_LOAD(&(p->seq)) != i + 1) {
+      continue;
+    }
+    e = *p;
+    if (TRACE_LOAD(&(p->seq)) != i + 1) {
+      continue;
+    }
+
+    str_append(str, first ? "\n" : ",\n");
+    str_append_more(str, "{\"cat\":\"slider_circle\",\"ph\":\"X\",\"pid\":1,\"name\":\"", e.name,
+                    "\",\"tid\":", NULL);
+    str_append_uint64(str, e.tid);
+    str_append(str, ",\"ts\":");
+    str_append_uint64(str, e.start);
+    str_append(str, ",\"dur\":");
+    str_append_uint64(str, e.dur);
+    str_append_char(str, '}');
+    first = FALSE;
+  }
+
+  return str_append(str, "\n]}\n");
+}
+
+ret_t slider_circle_trace_save(const char* filename) {
+  str_t str;
+  ret_t ret = RET_OK;
+  return_value_if_fail(filename != NULL, RET_BAD_PARAMS);
+
+  str_init(&str, 64 * 1024);
+  ret = slider_circle_trace_dump(&str);
+  if (ret == RET_OK) {
+    ret = file_write(filename, str.str, str.size);
+  }
+  str_reset(&str);
+
+  return ret;
+}
+
+#endif /*WITH_SLIDER_CIRCLE_TRACE*/
@@ -0,0 +1,109 @@
+﻿/**
+ * File:   slider_circle_trace.h
+ * Author: AWTK Develop Team
+ * Brief:  热点路径的耗时记录(导出为Chrome trace格式)。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SLIDER_CIRCLE_TRACE_H
+#define TK_SLIDER_CIRCLE_TRACE_H
+
+#include "tkc/str.h"
+#include "tkc/time_now.h"
+
+BEGIN_C_DECLS
+
+/*环形缓冲区能保存的事件数(满了之后覆盖最早的事件)*/
+#ifndef SLIDER_CIRCLE_TRACE_CAPACITY
+#define SLIDER_CIRCLE_TRACE_CAPACITY 4096
+#endif /*SLIDER_CIRCLE_TRACE_CAPACITY*/
+
+/**
+ * @class slider_circle_trace_t
+ * @annotation ["fake"]
+ * 热点路径的耗时记录。
+ *
+ * 定义WITH_SLIDER_CIRCLE_TRACE(scons SLIDER_CIRCLE_TRACE=1)后，事件处理、值的计算、
+ * 背景、前景和文本的绘制都会把开始时间和耗时记录到内存中的环形缓冲区(不加锁，
+ * 可以在多个线程中记录)。没有定义时记录点不产生任何代码。
+ *
+ * 在设备上出现卡顿后，把记录保存为Chrome trace格式的JSON文件，
+ * 用 https://ui.perfetto.dev 或者chrome://tracing 打开：
+ *
+ * ```c
+ * slider_circle_trace_reset();
+ * ...
+ * slider_circle_trace_save("/tmp/slider_circle.json");
+ * ```
+ */
+
+#ifdef WITH_SLIDER_CIRCLE_TRACE
+#define SLIDER_CIRCLE_TRACE_BEGIN(id) uint64_t slider_circle_trace_##id = time_now_us()
+#define SLIDER_CIRCLE_TRACE_END(id) slider_circle_trace_record(#id, slider_circle_trace_##id)
+#else
+#define SLIDER_CIRCLE_TRACE_BEGIN(id)
+#define SLIDER_CIRCLE_TRACE_END(id)
+#endif /*WITH_SLIDER_CIRCLE_TRACE*/
+
+/**
+ * @method slider_circle_trace_record
+ * 记录一个事件(结束时间为当前时间)。一般通过SLIDER_CIRCLE_TRACE_END调用。
+ * @param {const char*} name 事件名(必须是常量字符串，只保存指针)。
+ * @param {uint64_t} start 开始时间(微秒，time_now_us的返回值)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_trace_record(const char* name, uint64_t start);
+
+/**
+ * @method slider_circle_trace_reset
+ * 清除所有记录。
+ * > 清除时不能有其它线程在记录。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_trace_reset(void);
+
+/**
+ * @method slider_circle_trace_count
+ * 获取缓冲区中的事件数(最多为SLIDER_CIRCLE_TRACE_CAPACITY)。
+ *
+ * @return {uint32_t} 返回事件数。
+ */
+uint32_t slider_circle_trace_count(void);
+
+/**
+ * @method slider_circle_trace_dump
+ * 把缓冲区中的事件按Chrome trace-event格式追加到str中。
+ * @param {str_t*} str 字符串对象。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_trace_dump(str_t* str);
+
+/**
+ * @method slider_circle_trace_save
+ * 把缓冲区中的事件按Chrome trace-event格式保存到文件。
+ * @param {const char*} filename 文件名。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_trace_save(const char* filename);
+
+END_C_DECLS
+
+#endif /*TK_SLIDER_CIRCLE_TRACE_H*/
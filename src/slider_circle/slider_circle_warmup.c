@@ -0,0 +1,381 @@
+﻿/**
+ * File:   slider_circle_warmup.c
+ * Author: AWTK Develop Team
+ * Brief:  在工作线程中并行预先生成slider_circle的缓存层。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-15 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "tkc/mutex.h"
+#include "tkc/thread.h"
+#include "tkc/platform.h"
+#include "tkc/semaphore.h"
+#include "tkc/time_now.h"
+#include "slider_circle.h"
+#include "slider_circle_warmup.h"
+
+#ifndef SLIDER_CIRCLE_WITHOUT_WARMUP
+
+typedef struct _slider_circle_warmup_t {
+  tk_mutex_t* mutex;
+  tk_semaphore_t* jobs;
+  tk_thread_t* threads[SLIDER_CIRCLE_WARMUP_MAX_THREADS];
+  uint32_t threads_nr;
+  slider_circle_layer_t* head;
+  slider_circle_layer_t* tail;
+  uint32_t running;
+  bool_t quit;
+} slider_circle_warmup_t;
+
+static slider_circle_warmup_t* s_warmup = NULL;
+
+static ret_t slider_circle_layer_render_zones(slider_circle_layer_t* layer) {
+  uint32_t i = 0;
+  slider_circle_raster_arc_t arc = layer->key.arc;
+
+  arc.cap = SLIDER_CIRCLE_RASTER_CAP_BUTT;
+  for (i = 0; i < layer->key.zones_nr; i++) {
+    const slider_circle_layer_zone_t* zone = layer->key.zones + i;
+
+    arc.start_angle = zone->start_angle;
+    arc.end_angle = zone->end_angle;
+    slider_circle_raster_rgba_over(&arc, zone->color, layer->data, layer->key.w, layer->key.h,
+                                   layer->line_length);
+  }
+
+  return RET_OK;
+}
+
+static void* slider_circle_warmup_entry(void* args) {
+  slider_circle_warmup_t* warmup = (slider_circle_warmup_t*)args;
+
+  while (TRUE) {
+    slider_circle_layer_t* layer = NULL;
+
+    tk_semaphore_wait(warmup->jobs, 0xffffffff);
+    tk_mutex_lock(warmup->mutex);
+    if (warmup->quit) {
+      tk_mutex_unlock(warmup->mutex);
+      break;
+    }
+
+    layer = warmup->head;
+    if (layer != NULL) {
+      warmup->head = layer->next;
+      if (warmup->head == NULL) {
+        warmup->tail = NULL;
+      }
+      layer->next = NULL;
+      layer->state = SLIDER_CIRCLE_LAYER_RUNNING;
+      warmup->running++;
+    }
+    tk_mutex_unlock(warmup->mutex);
+
+    if (layer != NULL) {
+      /*只访问layer自己的数据，不访问控件、字体和图片管理器*/
+      memset(layer->data, 0x00, layer->line_length * layer->key.h);
+      slider_circle_raster_rgba(&(layer->key.arc), layer->key.color, layer->data, layer->key.w,
+                                layer->key.h, layer->line_length);
+      slider_circle_layer_render_zones(layer);
+
+      tk_mutex_lock(warmup->mutex);
+      layer->state = SLIDER_CIRCLE_LAYER_READY;
+      warmup->running--;
+      tk_mutex_unlock(warmup->mutex);
+    }
+  }
+
+  return NULL;
+}
+
+ret_t slider_circle_warmup_init(uint32_t threads) {
+  uint32_t i = 0;
+  slider_circle_warmup_t* warmup = NULL;
+  return_value_if_fail(s_warmup == NULL, RET_BUSY);
+  return_value_if_fail(threads > 0, RET_BAD_PARAMS);
+
+  warmup = TKMEM_ZALLOC(slider_circle_warmup_t);
+  return_value_if_fail(warmup != NULL, RET_OOM);
+
+  warmup->mutex = tk_mutex_create();
+  warmup->jobs = tk_semaphore_create(0, "slider_circle_warmup");
+  goto_error_if_fail(warmup->mutex != NULL && warmup->jobs != NULL);
+
+  threads = tk_min(threads, SLIDER_CIRCLE_WARMUP_MAX_THREADS);
+  for (i = 0; i < threads; i++) {
+    tk_thread_t* thread = tk_thread_create(slider_circle_warmup_entry, warmup);
+    if (thread == NULL) {
+      break;
+    }
+
+    tk_thread_set_name(thread, "slider_circle_warmup");
+    if (tk_thread_start(thread) != RET_OK) {
+      tk_thread_destroy(thread);
+      break;
+    }
+    warmup->threads[warmup->threads_nr++] = thread;
+  }
+  goto_error_if_fail(warmup->threads_nr > 0);
+
+  s_warmup = warmup;
+
+  return RET_OK;
+error:
+  if (warmup->jobs != NULL) {
+    tk_semaphore_destroy(warmup->jobs);
+  }
+  if (warmup->mutex != NULL) {
+    tk_mutex_destroy(warmup->mutex);
+  }
+  TKMEM_FREE(warmup);
+
+  return RET_FAIL;
+}
+
+static ret_t slider_circle_warmup_on_widget(void* ctx, const void* data) {
+  widget_t* widget = WIDGET(data);
+
+  if (widget_is_instance_of(widget, TK_REF_VTABLE(slider_circle))) {
+    slider_circle_warmup_widget(widget);
+  }
+
+  return RET_OK;
+}
+
+ret_t slider_circle_warmup(widget_t* root) {
+  return_value_if_fail(root != NULL, RET_BAD_PARAMS);
+
+  if (s_warmup == NULL) {
+    return RET_OK;
+  }
+
+  return widget_foreach(root, slider_circle_warmup_on_widget, NULL);
+}
+
+ret_t slider_circle_warmup_wait(uint32_t timeout_ms) {
+  uint64_t start = time_now_ms();
+
+  while (s_warmup != NULL) {
+    bool_t done = FALSE;
+
+    tk_mutex_lock(s_warmup->mutex);
+    done = s_warmup->head == NULL && s_warmup->running == 0;
+    tk_mutex_unlock(s_warmup->mutex);
+
+    if (done) {
+      break;
+    } else if (time_now_ms() - start >= timeout_ms) {
+      return RET_TIMEOUT;
+    }
+    sleep_ms(1);
+  }
+
+  return RET_OK;
+}
+
+bool_t slider_circle_warmup_is_running(void) {
+  return s_warmup != NULL;
+}
+
+ret_t slider_circle_warmup_deinit(void) {
+  uint32_t i = 0;
+  slider_circle_warmup_t* warmup = s_warmup;
+  return_value_if_fail(warmup != NULL, RET_BAD_PARAMS);
+
+  tk_mutex_lock(warmup->mutex);
+  warmup->quit = TRUE;
+  /*还在队列中的缓存层保持PENDING状态，绘制时直接绘制，销毁控件时释放*/
+  while (warmup->head != NULL) {
+    slider_circle_layer_t* layer = warmup->head;
+    warmup->head = layer->next;
+    layer->next = NULL;
+  }
+  warmup->tail = NULL;
+  tk_mutex_unlock(warmup->mutex);
+
+  for (i = 0; i < warmup->threads_nr; i++) {
+    tk_semaphore_post(warmup->jobs);
+  }
+  for (i = 0; i < warmup->threads_nr; i++) {
+    tk_thread_join(warmup->threads[i]);
+    tk_thread_destroy(warmup->threads[i]);
+  }
+
+  tk_semaphore_destroy(warmup->jobs);
+  tk_mutex_destroy(warmup->mutex);
+  TKMEM_FREE(warmup);
+  s_warmup = NULL;
+
+  return RET_OK;
+}
+
+/*把缓存层从队列中取出来，正在生成时等待生成完成*/
+static ret_t slider_circle_layer_cancel(slider_circle_layer_t* layer) {
+  while (s_warmup != NULL) {
+    slider_circle_layer_state_t state = SLIDER_CIRCLE_LAYER_PENDING;
+
+    tk_mutex_lock(s_warmup->mutex);
+    state = layer->state;
+    if (state == SLIDER_CIRCLE_LAYER_PENDING) {
+      slider_circle_layer_t* iter = s_warmup->head;
+      slider_circle_layer_t* prev = NULL;
+
+      while (iter != NULL && iter != layer) {
+        prev = iter;
+        iter = iter->next;
+      }
+
+      if (iter != NULL) {
+        if (prev != NULL) {
+          prev->next = layer->next;
+        } else {
+          s_warmup->head = layer->next;
+        }
+        if (s_warmup->tail == layer) {
+          s_warmup->tail = prev;
+        }
+        layer->next = NULL;
+      }
+    }
+    tk_mutex_unlock(s_warmup->mutex);
+
+    if (state != SLIDER_CIRCLE_LAYER_RUNNING) {
+      break;
+    }
+    sleep_ms(1);
+  }
+
+  return RET_OK;
+}
+
+static ret_t slider_circle_layer_release_bitmap(slider_circle_layer_t* layer) {
+  if (layer->bitmap != NULL) {
+    if (layer->data != NULL) {
+      bitmap_unlock_buffer(layer->bitmap);
+    }
+    bitmap_destroy(layer->bitmap);
+  }
+  layer->bitmap = NULL;
+  layer->data = NULL;
+
+  return RET_OK;
+}
+
+ret_t slider_circle_layer_schedule(slider_circle_layer_t** layer,
+                                   const slider_circle_layer_key_t* key) {
+  slider_circle_layer_t* l = NULL;
+  return_value_if_fail(layer != NULL && key != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(key->w > 0 && key->h > 0, RET_BAD_PARAMS);
+
+  if (s_warmup == NULL) {
+    return RET_NOT_IMPL;
+  }
+
+  l = *layer;
+  if (l != NULL && memcmp(&(l->key), key, sizeof(*key)) == 0 && l->bitmap != NULL) {
+    slider_circle_layer_state_t state = SLIDER_CIRCLE_LAYER_PENDING;
+
+    tk_mutex_lock(s_warmup->mutex);
+    state = l->state;
+    tk_mutex_unlock(s_warmup->mutex);
+    if (state != SLIDER_CIRCLE_LAYER_PENDING) {
+      return RET_OK;
+    }
+  }
+
+  if (l == NULL) {
+    l = TKMEM_ZALLOC(slider_circle_layer_t);
+    return_value_if_fail(l != NULL, RET_OOM);
+    *layer = l;
+  } else {
+    slider_circle_layer_cancel(l);
+    slider_circle_layer_release_bitmap(l);
+  }
+
+  l->key = *key;
+  l->bitmap = bitmap_create_ex(key->w, key->h, 0, BITMAP_FMT_RGBA8888);
+  return_value_if_fail(l->bitmap != NULL, RET_OOM);
+  l->data = bitmap_lock_buffer_for_write(l->bitmap);
+  if (l->data == NULL) {
+    slider_circle_layer_release_bitmap(l);
+    return RET_FAIL;
+  }
+  l->line_length = bitmap_get_line_length(l->bitmap);
+
+  tk_mutex_lock(s_warmup->mutex);
+  l->state = SLIDER_CIRCLE_LAYER_PENDING;
+  l->next = NULL;
+  if (s_warmup->tail != NULL) {
+    s_warmup->tail->next = l;
+  } else {
+    s_warmup->head = l;
+  }
+  s_warmup->tail = l;
+  tk_mutex_unlock(s_warmup->mutex);
+  tk_semaphore_post(s_warmup->jobs);
+
+  return RET_OK;
+}
+
+bitmap_t* slider_circle_layer_adopt(slider_circle_layer_t* layer,
+                                    const slider_circle_layer_key_t* key) {
+  slider_circle_layer_state_t state = SLIDER_CIRCLE_LAYER_PENDING;
+
+  if (layer == NULL || layer->bitmap == NULL || memcmp(&(layer->key), key, sizeof(*key)) != 0) {
+    return NULL;
+  }
+
+  /*data只在主线程修改，为NULL说明已经接管，不用再加锁*/
+  if (layer->data == NULL) {
+    return layer->bitmap;
+  }
+
+  /*状态由工作线程修改，在锁内读取和转换，同时保证能看到工作线程写入的像素*/
+  if (s_warmup != NULL) {
+    tk_mutex_lock(s_warmup->mutex);
+  }
+  state = layer->state;
+  if (state == SLIDER_CIRCLE_LAYER_READY) {
+    layer->state = SLIDER_CIRCLE_LAYER_ADOPTED;
+  }
+  if (s_warmup != NULL) {
+    tk_mutex_unlock(s_warmup->mutex);
+  }
+
+  if (state != SLIDER_CIRCLE_LAYER_READY) {
+    return NULL;
+  }
+
+  bitmap_unlock_buffer(layer->bitmap);
+  layer->data = NULL;
+  layer->bitmap->flags |= BITMAP_FLAG_CHANGED;
+
+  return layer->bitmap;
+}
+
+ret_t slider_circle_layer_destroy(slider_circle_layer_t* layer) {
+  return_value_if_fail(layer != NULL, RET_BAD_PARAMS);
+
+  slider_circle_layer_cancel(layer);
+  slider_circle_layer_release_bitmap(layer);
+  TKMEM_FREE(layer);
+
+  return RET_OK;
+}
+
+#endif /*SLIDER_CIRCLE_WITHOUT_WARMUP*/
@@ -0,0 +1,164 @@
+﻿/**
+ * File:   slider_circle_warmup.h
+ * Author: AWTK Develop Team
+ * Brief:  在工作线程中并行预先生成slider_circle的缓存层。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-15 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SLIDER_CIRCLE_WARMUP_H
+#define TK_SLIDER_CIRCLE_WARMUP_H
+
+#include "base/bitmap.h"
+#include "base/widget.h"
+#include "slider_circle_zones.h"
+#include "slider_circle_raster.h"
+
+BEGIN_C_DECLS
+
+/*工作线程的最大数量*/
+#define SLIDER_CIRCLE_WARMUP_MAX_THREADS 8
+
+/**
+ * @enum slider_circle_layer_state_t
+ * 缓存层的状态。
+ */
+typedef enum _slider_circle_layer_state_t {
+  SLIDER_CIRCLE_LAYER_PENDING = 0,
+  SLIDER_CIRCLE_LAYER_RUNNING,
+  SLIDER_CIRCLE_LAYER_READY,
+  SLIDER_CIRCLE_LAYER_ADOPTED
+} slider_circle_layer_state_t;
+
+/**
+ * @class slider_circle_layer_zone_t
+ * 缓存层中叠加在圆弧上的区间(与圆弧的半径和线宽相同，两端为平头)。
+ */
+typedef struct _slider_circle_layer_zone_t {
+  float_t start_angle;
+  float_t end_angle;
+  color_t color;
+} slider_circle_layer_zone_t;
+
+/**
+ * @class slider_circle_layer_key_t
+ * 缓存层的内容(用之前先memset清零，比较时用memcmp)。
+ */
+typedef struct _slider_circle_layer_key_t {
+  wh_t w;
+  wh_t h;
+  color_t color;
+  slider_circle_raster_arc_t arc;
+  uint32_t zones_nr;
+  slider_circle_layer_zone_t zones[SLIDER_CIRCLE_ZONES_MAX];
+} slider_circle_layer_key_t;
+
+/**
+ * @class slider_circle_layer_t
+ * 缓存层(轨道、拖动点等)。
+ *
+ * 位图在GUI线程中创建并锁定，工作线程只往锁定的缓冲区中写像素，
+ * GUI线程在绘制时发现已经生成完成才解锁并使用，没有完成时直接绘制。
+ */
+typedef struct _slider_circle_layer_t {
+  slider_circle_layer_key_t key;
+  bitmap_t* bitmap;
+
+  /*private*/
+  uint8_t* data;
+  uint32_t line_length;
+  volatile slider_circle_layer_state_t state;
+  struct _slider_circle_layer_t* next;
+} slider_circle_layer_t;
+
+/**
+ * @method slider_circle_warmup_init
+ * 启动工作线程。
+ * @param {uint32_t} threads 工作线程的数量(通常为CPU核数)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_warmup_init(uint32_t threads);
+
+/**
+ * @method slider_circle_warmup
+ * 为root(包括root自己)下所有的slider_circle安排生成缓存层(通常在打开窗口之后、第一次绘制之前调用)。
+ * > 没有调用slider_circle_warmup_init时什么也不做。
+ * @param {widget_t*} root 根控件。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_warmup(widget_t* root);
+
+/**
+ * @method slider_circle_warmup_wait
+ * 等待所有安排的缓存层生成完成。
+ * @param {uint32_t} timeout_ms 超时时间(毫秒)。
+ *
+ * @return {ret_t} 返回RET_OK表示完成，RET_TIMEOUT表示超时。
+ */
+ret_t slider_circle_warmup_wait(uint32_t timeout_ms);
+
+/**
+ * @method slider_circle_warmup_is_running
+ * 工作线程是否已经启动。
+ *
+ * @return {bool_t} 返回TRUE表示已经启动。
+ */
+bool_t slider_circle_warmup_is_running(void);
+
+/**
+ * @method slider_circle_warmup_deinit
+ * 停止工作线程(还没有生成的缓存层会在绘制时直接绘制)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_warmup_deinit(void);
+
+/**
+ * @method slider_circle_layer_schedule
+ * 安排生成缓存层(只能在GUI线程中调用)。
+ * @param {slider_circle_layer_t**} layer 缓存层(为NULL时创建)。
+ * @param {const slider_circle_layer_key_t*} key 缓存层的内容。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，没有启动工作线程时返回RET_NOT_IMPL。
+ */
+ret_t slider_circle_layer_schedule(slider_circle_layer_t** layer,
+                                   const slider_circle_layer_key_t* key);
+
+/**
+ * @method slider_circle_layer_adopt
+ * 获取已经生成好的缓存层(只能在GUI线程中调用)。
+ * @param {slider_circle_layer_t*} layer 缓存层。
+ * @param {const slider_circle_layer_key_t*} key 需要的内容。
+ *
+ * @return {bitmap_t*} 已经生成并且内容一致时返回位图，否则返回NULL(调用者直接绘制)。
+ */
+bitmap_t* slider_circle_layer_adopt(slider_circle_layer_t* layer,
+                                    const slider_circle_layer_key_t* key);
+
+/**
+ * @method slider_circle_layer_destroy
+ * 销毁缓存层(正在生成时等待生成完成)。
+ * @param {slider_circle_layer_t*} layer 缓存层。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_layer_destroy(slider_circle_layer_t* layer);
+
+END_C_DECLS
+
+#endif /*TK_SLIDER_CIRCLE_WARMUP_H*/
@@ -0,0 +1,123 @@
+﻿/**
+ * File:   slider_circle_zones.c
+ * Author: AWTK Develop Team
+ * Brief:  轨道上的彩色区间(如告警区间)。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/utils.h"
+#include "base/color_parser.h"
+#include "slider_circle_zones.h"
+
+#define ZONE_COLOR_MAX_LEN 31
+
+static bool_t slider_circle_zone_parse(slider_circle_zone_t* zone, const char* str,
+                                       uint32_t len) {
+  const char* end = str + len;
+  const char* p1 = NULL;
+  const char* p2 = NULL;
+  char color[ZONE_COLOR_MAX_LEN + 1];
+
+  p1 = (const char*)memchr(str, ',', len);
+  if (p1 == NULL) {
+    return FALSE;
+  }
+  p2 = (const char*)memchr(p1 + 1, ',', end - p1 - 1);
+  if (p2 == NULL) {
+    return FALSE;
+  }
+
+  /*颜色可能是rgba(r,g,b,a)，第二个逗号之后都是颜色*/
+  p2++;
+  while (p2 < end && *p2 == ' ') {
+    p2++;
+  }
+  while (end > p2 && end[-1] == ' ') {
+    end--;
+  }
+  if (p2 == end || end - p2 > ZONE_COLOR_MAX_LEN) {
+    return FALSE;
+  }
+  memcpy(color, p2, end - p2);
+  color[end - p2] = '\0';
+
+  zone->from = tk_atof(str);
+  zone->to = tk_atof(p1 + 1);
+  if (zone->from > zone->to) {
+    double t = zone->from;
+    zone->from = zone->to;
+    zone->to = t;
+  }
+  zone->color = color_parse(color);
+
+  return TRUE;
+}
+
+static ret_t slider_circle_zones_merge(slider_circle_zones_t* zones) {
+  uint32_t i = 0;
+  uint32_t n = 0;
+
+  /*区间很少，用插入排序*/
+  for (i = 1; i < zones->size; i++) {
+    int32_t k = i - 1;
+    slider_circle_zone_t zone = zones->zones[i];
+
+    while (k >= 0 && zones->zones[k].from > zone.from) {
+      zones->zones[k + 1] = zones->zones[k];
+      k--;
+    }
+    zones->zones[k + 1] = zone;
+  }
+
+  /*颜色相同并且相连(或者重叠)的区间合并成一个*/
+  for (i = 0; i < zones->size; i++) {
+    slider_circle_zone_t* prev = n > 0 ? zones->zones + n - 1 : NULL;
+    slider_circle_zone_t* zone = zones->zones + i;
+
+    if (prev != NULL && prev->color.color == zone->color.color && zone->from <= prev->to) {
+      prev->to = tk_max(prev->to, zone->to);
+    } else {
+      zones->zones[n++] = *zone;
+    }
+  }
+  zones->size = n;
+
+  return RET_OK;
+}
+
+ret_t slider_circle_zones_parse(slider_circle_zones_t* zones, const char* str) {
+  const char* p = str;
+  return_value_if_fail(zones != NULL, RET_BAD_PARAMS);
+
+  memset(zones, 0x00, sizeof(*zones));
+  while (p != NULL && *p) {
+    const char* end = strchr(p, ';');
+    uint32_t len = end != NULL ? end - p : strlen(p);
+
+    if (zones->size >= SLIDER_CIRCLE_ZONES_MAX) {
+      log_warn("slider_circle: too many zones, ignore \"%s\"\n", p);
+      break;
+    }
+    if (slider_circle_zone_parse(zones->zones + zones->size, p, len)) {
+      zones->size++;
+    }
+
+    p = end != NULL ? end + 1 : NULL;
+  }
+
+  return slider_circle_zones_merge(zones);
+}
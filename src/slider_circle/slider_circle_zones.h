@@ -0,0 +1,91 @@
+﻿/**
+ * File:   slider_circle_zones.h
+ * Author: AWTK Develop Team
+ * Brief:  轨道上的彩色区间(如告警区间)。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_SLIDER_CIRCLE_ZONES_H
+#define TK_SLIDER_CIRCLE_ZONES_H
+
+#include "tkc/color.h"
+
+BEGIN_C_DECLS
+
+/*区间的最大数量(合并之后，多出的区间忽略)*/
+#define SLIDER_CIRCLE_ZONES_MAX 8
+
+/**
+ * @class slider_circle_zone_t
+ * 一个彩色区间。
+ */
+typedef struct _slider_circle_zone_t {
+  /**
+   * @property {double} from
+   * 起始值。
+   */
+  double from;
+  /**
+   * @property {double} to
+   * 结束值(不小于from)。
+   */
+  double to;
+  /**
+   * @property {color_t} color
+   * 颜色。
+   */
+  color_t color;
+} slider_circle_zone_t;
+
+/**
+ * @class slider_circle_zones_t
+ * 解析后的彩色区间(按起始值排序，颜色相同并且相连的区间已经合并)。
+ */
+typedef struct _slider_circle_zones_t {
+  /**
+   * @property {uint32_t} size
+   * 区间的数量。
+   */
+  uint32_t size;
+  /**
+   * @property {slider_circle_zone_t*} zones
+   * 区间。
+   */
+  slider_circle_zone_t zones[SLIDER_CIRCLE_ZONES_MAX];
+} slider_circle_zones_t;
+
+/**
+ * @method slider_circle_zones_parse
+ * 解析区间字符串。
+ *
+ * 区间之间用分号分隔，每个区间为"起始值,结束值,颜色"，颜色的格式与样式中的颜色相同。如：
+ *
+ * ```
+ * 80,90,#ffbf00;90,100,red
+ * ```
+ *
+ * > 格式不正确的区间忽略。
+ * @param {slider_circle_zones_t*} zones 返回解析的结果。
+ * @param {const char*} str 区间字符串(为NULL时没有区间)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_zones_parse(slider_circle_zones_t* zones, const char* str);
+
+END_C_DECLS
+
+#endif /*TK_SLIDER_CIRCLE_ZONES_H*/
@@ -24,11 +24,19 @@
 #include "slider_circle_register.h"
 #include "base/widget_factory.h"
 #include "slider_circle/slider_circle.h"
+#include "slider_circle/gauge_circle.h"
+#include "slider_circle/slider_circle_sprite.h"
 
 ret_t slider_circle_register(void) {
+  widget_factory_register(widget_factory(), WIDGET_TYPE_GAUGE_CIRCLE, gauge_circle_create);
+
   return widget_factory_register(widget_factory(), WIDGET_TYPE_SLIDER_CIRCLE, slider_circle_create);
 }
 
+ret_t slider_circle_sprite_cache_deinit(void) {
+  return slider_circle_sprite_clear();
+}
+
 const char* slider_circle_supported_render_mode(void) {
   return "OpenGL|AGGE-BGR565|AGGE-BGRA8888|AGGE-MONO";
 }
@@ -36,6 +36,17 @@ BEGIN_C_DECLS
  */
 ret_t slider_circle_register(void);
 
+/**
+ * @method  slider_circle_sprite_cache_deinit
+ * 释放控件共用的拖动点位图缓存。
+ * 退出前调用，之后仍然可以绘制，缓存会重新生成。
+ *
+ * @annotation ["global"]
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t slider_circle_sprite_cache_deinit(void);
+
 /**
  * @method  slider_circle_supported_render_mode
  * 获取支持的渲染模式。
@@ -0,0 +1,224 @@
+﻿/**
+ * File:   alloc_hook.c
+ * Author: AWTK Develop Team
+ * Brief:  替换malloc/free，统计稳定状态下的内存分配并记录分配的位置。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "alloc_hook.h"
+
+#if defined(__linux__) && defined(__GLIBC__)
+#include <malloc.h>
+#include <execinfo.h>
+
+#define ALLOC_SITES_MAX 8
+#define ALLOC_SITE_DEPTH 12
+
+typedef struct _alloc_site_t {
+  void* frames[ALLOC_SITE_DEPTH];
+  int depth;
+} alloc_site_t;
+
+typedef struct _alloc_hook_t {
+  bool_t tracking;
+  bool_t in_hook;
+  uint32_t allocs;
+  uint32_t frees;
+  uint32_t sites_nr;
+  alloc_site_t sites[ALLOC_SITES_MAX];
+  /*只用于单线程的测试，没有加锁*/
+  bool_t measuring;
+  alloc_hook_stats_t stats;
+} alloc_hook_t;
+
+static alloc_hook_t s_alloc_hook;
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t nr, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void __libc_free(void* ptr);
+
+static void alloc_hook_record(bool_t is_free) {
+  if (!s_alloc_hook.tracking || s_alloc_hook.in_hook) {
+    return;
+  }
+
+  /*backtrace内部可能再调用malloc，不能重入*/
+  s_alloc_hook.in_hook = TRUE;
+  if (is_free) {
+    s_alloc_hook.frees++;
+  } else {
+    s_alloc_hook.allocs++;
+  }
+  if (s_alloc_hook.sites_nr < ALLOC_SITES_MAX) {
+    alloc_site_t* site = s_alloc_hook.sites + s_alloc_hook.sites_nr++;
+    site->depth = backtrace(site->frames, ALLOC_SITE_DEPTH);
+  }
+  s_alloc_hook.in_hook = FALSE;
+}
+
+/*malloc_usable_size不分配内存，可以在钩子中调用*/
+static void alloc_hook_measure(void* freed, void* allocated) {
+  alloc_hook_stats_t* stats = &(s_alloc_hook.stats);
+
+  if (!s_alloc_hook.measuring) {
+    return;
+  }
+
+  if (freed != NULL) {
+    stats->frees++;
+    stats->bytes -= malloc_usable_size(freed);
+  }
+  if (allocated != NULL) {
+    stats->allocs++;
+    stats->bytes += malloc_usable_size(allocated);
+    if (stats->bytes > stats->peak_bytes) {
+      stats->peak_bytes = stats->bytes;
+    }
+  }
+}
+
+void* malloc(size_t size) {
+  void* p = NULL;
+
+  alloc_hook_record(FALSE);
+  p = __libc_malloc(size);
+  alloc_hook_measure(NULL, p);
+
+  return p;
+}
+
+void* calloc(size_t nr, size_t size) {
+  void* p = NULL;
+
+  alloc_hook_record(FALSE);
+  p = __libc_calloc(nr, size);
+  alloc_hook_measure(NULL, p);
+
+  return p;
+}
+
+void* realloc(void* ptr, size_t size) {
+  void* p = NULL;
+  size_t old_size = ptr != NULL ? malloc_usable_size(ptr) : 0;
+
+  alloc_hook_record(FALSE);
+  p = __libc_realloc(ptr, size);
+  if (p != NULL || size == 0) {
+    /*原来的内存块已经释放(或者原地扩展)，按释放旧的、分配新的统计*/
+    if (s_alloc_hook.measuring && ptr != NULL) {
+      s_alloc_hook.stats.frees++;
+      s_alloc_hook.stats.bytes -= old_size;
+    }
+    alloc_hook_measure(NULL, p);
+  }
+
+  return p;
+}
+
+void free(void* ptr) {
+  if (ptr != NULL) {
+    alloc_hook_record(TRUE);
+    alloc_hook_measure(ptr, NULL);
+  }
+  __libc_free(ptr);
+}
+
+bool_t alloc_hook_supported(void) {
+  return TRUE;
+}
+
+ret_t alloc_hook_start(void) {
+  void* frames[2];
+
+  /*第一次调用backtrace会加载libgcc_s(会分配内存)，在统计之前先调用一次*/
+  backtrace(frames, 2);
+  memset(&s_alloc_hook, 0x00, sizeof(s_alloc_hook));
+  s_alloc_hook.tracking = TRUE;
+
+  return RET_OK;
+}
+
+uint32_t alloc_hook_stop(const char* name) {
+  uint32_t i = 0;
+
+  s_alloc_hook.tracking = FALSE;
+  if (s_alloc_hook.allocs > 0 || s_alloc_hook.frees > 0) {
+    /*backtrace_symbols_fd不分配内存，直接写到stderr*/
+    fprintf(stderr, "%s: %u allocs, %u frees in steady state\n", name, s_alloc_hook.allocs,
+            s_alloc_hook.frees);
+    for (i = 0; i < s_alloc_hook.sites_nr; i++) {
+      fprintf(stderr, "--- site %u ---\n", i);
+      backtrace_symbols_fd(s_alloc_hook.sites[i].frames, s_alloc_hook.sites[i].depth, 2);
+    }
+  }
+
+  return s_alloc_hook.allocs + s_alloc_hook.frees;
+}
+
+ret_t alloc_hook_measure_start(void) {
+  memset(&(s_alloc_hook.stats), 0x00, sizeof(s_alloc_hook.stats));
+  s_alloc_hook.measuring = TRUE;
+
+  return RET_OK;
+}
+
+ret_t alloc_hook_measure_get(alloc_hook_stats_t* stats) {
+  return_value_if_fail(stats != NULL, RET_BAD_PARAMS);
+
+  *stats = s_alloc_hook.stats;
+
+  return RET_OK;
+}
+
+ret_t alloc_hook_measure_stop(alloc_hook_stats_t* stats) {
+  s_alloc_hook.measuring = FALSE;
+
+  return alloc_hook_measure_get(stats);
+}
+#else
+bool_t alloc_hook_supported(void) {
+  return FALSE;
+}
+
+ret_t alloc_hook_start(void) {
+  return RET_NOT_IMPL;
+}
+
+uint32_t alloc_hook_stop(const char* name) {
+  (void)name;
+  return 0;
+}
+
+ret_t alloc_hook_measure_start(void) {
+  return RET_NOT_IMPL;
+}
+
+ret_t alloc_hook_measure_get(alloc_hook_stats_t* stats) {
+  return_value_if_fail(stats != NULL, RET_BAD_PARAMS);
+
+  memset(stats, 0x00, sizeof(*stats));
+
+  return RET_NOT_IMPL;
+}
+
+ret_t alloc_hook_measure_stop(alloc_hook_stats_t* stats) {
+  return alloc_hook_measure_get(stats);
+}
+#endif /*__linux__ && __GLIBC__*/
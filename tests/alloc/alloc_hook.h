@@ -0,0 +1,118 @@
+﻿/**
+ * File:   alloc_hook.h
+ * Author: AWTK Develop Team
+ * Brief:  替换malloc/free，统计稳定状态下的内存分配并记录分配的位置。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-16 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_ALLOC_HOOK_H
+#define TK_ALLOC_HOOK_H
+
+#include "tkc/types_def.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class alloc_hook_t
+ * @annotation ["fake"]
+ * 统计一段代码中的内存分配。
+ *
+ * PC版本中TKMEM_ALLOC最终调用malloc(HAS_STD_MALLOC)，替换malloc/calloc/realloc/free之后，
+ * TKMEM和第三方库的分配都能统计到。只支持Linux(glibc)。
+ */
+
+/**
+ * @class alloc_hook_stats_t
+ * 一段代码中堆的使用情况(字节数按malloc_usable_size计算，包括分配器的对齐)。
+ */
+typedef struct _alloc_hook_stats_t {
+  /**
+   * @property {uint32_t} allocs
+   * 分配的次数。
+   */
+  uint32_t allocs;
+  /**
+   * @property {uint32_t} frees
+   * 释放的次数。
+   */
+  uint32_t frees;
+  /**
+   * @property {int64_t} bytes
+   * 开始统计以来净增的字节数(释放了之前分配的内存时可以为负)。
+   */
+  int64_t bytes;
+  /**
+   * @property {int64_t} peak_bytes
+   * 净增的字节数的最大值。
+   */
+  int64_t peak_bytes;
+} alloc_hook_stats_t;
+
+/**
+ * @method alloc_hook_supported
+ * 当前平台是否支持。
+ *
+ * @return {bool_t} 返回TRUE表示支持。
+ */
+bool_t alloc_hook_supported(void);
+
+/**
+ * @method alloc_hook_start
+ * 开始统计(清除之前的结果)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t alloc_hook_start(void);
+
+/**
+ * @method alloc_hook_stop
+ * 停止统计。有分配或者释放时，输出次数和前几次分配的调用栈到stderr。
+ * @param {const char*} name 名称(用于输出)。
+ *
+ * @return {uint32_t} 返回分配和释放的次数。
+ */
+uint32_t alloc_hook_stop(const char* name);
+
+/**
+ * @method alloc_hook_measure_start
+ * 开始统计堆的使用情况(清除之前的结果，不记录分配的位置，不输出)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t alloc_hook_measure_start(void);
+
+/**
+ * @method alloc_hook_measure_get
+ * 获取到目前为止的统计结果(继续统计)。
+ * @param {alloc_hook_stats_t*} stats 返回统计结果。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t alloc_hook_measure_get(alloc_hook_stats_t* stats);
+
+/**
+ * @method alloc_hook_measure_stop
+ * 停止统计堆的使用情况。
+ * @param {alloc_hook_stats_t*} stats 返回统计结果。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t alloc_hook_measure_stop(alloc_hook_stats_t* stats);
+
+END_C_DECLS
+
+#endif /*TK_ALLOC_HOOK_H*/
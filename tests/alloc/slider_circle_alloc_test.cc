@@ -0,0 +1,135 @@
+﻿#include "awtk.h"
+#include "widgets/view.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "slider_circle/slider_circle.h"
+#include "alloc_hook.h"
+#include "gtest/gtest.h"
+
+/*检查稳定状态下(预热之后)的常用操作不分配内存：设置值、拖动和带文本的绘制*/
+
+#define ALLOC_WIDGET_SIZE 200
+#define ALLOC_STEPS 101
+
+typedef struct _alloc_scene_t {
+  canvas_t c;
+  lcd_t* lcd;
+  widget_t* root;
+  widget_t* widget;
+} alloc_scene_t;
+
+static void alloc_scene_init(alloc_scene_t* scene) {
+  memset(scene, 0x00, sizeof(*scene));
+  scene->lcd = lcd_mem_bgra8888_create(ALLOC_WIDGET_SIZE, ALLOC_WIDGET_SIZE, TRUE);
+  scene->root = view_create(NULL, 0, 0, ALLOC_WIDGET_SIZE, ALLOC_WIDGET_SIZE);
+  scene->widget = slider_circle_create(scene->root, 0, 0, ALLOC_WIDGET_SIZE, ALLOC_WIDGET_SIZE);
+  canvas_init(&(scene->c), scene->lcd, font_manager());
+
+  slider_circle_set_show_text(scene->widget, TRUE);
+  slider_circle_set_format(scene->widget, "%d%%");
+  widget_set_style_color(scene->widget, "normal:fg_color", 0xff00ff00);
+  widget_set_style_color(scene->widget, "normal:bg_color", 0xff808080);
+  widget_set_style_color(scene->widget, "normal:text_color", 0xffffffff);
+}
+
+static void alloc_scene_deinit(alloc_scene_t* scene) {
+  canvas_reset(&(scene->c));
+  widget_destroy(scene->root);
+  lcd_destroy(scene->lcd);
+}
+
+static void alloc_scene_paint(alloc_scene_t* scene) {
+  rect_t r = rect_init(0, 0, ALLOC_WIDGET_SIZE, ALLOC_WIDGET_SIZE);
+
+  canvas_begin_frame(&(scene->c), &r, LCD_DRAW_OFFLINE);
+  widget_paint(scene->root, &(scene->c));
+  canvas_end_frame(&(scene->c));
+}
+
+/*每个值设置一次并绘制(文本中的每个字形都会用到)*/
+static void alloc_scene_set_values(alloc_scene_t* scene, bool_t paint) {
+  uint32_t i = 0;
+
+  for (i = 0; i < ALLOC_STEPS; i++) {
+    slider_circle_set_value(scene->widget, i);
+    if (paint) {
+      alloc_scene_paint(scene);
+    }
+  }
+}
+
+static void alloc_scene_pointer(alloc_scene_t* scene, uint32_t type, double angle) {
+  pointer_event_t evt;
+  float_t r = ALLOC_WIDGET_SIZE / 2 - SLIDER_CIRCLE(scene->widget)->bg_line_width / 2;
+  xy_t x = tk_roundi(ALLOC_WIDGET_SIZE / 2 + r * cos(angle));
+  xy_t y = tk_roundi(ALLOC_WIDGET_SIZE / 2 + r * sin(angle));
+
+  pointer_event_init(&evt, type, scene->widget, x, y);
+  evt.pressed = type != EVT_POINTER_UP;
+  widget_dispatch(scene->widget, (event_t*)&evt);
+}
+
+/*从当前值的位置按下，沿圆弧拖动一圈，再松开*/
+static void alloc_scene_drag(alloc_scene_t* scene) {
+  uint32_t i = 0;
+  double angle = slider_circle_value_to_angle(scene->widget, 0);
+
+  slider_circle_set_value(scene->widget, 0);
+  alloc_scene_pointer(scene, EVT_POINTER_DOWN, angle);
+  for (i = 0; i < ALLOC_STEPS; i++) {
+    angle = slider_circle_value_to_angle(scene->widget, i);
+    alloc_scene_pointer(scene, EVT_POINTER_MOVE, angle);
+    alloc_scene_paint(scene);
+  }
+  alloc_scene_pointer(scene, EVT_POINTER_UP, angle);
+  alloc_scene_paint(scene);
+}
+
+#define ALLOC_CHECK_SUPPORTED()                                               \
+  if (!alloc_hook_supported()) {                                              \
+    log_info("slider_circle_alloc: malloc hook is not supported, skipped\n"); \
+    return;                                                                   \
+  }
+
+TEST(slider_circle_alloc, set_value) {
+  alloc_scene_t scene;
+  ALLOC_CHECK_SUPPORTED();
+
+  alloc_scene_init(&scene);
+  alloc_scene_set_values(&scene, FALSE);
+
+  alloc_hook_start();
+  alloc_scene_set_values(&scene, FALSE);
+  ASSERT_EQ(alloc_hook_stop("set_value"), 0u);
+
+  alloc_scene_deinit(&scene);
+}
+
+TEST(slider_circle_alloc, paint_text) {
+  alloc_scene_t scene;
+  ALLOC_CHECK_SUPPORTED();
+
+  /*第一轮加载字体、缓存字形和样式*/
+  alloc_scene_init(&scene);
+  alloc_scene_set_values(&scene, TRUE);
+
+  alloc_hook_start();
+  alloc_scene_set_values(&scene, TRUE);
+  ASSERT_EQ(alloc_hook_stop("paint_text"), 0u);
+
+  alloc_scene_deinit(&scene);
+}
+
+TEST(slider_circle_alloc, drag) {
+  alloc_scene_t scene;
+  ALLOC_CHECK_SUPPORTED();
+
+  alloc_scene_init(&scene);
+  alloc_scene_drag(&scene);
+  ASSERT_GE(widget_get_prop_int(scene.widget, WIDGET_PROP_VALUE, 0), ALLOC_STEPS - 10);
+
+  alloc_hook_start();
+  alloc_scene_drag(&scene);
+  ASSERT_EQ(alloc_hook_stop("drag"), 0u);
+
+  alloc_scene_deinit(&scene);
+}
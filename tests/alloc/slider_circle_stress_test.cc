@@ -0,0 +1,206 @@
+﻿#include "awtk.h"
+#include "tkc/str.h"
+#include "widgets/view.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "slider_circle_register.h"
+#include "slider_circle/slider_circle.h"
+#include "alloc_hook.h"
+#include "gtest/gtest.h"
+
+/*
+ * 整屏切换的压力测试：创建(slider_circle_create或者XML)、布局、绘制一次、销毁大量的控件，
+ * 输出每个控件的耗时、堆的峰值、每个控件占用的堆和销毁之后留下的堆。
+ */
+
+#define STRESS_WIDGETS_NR 10000
+#define STRESS_WARMUP_NR 100
+#define STRESS_SCREEN_W 800
+#define STRESS_SCREEN_H 480
+#define STRESS_WIDGET_SIZE 100
+
+/*每个控件(对象、字符串和缓存)最多占用的堆，超过时说明对象变大了或者每个控件多了分配*/
+#define STRESS_MAX_BYTES_PER_WIDGET 2048
+
+/*销毁之后允许留下的堆(与控件的数量无关，如AWTK内部的缓存)，超过时一般是有泄漏*/
+#define STRESS_MAX_LEFTOVER_BYTES 4096
+
+typedef widget_t* (*stress_build_t)(uint32_t nr, void* ctx);
+
+typedef struct _stress_scene_t {
+  canvas_t c;
+  lcd_t* lcd;
+} stress_scene_t;
+
+typedef struct _stress_result_t {
+  uint64_t create_us;
+  uint64_t paint_us;
+  uint64_t destroy_us;
+  /*创建和布局之后*/
+  alloc_hook_stats_t created;
+  /*销毁之后*/
+  alloc_hook_stats_t destroyed;
+} stress_result_t;
+
+/*控件按格子排满一屏，超出一屏之后重叠，每个控件都会绘制*/
+static void stress_cell(uint32_t i, xy_t* x, xy_t* y) {
+  uint32_t cols = STRESS_SCREEN_W / STRESS_WIDGET_SIZE;
+  uint32_t rows = STRESS_SCREEN_H / STRESS_WIDGET_SIZE;
+
+  *x = (i % cols) * STRESS_WIDGET_SIZE;
+  *y = ((i / cols) % rows) * STRESS_WIDGET_SIZE;
+}
+
+static widget_t* stress_build_create(uint32_t nr, void* ctx) {
+  uint32_t i = 0;
+  widget_t* root = view_create(NULL, 0, 0, STRESS_SCREEN_W, STRESS_SCREEN_H);
+  (void)ctx;
+
+  for (i = 0; i < nr; i++) {
+    xy_t x = 0;
+    xy_t y = 0;
+    widget_t* w = NULL;
+
+    stress_cell(i, &x, &y);
+    w = slider_circle_create(root, x, y, STRESS_WIDGET_SIZE, STRESS_WIDGET_SIZE);
+    slider_circle_set_value(w, i % 101);
+    slider_circle_set_line_cap(w, "round");
+  }
+
+  return root;
+}
+
+static ret_t stress_xml_init(str_t* xml, uint32_t nr) {
+  uint32_t i = 0;
+
+  return_value_if_fail(str_init(xml, nr * 96) != NULL, RET_OOM);
+  str_append_format(xml, 64, "<view x=\"0\" y=\"0\" w=\"%d\" h=\"%d\">\n", STRESS_SCREEN_W,
+                    STRESS_SCREEN_H);
+  for (i = 0; i < nr; i++) {
+    xy_t x = 0;
+    xy_t y = 0;
+
+    stress_cell(i, &x, &y);
+    str_append_format(xml, 128,
+                      "<slider_circle x=\"%d\" y=\"%d\" w=\"%d\" h=\"%d\" value=\"%u\" "
+                      "line_cap=\"round\"/>\n",
+                      x, y, STRESS_WIDGET_SIZE, STRESS_WIDGET_SIZE, i % 101);
+  }
+
+  return str_append(xml, "</view>\n");
+}
+
+/*通过slider_circle_register注册的widget_factory创建控件*/
+static widget_t* stress_build_xml(uint32_t nr, void* ctx) {
+  str_t* xml = (str_t*)ctx;
+  ui_builder_t* builder = ui_builder_default_create("slider_circle_stress");
+  (void)nr;
+
+  ui_loader_load(xml_ui_loader(), (const uint8_t*)(xml->str), xml->size, builder);
+
+  return builder->root;
+}
+
+static void stress_scene_init(stress_scene_t* scene) {
+  memset(scene, 0x00, sizeof(*scene));
+  scene->lcd = lcd_mem_bgra8888_create(STRESS_SCREEN_W, STRESS_SCREEN_H, TRUE);
+  canvas_init(&(scene->c), scene->lcd, font_manager());
+}
+
+static void stress_scene_deinit(stress_scene_t* scene) {
+  canvas_reset(&(scene->c));
+  lcd_destroy(scene->lcd);
+}
+
+static void stress_run(stress_scene_t* scene, stress_build_t build, void* ctx, uint32_t nr,
+                       stress_result_t* result) {
+  uint64_t start = 0;
+  widget_t* root = NULL;
+  rect_t r = rect_init(0, 0, STRESS_SCREEN_W, STRESS_SCREEN_H);
+
+  memset(result, 0x00, sizeof(*result));
+  alloc_hook_measure_start();
+
+  start = time_now_us();
+  root = build(nr, ctx);
+  ASSERT_TRUE(root != NULL);
+  ASSERT_EQ(widget_count_children(root), (int32_t)nr);
+  widget_layout(root);
+  result->create_us = time_now_us() - start;
+  alloc_hook_measure_get(&(result->created));
+
+  start = time_now_us();
+  canvas_begin_frame(&(scene->c), &r, LCD_DRAW_OFFLINE);
+  widget_paint(root, &(scene->c));
+  canvas_end_frame(&(scene->c));
+  result->paint_us = time_now_us() - start;
+
+  start = time_now_us();
+  widget_destroy(root);
+  result->destroy_us = time_now_us() - start;
+  alloc_hook_measure_stop(&(result->destroyed));
+}
+
+static void stress_report(const char* name, uint32_t nr, const stress_result_t* result) {
+  log_info("stress %s: %u widgets, per widget: create+layout %.2f us, paint %.2f us, "
+           "destroy %.2f us\n",
+           name, nr, (double)(result->create_us) / nr, (double)(result->paint_us) / nr,
+           (double)(result->destroy_us) / nr);
+
+  if (!alloc_hook_supported()) {
+    log_info("stress %s: malloc hook is not supported, heap usage skipped\n", name);
+    return;
+  }
+
+  log_info("stress %s: heap peak %lld KB, %lld bytes per widget, %lld bytes left after destroy "
+           "(%u allocs, %u frees)\n",
+           name, (long long)(result->destroyed.peak_bytes / 1024),
+           (long long)(result->created.bytes / nr), (long long)(result->destroyed.bytes),
+           result->destroyed.allocs, result->destroyed.frees);
+}
+
+static void stress_check(uint32_t nr, const stress_result_t* result) {
+  if (!alloc_hook_supported()) {
+    return;
+  }
+
+  ASSERT_LE(result->created.bytes / nr, STRESS_MAX_BYTES_PER_WIDGET);
+  ASSERT_LE(result->destroyed.bytes, STRESS_MAX_LEFTOVER_BYTES);
+}
+
+TEST(slider_circle_stress, create) {
+  stress_scene_t scene;
+  stress_result_t result;
+
+  /*第一轮加载字体、缓存字形和样式，创建vgcanvas*/
+  stress_scene_init(&scene);
+  stress_run(&scene, stress_build_create, NULL, STRESS_WARMUP_NR, &result);
+
+  stress_run(&scene, stress_build_create, NULL, STRESS_WIDGETS_NR, &result);
+  stress_report("slider_circle_create", STRESS_WIDGETS_NR, &result);
+  stress_check(STRESS_WIDGETS_NR, &result);
+
+  stress_scene_deinit(&scene);
+}
+
+TEST(slider_circle_stress, xml) {
+  str_t xml;
+  str_t warmup;
+  stress_scene_t scene;
+  stress_result_t result;
+
+  ASSERT_EQ(slider_circle_register(), RET_OK);
+  ASSERT_EQ(stress_xml_init(&warmup, STRESS_WARMUP_NR), RET_OK);
+  ASSERT_EQ(stress_xml_init(&xml, STRESS_WIDGETS_NR), RET_OK);
+
+  stress_scene_init(&scene);
+  stress_run(&scene, stress_build_xml, &warmup, STRESS_WARMUP_NR, &result);
+
+  stress_run(&scene, stress_build_xml, &xml, STRESS_WIDGETS_NR, &result);
+  stress_report("xml", STRESS_WIDGETS_NR, &result);
+  stress_check(STRESS_WIDGETS_NR, &result);
+
+  stress_scene_deinit(&scene);
+  str_reset(&xml);
+  str_reset(&warmup);
+  slider_circle_sprite_cache_deinit();
+}
@@ -0,0 +1,95 @@
+﻿#include "widgets/view.h"
+#include "slider_circle/gauge_circle.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "gtest/gtest.h"
+
+TEST(gauge_circle, basic) {
+  widget_t* w = gauge_circle_create(NULL, 10, 20, 100, 100);
+  slider_circle_t* s = GAUGE_CIRCLE(w);
+  value_t v;
+
+  ASSERT_TRUE(s != NULL);
+  ASSERT_EQ(SLIDER_CIRCLE(w), s);
+  ASSERT_STREQ(widget_get_type(w), WIDGET_TYPE_GAUGE_CIRCLE);
+  ASSERT_EQ(w->vt->size, TK_REF_VTABLE(slider_circle)->size);
+  ASSERT_FALSE(w->vt->inputable);
+  ASSERT_FALSE(w->sensitive);
+
+  /*不可输入，拖动用的函数直接失败*/
+  ASSERT_FALSE(slider_circle_is_point_in_dragger(w, 60, 20));
+  ASSERT_EQ(slider_circle_point_to_value(w, 60, 20), 0);
+  ASSERT_EQ(slider_circle_angle_to_value(w, 180), 0);
+
+  /*与slider_circle共用设置函数和属性*/
+  ASSERT_EQ(slider_circle_set_value(w, 30), RET_OK);
+  ASSERT_EQ(s->value, 30);
+  ASSERT_EQ(widget_set_prop_int(w, WIDGET_PROP_VALUE, 40), RET_OK);
+  ASSERT_EQ(widget_get_prop_int(w, WIDGET_PROP_VALUE, 0), 40);
+  ASSERT_EQ(widget_get_prop(w, WIDGET_PROP_INPUTING, &v), RET_OK);
+  ASSERT_FALSE(value_bool(&v));
+  ASSERT_TRUE(slider_circle_cast(w) != NULL);
+
+  widget_destroy(w);
+}
+
+TEST(gauge_circle, paint_angle) {
+  canvas_t c;
+  rect_t r = rect_init(0, 0, 100, 100);
+  lcd_t* lcd = lcd_mem_bgra8888_create(100, 100, TRUE);
+  widget_t* g = gauge_circle_create(NULL, 0, 0, 100, 100);
+  widget_t* s = slider_circle_create(NULL, 0, 0, 100, 100);
+
+  slider_circle_set_value(g, 50);
+  slider_circle_set_value(s, 50);
+  canvas_init(&c, lcd, font_manager());
+
+  /*绘制用的角度与slider_circle一样，不是起始角度*/
+  ASSERT_NE(slider_circle_value_to_angle(g, 50), slider_circle_value_to_angle(g, 0));
+  ASSERT_EQ(slider_circle_value_to_angle(g, 50), slider_circle_value_to_angle(s, 50));
+
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  widget_paint(g, &c);
+  widget_paint(s, &c);
+  canvas_end_frame(&c);
+  ASSERT_TRUE(SLIDER_CIRCLE(g)->render_key_valid);
+  ASSERT_NE(SLIDER_CIRCLE(g)->render_key.arc_end, 0);
+  ASSERT_EQ(SLIDER_CIRCLE(g)->render_key.arc_end, SLIDER_CIRCLE(s)->render_key.arc_end);
+
+  widget_destroy(g);
+  widget_destroy(s);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
+
+TEST(gauge_circle, cast) {
+  widget_t* w = slider_circle_create(NULL, 10, 20, 100, 100);
+
+  ASSERT_TRUE(gauge_circle_cast(w) == NULL);
+
+  widget_destroy(w);
+}
+
+TEST(gauge_circle, pass_through) {
+  widget_t* root = view_create(NULL, 0, 0, 200, 200);
+  widget_t* below = slider_circle_create(root, 0, 0, 200, 200);
+  widget_t* gauge = gauge_circle_create(root, 0, 0, 200, 200);
+
+  /*指针事件穿透到后面的控件*/
+  ASSERT_EQ(widget_find_target(root, 100, 100), below);
+  ASSERT_TRUE(gauge != NULL);
+
+  widget_destroy(root);
+}
+
+TEST(gauge_circle, clone) {
+  widget_t* w = gauge_circle_create(NULL, 10, 20, 100, 100);
+  widget_t* c = NULL;
+
+  slider_circle_set_value(w, 20);
+  c = widget_clone(w, NULL);
+  ASSERT_TRUE(gauge_circle_cast(c) != NULL);
+  ASSERT_EQ(SLIDER_CIRCLE(c)->value, 20);
+
+  widget_destroy(c);
+  widget_destroy(w);
+}
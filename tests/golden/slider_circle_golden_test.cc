@@ -0,0 +1,295 @@
+﻿#include "awtk.h"
+#include "tkc/time_now.h"
+#include "lcd/lcd_mem_bgr565.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "lcd/lcd_mono.h"
+#include "slider_circle_register.h"
+#include "slider_circle/slider_circle.h"
+#include "slider_circle/slider_circle_direct.h"
+#include "gtest/gtest.h"
+
+/*
+ * 把design/default/ui/main.xml中的每个slider_circle分别绘制到各种格式的内存画布上，
+ * 记录每个配置的绘制时间，并把直接绘制的结果与vgcanvas绘制的结果逐像素比较。
+ *
+ * 环境变量：
+ * SLIDER_CIRCLE_GOLDEN_REPORT     绘制时间报告的文件名(缺省为golden_report.csv)。
+ */
+
+#define GOLDEN_PAINT_TIMES 20
+
+typedef struct _golden_header_t {
+  uint16_t w;
+  uint16_t h;
+  uint16_t format;
+  uint16_t line_length;
+} golden_header_t;
+
+typedef struct _golden_format_t {
+  const char* name;
+  bitmap_format_t format;
+} golden_format_t;
+
+static const golden_format_t s_golden_formats[] = {
+    {"bgr565", BITMAP_FMT_BGR565},
+    {"bgra8888", BITMAP_FMT_BGRA8888},
+    {"mono", BITMAP_FMT_MONO},
+};
+
+static const char* golden_env(const char* name, const char* defval) {
+  const char* value = getenv(name);
+
+  return (value != NULL && *value) ? value : defval;
+}
+
+static lcd_t* golden_lcd_create(bitmap_format_t format, wh_t w, wh_t h) {
+  switch (format) {
+    case BITMAP_FMT_BGR565:
+      return lcd_mem_bgr565_create(w, h, TRUE);
+    case BITMAP_FMT_BGRA8888:
+      return lcd_mem_bgra8888_create(w, h, TRUE);
+    case BITMAP_FMT_MONO:
+      return lcd_mono_create(w, h, NULL, NULL, NULL);
+    default:
+      return NULL;
+  }
+}
+
+static uint8_t* golden_lcd_get_fb(lcd_t* lcd, bitmap_format_t format, uint32_t* line_length) {
+  if (format == BITMAP_FMT_MONO) {
+    *line_length = TK_BITMAP_MONO_LINE_LENGTH(lcd->w);
+    return ((lcd_mono_t*)lcd)->data;
+  } else {
+    lcd_mem_t* mem = (lcd_mem_t*)lcd;
+    *line_length = mem->line_length;
+    return mem->offline_fb;
+  }
+}
+
+static color_t golden_get_pixel(const uint8_t* data, uint32_t line_length, bitmap_format_t format,
+                                uint32_t x, uint32_t y) {
+  const uint8_t* p = data + y * line_length;
+
+  switch (format) {
+    case BITMAP_FMT_BGR565: {
+      uint16_t v = ((const uint16_t*)p)[x];
+      return color_init((v & 0x1f) << 3, ((v >> 5) & 0x3f) << 2, (v >> 11) << 3, 0xff);
+    }
+    case BITMAP_FMT_BGRA8888: {
+      p += x * 4;
+      return color_init(p[2], p[1], p[0], p[3]);
+    }
+    case BITMAP_FMT_MONO: {
+      uint8_t v = (p[x >> 3] & (0x80 >> (x & 7))) ? 0xff : 0;
+      return color_init(v, v, v, 0xff);
+    }
+    default:
+      return color_init(0, 0, 0, 0);
+  }
+}
+
+static uint32_t golden_compare(const uint8_t* expected, const uint8_t* actual,
+                               const golden_header_t* header, uint32_t tolerance,
+                               uint32_t* max_diff) {
+  uint32_t x = 0;
+  uint32_t y = 0;
+  uint32_t bad = 0;
+  bitmap_format_t format = (bitmap_format_t)(header->format);
+
+  *max_diff = 0;
+  for (y = 0; y < header->h; y++) {
+    for (x = 0; x < header->w; x++) {
+      color_t e = golden_get_pixel(expected, header->line_length, format, x, y);
+      color_t a = golden_get_pixel(actual, header->line_length, format, x, y);
+      uint32_t d = tk_max(tk_max(tk_abs(e.rgba.r - a.rgba.r), tk_abs(e.rgba.g - a.rgba.g)),
+                          tk_max(tk_abs(e.rgba.b - a.rgba.b), tk_abs(e.rgba.a - a.rgba.a)));
+
+      *max_diff = tk_max(*max_diff, d);
+      if (d > tolerance) {
+        bad++;
+      }
+    }
+  }
+
+  return bad;
+}
+
+static uint64_t golden_paint(widget_t* widget, lcd_t* lcd) {
+  canvas_t c;
+  uint64_t start = 0;
+  rect_t r = rect_init(0, 0, widget->w, widget->h);
+
+  canvas_init(&c, lcd, font_manager());
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  canvas_set_fill_color(&c, color_init(0xff, 0xff, 0xff, 0xff));
+  canvas_fill_rect(&c, 0, 0, widget->w, widget->h);
+
+  /*widget_paint会平移到控件的位置，这里先反向平移，让控件画在画布的左上角*/
+  canvas_translate(&c, -widget->x, -widget->y);
+  start = time_now_us();
+  widget_paint(widget, &c);
+  start = time_now_us() - start;
+  canvas_untranslate(&c, -widget->x, -widget->y);
+
+  canvas_end_frame(&c);
+  canvas_reset(&c);
+
+  return start;
+}
+
+static ret_t golden_collect(void* ctx, const void* data) {
+  widget_t* widget = WIDGET(data);
+
+  if (tk_str_eq(widget_get_type(widget), WIDGET_TYPE_SLIDER_CIRCLE)) {
+    darray_push((darray_t*)ctx, widget);
+  }
+
+  return RET_OK;
+}
+
+static void golden_run(const golden_format_t* fmt, str_t* report) {
+  uint32_t i = 0;
+  darray_t widgets;
+  widget_t* win = NULL;
+
+  slider_circle_register();
+  win = window_open("main");
+  ASSERT_TRUE(win != NULL);
+  widget_layout(win);
+
+  darray_init(&widgets, 64, NULL, NULL);
+  widget_foreach(win, golden_collect, &widgets);
+  ASSERT_GT(widgets.size, 0u);
+
+  for (i = 0; i < widgets.size; i++) {
+    uint32_t k = 0;
+    uint64_t cost = 0;
+    uint64_t min_cost = 0;
+    widget_t* widget = WIDGET(widgets.elms[i]);
+    lcd_t* lcd = golden_lcd_create(fmt->format, widget->w, widget->h);
+    ASSERT_TRUE(lcd != NULL);
+
+    /*第一次绘制会加载字体和图片，不计入时间*/
+    golden_paint(widget, lcd);
+    for (k = 0; k < GOLDEN_PAINT_TIMES; k++) {
+      uint64_t t = golden_paint(widget, lcd);
+      cost += t;
+      min_cost = (k == 0 || t < min_cost) ? t : min_cost;
+    }
+
+    str_append_format(report, 256, "%s,%u,%d,%d,%llu,%llu\n", fmt->name, i, widget->w,
+                      widget->h, (unsigned long long)(cost / GOLDEN_PAINT_TIMES),
+                      (unsigned long long)min_cost);
+    lcd_destroy(lcd);
+  }
+
+  darray_deinit(&widgets);
+  window_close_force(win);
+  slider_circle_sprite_cache_deinit();
+}
+
+static void golden_run_format(const golden_format_t* fmt) {
+  static str_t s_report;
+  const char* filename = golden_env("SLIDER_CIRCLE_GOLDEN_REPORT", "golden_report.csv");
+
+  if (s_report.str == NULL) {
+    str_init(&s_report, 1024);
+    str_append(&s_report, "format,index,w,h,avg_us,min_us\n");
+  }
+
+  golden_run(fmt, &s_report);
+  file_write(filename, s_report.str, s_report.size);
+  log_info("%s", s_report.str);
+}
+
+TEST(slider_circle_golden, bgr565) {
+  golden_run_format(s_golden_formats + 0);
+}
+
+TEST(slider_circle_golden, bgra8888) {
+  golden_run_format(s_golden_formats + 1);
+}
+
+TEST(slider_circle_golden, mono) {
+  golden_run_format(s_golden_formats + 2);
+}
+
+/*
+ * 直接绘制(slider_circle_direct.h)和vgcanvas绘制的结果逐像素比较。
+ * 两者的抗锯齿算法不同，边缘像素允许有误差：
+ * SLIDER_CIRCLE_DIRECT_TOLERANCE  每个像素每个通道允许的误差(缺省为64)。
+ * SLIDER_CIRCLE_DIRECT_BAD_RATIO  超过误差的像素占比的上限(千分比，缺省为10)。
+ */
+static void golden_direct_run(const golden_format_t* fmt) {
+  uint32_t i = 0;
+  darray_t widgets;
+  widget_t* win = NULL;
+  uint32_t tolerance = tk_atoi(golden_env("SLIDER_CIRCLE_DIRECT_TOLERANCE", "64"));
+  uint32_t bad_ratio = tk_atoi(golden_env("SLIDER_CIRCLE_DIRECT_BAD_RATIO", "10"));
+
+  slider_circle_register();
+  win = window_open("main");
+  ASSERT_TRUE(win != NULL);
+  widget_layout(win);
+
+  darray_init(&widgets, 64, NULL, NULL);
+  widget_foreach(win, golden_collect, &widgets);
+
+  for (i = 0; i < widgets.size; i++) {
+    uint32_t k = 0;
+    uint32_t bad = 0;
+    uint32_t size = 0;
+    uint32_t max_diff = 0;
+    uint64_t direct_cost = 0;
+    uint64_t vg_cost = 0;
+    uint8_t* fb = NULL;
+    uint8_t* expected = NULL;
+    golden_header_t header;
+    widget_t* widget = WIDGET(widgets.elms[i]);
+    lcd_t* lcd = golden_lcd_create(fmt->format, widget->w, widget->h);
+    ASSERT_TRUE(lcd != NULL);
+
+    fb = golden_lcd_get_fb(lcd, fmt->format, &size);
+    memset(&header, 0x00, sizeof(header));
+    header.w = widget->w;
+    header.h = widget->h;
+    header.format = fmt->format;
+    header.line_length = size;
+
+    slider_circle_direct_set_enabled(FALSE);
+    golden_paint(widget, lcd);
+    for (k = 0; k < GOLDEN_PAINT_TIMES; k++) {
+      vg_cost += golden_paint(widget, lcd);
+    }
+    expected = (uint8_t*)TKMEM_ALLOC(size * widget->h);
+    ASSERT_TRUE(expected != NULL);
+    memcpy(expected, fb, size * widget->h);
+
+    slider_circle_direct_set_enabled(TRUE);
+    for (k = 0; k < GOLDEN_PAINT_TIMES; k++) {
+      direct_cost += golden_paint(widget, lcd);
+    }
+
+    bad = golden_compare(expected, fb, &header, tolerance, &max_diff);
+    log_info("direct: %s %02u %dx%d vgcanvas %llu us direct %llu us bad %u max diff %u\n",
+             fmt->name, i, widget->w, widget->h,
+             (unsigned long long)(vg_cost / GOLDEN_PAINT_TIMES),
+             (unsigned long long)(direct_cost / GOLDEN_PAINT_TIMES), bad, max_diff);
+    ASSERT_LE(bad * 1000, header.w * header.h * bad_ratio);
+
+    TKMEM_FREE(expected);
+    lcd_destroy(lcd);
+  }
+
+  darray_deinit(&widgets);
+  window_close_force(win);
+  slider_circle_sprite_cache_deinit();
+}
+
+TEST(slider_circle_golden, direct_bgr565) {
+  golden_direct_run(s_golden_formats + 0);
+}
+
+TEST(slider_circle_golden, direct_bgra8888) {
+  golden_direct_run(s_golden_formats + 1);
+}
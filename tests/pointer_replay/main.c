@@ -0,0 +1,136 @@
+﻿/**
+ * File:   main.c
+ * Author: AWTK Develop Team
+ * Brief:  回放录制的指针事件，输出延迟、耗时、脏区域和值序列。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-14 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "awtk.h"
+#include "base/system_info.h"
+#include "demos/assets.h"
+#include "slider_circle_register.h"
+#include "slider_circle/slider_circle.h"
+#include "pointer_replay.h"
+
+static void show_usage(const char* app) {
+  printf("Usage: %s trace_file [-p name=value]... [-o values_file]\n", app);
+  printf("  -p 设置slider_circle的属性(如 -p start_angle=120 -p end_angle=420)\n");
+  printf("  -o 把每个事件之后的值写入文件(每行一个)，用于比较两次回放的结果\n");
+}
+
+static ret_t apply_prop(widget_t* widget, const char* prop) {
+  char name[TK_NAME_LEN + 1];
+  const char* value = strchr(prop, '=');
+  return_value_if_fail(value != NULL, RET_BAD_PARAMS);
+
+  tk_strncpy(name, prop, tk_min(value - prop, TK_NAME_LEN));
+  return widget_set_prop_str(widget, name, value + 1);
+}
+
+static ret_t save_values(const char* filename, const pointer_replay_result_t* result) {
+  str_t str;
+  ret_t ret = RET_OK;
+  uint32_t i = 0;
+
+  str_init(&str, result->values_nr * 8 + 1);
+  for (i = 0; i < result->values_nr; i++) {
+    str_append_format(&str, 64, "%g\n", result->values[i]);
+  }
+  ret = file_write(filename, str.str, str.size);
+  str_reset(&str);
+
+  return ret;
+}
+
+static void show_result(const pointer_replay_result_t* result) {
+  printf("events:        %u (%u ms recorded)\n", result->events, result->duration);
+  printf("handler:       avg %.1f us, max %llu us\n",
+         result->events ? (double)result->handler_us / result->events : 0.0,
+         (unsigned long long)result->handler_max_us);
+  printf("event->paint:  avg %.1f us, max %llu us (%u paints)\n",
+         result->paints ? (double)result->latency_us / result->paints : 0.0,
+         (unsigned long long)result->latency_max_us, result->paints);
+  printf("invalidates:   %u, dirty area %llu px\n", result->invalidates,
+         (unsigned long long)result->dirty_area);
+  if (result->values_nr > 0) {
+    printf("final value:   %g\n", result->values[result->values_nr - 1]);
+  }
+}
+
+int main(int argc, char* argv[]) {
+  int i = 0;
+  int ret = 0;
+  widget_t* target = NULL;
+  const char* values_file = NULL;
+  pointer_replay_t* replay = NULL;
+  pointer_replay_result_t result;
+  slider_circle_pointer_trace_t trace;
+
+  if (argc < 2) {
+    show_usage(argv[0]);
+    return 1;
+  }
+
+  platform_prepare();
+  system_info_init(APP_SIMULATOR, NULL, "./");
+  tk_init_internal();
+  tk_init_assets();
+  slider_circle_register();
+
+  slider_circle_pointer_trace_init(&trace);
+  if (slider_circle_pointer_trace_load(&trace, argv[1]) != RET_OK || trace.size == 0) {
+    printf("load %s failed\n", argv[1]);
+    ret = 1;
+    goto done;
+  }
+
+  replay = pointer_replay_create(trace.w, trace.h);
+  target = slider_circle_create(replay->root, 0, 0, trace.w, trace.h);
+  for (i = 2; i < argc; i++) {
+    if (tk_str_eq(argv[i], "-p") && i + 1 < argc) {
+      apply_prop(target, argv[++i]);
+    } else if (tk_str_eq(argv[i], "-o") && i + 1 < argc) {
+      values_file = argv[++i];
+    } else {
+      show_usage(argv[0]);
+      ret = 1;
+      goto done;
+    }
+  }
+
+  if (pointer_replay_run(replay, target, &trace, &result) == RET_OK) {
+    show_result(&result);
+    printf("backend:       %s\n",
+           widget_get_prop_str(target, SLIDER_CIRCLE_PROP_ACTIVE_BACKEND, ""));
+    if (values_file != NULL) {
+      save_values(values_file, &result);
+    }
+    pointer_replay_result_deinit(&result);
+  } else {
+    ret = 1;
+  }
+
+done:
+  if (replay != NULL) {
+    pointer_replay_destroy(replay);
+  }
+  slider_circle_pointer_trace_deinit(&trace);
+  slider_circle_sprite_cache_deinit();
+  tk_deinit_internal();
+
+  return ret;
+}
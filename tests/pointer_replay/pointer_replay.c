@@ -0,0 +1,183 @@
+﻿/**
+ * File:   pointer_replay.c
+ * Author: AWTK Develop Team
+ * Brief:  在内存画布上回放指针事件，测量事件处理和重绘的耗时。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-14 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#include "tkc/mem.h"
+#include "tkc/utils.h"
+#include "tkc/time_now.h"
+#include "base/canvas.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "pointer_replay.h"
+
+typedef struct _pointer_replay_root_t {
+  widget_t widget;
+  pointer_replay_t* replay;
+} pointer_replay_root_t;
+
+static const uint32_t s_replay_events[] = {EVT_POINTER_DOWN, EVT_POINTER_MOVE, EVT_POINTER_UP,
+                                           EVT_POINTER_DOWN_ABORT};
+
+static ret_t pointer_replay_root_invalidate(widget_t* widget, const rect_t* r) {
+  rect_t dirty;
+  pointer_replay_t* replay = ((pointer_replay_root_t*)widget)->replay;
+
+  dirty = r != NULL ? *r : rect_init(0, 0, widget->w, widget->h);
+  if (dirty.w <= 0 || dirty.h <= 0) {
+    return RET_OK;
+  }
+
+  replay->invalidates++;
+  if (replay->dirty.w == 0 || replay->dirty.h == 0) {
+    replay->dirty = dirty;
+  } else {
+    rect_merge(&(replay->dirty), &dirty);
+  }
+
+  return RET_OK;
+}
+
+static const widget_vtable_t s_pointer_replay_root_vtable = {
+    .size = sizeof(pointer_replay_root_t),
+    .type = "pointer_replay_root",
+    .parent = TK_PARENT_VTABLE(widget),
+    .invalidate = pointer_replay_root_invalidate};
+
+pointer_replay_t* pointer_replay_create(wh_t w, wh_t h) {
+  pointer_replay_t* replay = TKMEM_ZALLOC(pointer_replay_t);
+  return_value_if_fail(replay != NULL, NULL);
+
+  replay->lcd = lcd_mem_bgra8888_create(w, h, TRUE);
+  replay->root = widget_create(NULL, &s_pointer_replay_root_vtable, 0, 0, w, h);
+  if (replay->lcd == NULL || replay->root == NULL) {
+    pointer_replay_destroy(replay);
+    return NULL;
+  }
+  ((pointer_replay_root_t*)(replay->root))->replay = replay;
+
+  return replay;
+}
+
+static ret_t pointer_replay_paint(pointer_replay_t* replay) {
+  canvas_t c;
+
+  canvas_init(&c, replay->lcd, font_manager());
+  canvas_begin_frame(&c, &(replay->dirty), LCD_DRAW_OFFLINE);
+  widget_paint(replay->root, &c);
+  canvas_end_frame(&c);
+  canvas_reset(&c);
+
+  return RET_OK;
+}
+
+static double pointer_replay_get_value(widget_t* widget) {
+  value_t v;
+
+  if (widget_get_prop(widget, WIDGET_PROP_VALUE, &v) == RET_OK) {
+    return value_double(&v);
+  }
+
+  return 0;
+}
+
+ret_t pointer_replay_run(pointer_replay_t* replay, widget_t* target,
+                         const slider_circle_pointer_trace_t* trace,
+                         pointer_replay_result_t* result) {
+  uint32_t i = 0;
+  return_value_if_fail(replay != NULL && target != NULL, RET_BAD_PARAMS);
+  return_value_if_fail(trace != NULL && result != NULL, RET_BAD_PARAMS);
+
+  memset(result, 0x00, sizeof(*result));
+  result->values = TKMEM_ZALLOCN(double, trace->size + 1);
+  return_value_if_fail(result->values != NULL, RET_OOM);
+
+  /*先把初始状态画出来，不计入结果*/
+  replay->dirty = rect_init(0, 0, replay->root->w, replay->root->h);
+  pointer_replay_paint(replay);
+
+  for (i = 0; i < trace->size; i++) {
+    pointer_event_t evt;
+    uint64_t start = 0;
+    uint64_t handled = 0;
+    point_t p = {0, 0};
+    const slider_circle_pointer_record_t* record = trace->records + i;
+
+    if (record->type >= ARRAY_SIZE(s_replay_events)) {
+      continue;
+    }
+
+    p.x = record->x;
+    p.y = record->y;
+    widget_to_global(target, &p);
+    pointer_event_init(&evt, s_replay_events[record->type], target, p.x, p.y);
+    evt.pressed = record->type == SLIDER_CIRCLE_POINTER_DOWN ||
+                  record->type == SLIDER_CIRCLE_POINTER_MOVE;
+
+    replay->dirty = rect_init(0, 0, 0, 0);
+    replay->invalidates = 0;
+
+    start = time_now_us();
+    widget_dispatch(target, (event_t*)&evt);
+    handled = time_now_us();
+
+    if (replay->dirty.w > 0 && replay->dirty.h > 0) {
+      uint64_t latency = 0;
+
+      pointer_replay_paint(replay);
+      latency = time_now_us() - start;
+
+      result->paints++;
+      result->latency_us += latency;
+      result->latency_max_us = tk_max(result->latency_max_us, latency);
+      result->dirty_area += replay->dirty.w * replay->dirty.h;
+    }
+
+    result->events++;
+    result->invalidates += replay->invalidates;
+    result->handler_us += handled - start;
+    result->handler_max_us = tk_max(result->handler_max_us, handled - start);
+    result->values[result->values_nr++] = pointer_replay_get_value(target);
+    result->duration = record->time;
+  }
+
+  return RET_OK;
+}
+
+ret_t pointer_replay_result_deinit(pointer_replay_result_t* result) {
+  return_value_if_fail(result != NULL, RET_BAD_PARAMS);
+
+  TKMEM_FREE(result->values);
+  memset(result, 0x00, sizeof(*result));
+
+  return RET_OK;
+}
+
+ret_t pointer_replay_destroy(pointer_replay_t* replay) {
+  return_value_if_fail(replay != NULL, RET_BAD_PARAMS);
+
+  if (replay->root != NULL) {
+    widget_destroy(replay->root);
+  }
+  if (replay->lcd != NULL) {
+    lcd_destroy(replay->lcd);
+  }
+  TKMEM_FREE(replay);
+
+  return RET_OK;
+}
@@ -0,0 +1,113 @@
+﻿/**
+ * File:   pointer_replay.h
+ * Author: AWTK Develop Team
+ * Brief:  在内存画布上回放指针事件，测量事件处理和重绘的耗时。
+ *
+ * Copyright (c) 2024 - 2024 Guangzhou ZHIYUAN Electronics Co.,Ltd.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * License file for more details.
+ *
+ */
+
+/**
+ * History:
+ * ================================================================
+ * 2024-03-14 Li XianJing <xianjimli@hotmail.com> created
+ *
+ */
+
+#ifndef TK_POINTER_REPLAY_H
+#define TK_POINTER_REPLAY_H
+
+#include "base/lcd.h"
+#include "slider_circle/slider_circle_pointer_trace.h"
+
+BEGIN_C_DECLS
+
+/**
+ * @class pointer_replay_result_t
+ * 回放的结果。
+ */
+typedef struct _pointer_replay_result_t {
+  /*分发的事件数*/
+  uint32_t events;
+  /*事件处理函数的耗时*/
+  uint64_t handler_us;
+  uint64_t handler_max_us;
+  /*从分发事件到重绘完成的耗时(只统计引起重绘的事件)*/
+  uint32_t paints;
+  uint64_t latency_us;
+  uint64_t latency_max_us;
+  /*请求重绘的次数和每帧脏矩形面积之和*/
+  uint32_t invalidates;
+  uint64_t dirty_area;
+  /*录制的时长(毫秒)*/
+  uint32_t duration;
+  /*每个事件之后的值*/
+  uint32_t values_nr;
+  double* values;
+} pointer_replay_result_t;
+
+/**
+ * @class pointer_replay_t
+ * 回放环境：一个没有窗口管理器的根控件和一块内存画布。
+ *
+ * 在root上创建要测试的控件，再调用pointer_replay_run。
+ */
+typedef struct _pointer_replay_t {
+  widget_t* root;
+  lcd_t* lcd;
+
+  /*private*/
+  rect_t dirty;
+  uint32_t invalidates;
+} pointer_replay_t;
+
+/**
+ * @method pointer_replay_create
+ * 创建回放环境。
+ * @param {wh_t} w 宽度。
+ * @param {wh_t} h 高度。
+ *
+ * @return {pointer_replay_t*} 返回回放环境。
+ */
+pointer_replay_t* pointer_replay_create(wh_t w, wh_t h);
+
+/**
+ * @method pointer_replay_run
+ * 把事件序列分发给target，每个事件之后重绘脏区域。
+ * @param {pointer_replay_t*} replay 回放环境。
+ * @param {widget_t*} target 目标控件(root的子控件)。
+ * @param {const slider_circle_pointer_trace_t*} trace 事件序列。
+ * @param {pointer_replay_result_t*} result 返回结果(用pointer_replay_result_deinit释放)。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t pointer_replay_run(pointer_replay_t* replay, widget_t* target,
+                         const slider_circle_pointer_trace_t* trace,
+                         pointer_replay_result_t* result);
+
+/**
+ * @method pointer_replay_result_deinit
+ * 释放结果。
+ * @param {pointer_replay_result_t*} result 结果。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t pointer_replay_result_deinit(pointer_replay_result_t* result);
+
+/**
+ * @method pointer_replay_destroy
+ * 销毁回放环境。
+ * @param {pointer_replay_t*} replay 回放环境。
+ *
+ * @return {ret_t} 返回RET_OK表示成功，否则表示失败。
+ */
+ret_t pointer_replay_destroy(pointer_replay_t* replay);
+
+END_C_DECLS
+
+#endif /*TK_POINTER_REPLAY_H*/
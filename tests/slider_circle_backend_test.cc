@@ -0,0 +1,127 @@
+﻿#include "awtk.h"
+#include "slider_circle_register.h"
+#include "lcd/lcd_mem_bgr565.h"
+#include "slider_circle/slider_circle.h"
+#include "slider_circle/slider_circle_sprite.h"
+#include "slider_circle/slider_circle_warmup.h"
+#include "slider_circle/slider_circle_backend.h"
+#include "gtest/gtest.h"
+
+TEST(slider_circle_backend, str) {
+  ASSERT_EQ(slider_circle_backend_from_str(NULL), SLIDER_CIRCLE_BACKEND_AUTO);
+  ASSERT_EQ(slider_circle_backend_from_str("unknown"), SLIDER_CIRCLE_BACKEND_AUTO);
+  ASSERT_EQ(slider_circle_backend_from_str("vgcanvas"), SLIDER_CIRCLE_BACKEND_VGCANVAS);
+  ASSERT_EQ(slider_circle_backend_from_str("direct"), SLIDER_CIRCLE_BACKEND_DIRECT);
+  ASSERT_EQ(slider_circle_backend_from_str("sprite"), SLIDER_CIRCLE_BACKEND_SPRITE);
+  ASSERT_STREQ(slider_circle_backend_to_str(SLIDER_CIRCLE_BACKEND_SPRITE), "sprite");
+  ASSERT_STREQ(slider_circle_backend_to_str(SLIDER_CIRCLE_BACKEND_AUTO), "auto");
+}
+
+TEST(slider_circle_backend, gpu) {
+  lcd_t lcd;
+  canvas_t c;
+
+  memset(&lcd, 0x00, sizeof(lcd));
+  memset(&c, 0x00, sizeof(c));
+  lcd.type = LCD_VGCANVAS;
+  c.lcd = &lcd;
+  /*不受环境变量SLIDER_CIRCLE_BACKEND的影响*/
+  ASSERT_EQ(slider_circle_backend_set_default(SLIDER_CIRCLE_BACKEND_AUTO), RET_OK);
+
+  /*GPU上总是使用vgcanvas，不能直接访问framebuffer*/
+  ASSERT_EQ(slider_circle_backend_resolve(SLIDER_CIRCLE_BACKEND_AUTO, &c),
+            SLIDER_CIRCLE_BACKEND_VGCANVAS);
+  ASSERT_EQ(slider_circle_backend_resolve(SLIDER_CIRCLE_BACKEND_DIRECT, &c),
+            SLIDER_CIRCLE_BACKEND_VGCANVAS);
+  ASSERT_EQ(slider_circle_backend_resolve(SLIDER_CIRCLE_BACKEND_SPRITE, &c),
+            SLIDER_CIRCLE_BACKEND_VGCANVAS);
+}
+
+TEST(slider_circle_backend, set_default) {
+  canvas_t c;
+  lcd_t* lcd = lcd_mem_bgr565_create(200, 200, TRUE);
+
+  canvas_init(&c, lcd, font_manager());
+  ASSERT_EQ(slider_circle_backend_set_default(SLIDER_CIRCLE_BACKEND_VGCANVAS), RET_OK);
+  ASSERT_EQ(slider_circle_backend_resolve(SLIDER_CIRCLE_BACKEND_AUTO, &c),
+            SLIDER_CIRCLE_BACKEND_VGCANVAS);
+  /*指定了绘制方式时不使用缺省值*/
+  ASSERT_EQ(slider_circle_backend_resolve(SLIDER_CIRCLE_BACKEND_SPRITE, &c),
+            SLIDER_CIRCLE_BACKEND_SPRITE);
+  ASSERT_EQ(slider_circle_backend_set_default(SLIDER_CIRCLE_BACKEND_AUTO), RET_OK);
+  ASSERT_EQ(slider_circle_backend_resolve(SLIDER_CIRCLE_BACKEND_AUTO, &c),
+            SLIDER_CIRCLE_BACKEND_DIRECT);
+
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
+
+TEST(slider_circle_backend, framebuffer) {
+  canvas_t c;
+  rect_t r = rect_init(0, 0, 200, 200);
+  lcd_t* lcd = lcd_mem_bgr565_create(200, 200, TRUE);
+  widget_t* w = slider_circle_create(NULL, 0, 0, 100, 100);
+
+  canvas_init(&c, lcd, font_manager());
+  ASSERT_EQ(slider_circle_backend_set_default(SLIDER_CIRCLE_BACKEND_AUTO), RET_OK);
+  ASSERT_EQ(slider_circle_backend_resolve(SLIDER_CIRCLE_BACKEND_AUTO, &c),
+            SLIDER_CIRCLE_BACKEND_DIRECT);
+  ASSERT_EQ(slider_circle_backend_resolve(SLIDER_CIRCLE_BACKEND_VGCANVAS, &c),
+            SLIDER_CIRCLE_BACKEND_VGCANVAS);
+  ASSERT_EQ(slider_circle_backend_resolve(SLIDER_CIRCLE_BACKEND_SPRITE, &c),
+            SLIDER_CIRCLE_BACKEND_SPRITE);
+
+  /*能直接写framebuffer时，启动工作线程后也优先直接绘制*/
+  ASSERT_EQ(slider_circle_warmup_init(1), RET_OK);
+  ASSERT_EQ(slider_circle_backend_resolve(SLIDER_CIRCLE_BACKEND_AUTO, &c),
+            SLIDER_CIRCLE_BACKEND_DIRECT);
+  ASSERT_EQ(slider_circle_warmup_deinit(), RET_OK);
+
+  /*绘制时选择，画布不变时不重新选择*/
+  widget_set_prop_str(w, SLIDER_CIRCLE_PROP_RENDER_BACKEND, "vgcanvas");
+  ASSERT_STREQ(widget_get_prop_str(w, SLIDER_CIRCLE_PROP_RENDER_BACKEND, ""), "vgcanvas");
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  widget_paint(w, &c);
+  canvas_end_frame(&c);
+  ASSERT_STREQ(widget_get_prop_str(w, SLIDER_CIRCLE_PROP_ACTIVE_BACKEND, ""), "vgcanvas");
+
+  slider_circle_set_render_backend(w, "auto");
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  widget_paint(w, &c);
+  canvas_end_frame(&c);
+  ASSERT_STREQ(widget_get_prop_str(w, SLIDER_CIRCLE_PROP_ACTIVE_BACKEND, ""), "direct");
+
+  widget_destroy(w);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
+
+TEST(slider_circle_backend, dragger) {
+  canvas_t c;
+  rect_t r = rect_init(0, 0, 200, 200);
+  lcd_t* lcd = lcd_mem_bgr565_create(200, 200, TRUE);
+  widget_t* w = slider_circle_create(NULL, 0, 0, 100, 100);
+
+  canvas_init(&c, lcd, font_manager());
+  widget_set_style_color(w, "normal:dragger_color", 0xff0000ff);
+
+  /*指定vgcanvas时拖动点也填充路径，不使用共享的位图*/
+  slider_circle_sprite_clear();
+  slider_circle_set_render_backend(w, "vgcanvas");
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  widget_paint(w, &c);
+  canvas_end_frame(&c);
+  ASSERT_EQ(slider_circle_sprite_count(), 0u);
+
+  slider_circle_set_render_backend(w, "sprite");
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  widget_paint(w, &c);
+  canvas_end_frame(&c);
+  ASSERT_STREQ(widget_get_prop_str(w, SLIDER_CIRCLE_PROP_ACTIVE_BACKEND, ""), "sprite");
+  ASSERT_GE(slider_circle_sprite_count(), 1u);
+
+  widget_destroy(w);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+  slider_circle_sprite_cache_deinit();
+}
@@ -0,0 +1,129 @@
+﻿#include "tkc/mem.h"
+#include "tkc/time_now.h"
+#include "slider_circle/slider_circle_direct.h"
+#include "gtest/gtest.h"
+
+#define DIRECT_FB_SIZE 480
+#define DIRECT_BENCH_TIMES 200
+
+static void direct_fill_random(uint8_t* data, uint32_t size, uint32_t seed) {
+  uint32_t i = 0;
+
+  for (i = 0; i < size; i++) {
+    seed = seed * 1103515245 + 12345;
+    data[i] = (uint8_t)(seed >> 16);
+  }
+}
+
+TEST(slider_circle_direct, blend_simd_same_as_scalar) {
+  uint32_t n = 0;
+  uint8_t cov[67];
+  uint8_t expected[67 * 4];
+  uint8_t actual[67 * 4];
+  color_t color = color_init(0x12, 0x9a, 0xf0, 0xc0);
+
+  /*不是8的倍数的长度会走到尾部的C语言实现*/
+  for (n = 1; n <= sizeof(cov); n += 11) {
+    direct_fill_random(cov, n, n);
+    cov[0] = 0;
+    cov[n - 1] = 0xff;
+
+    direct_fill_random(expected, n * 4, n + 1);
+    memcpy(actual, expected, n * 4);
+    slider_circle_blend_bgra8888_scalar(expected, cov, n, color);
+    slider_circle_blend_bgra8888(actual, cov, n, color);
+    ASSERT_EQ(memcmp(expected, actual, n * 4), 0);
+
+    direct_fill_random(expected, n * 2, n + 2);
+    memcpy(actual, expected, n * 2);
+    slider_circle_blend_bgr565_scalar(expected, cov, n, color);
+    slider_circle_blend_bgr565(actual, cov, n, color);
+    ASSERT_EQ(memcmp(expected, actual, n * 2), 0);
+  }
+}
+
+TEST(slider_circle_direct, blend) {
+  uint8_t cov[2] = {0xff, 0};
+  uint8_t p[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+  uint16_t p565[2] = {0, 0xffff};
+
+  /*完全覆盖时为前景色，没有覆盖时不变*/
+  slider_circle_blend_bgra8888(p, cov, 2, color_init(0x10, 0x20, 0x30, 0xff));
+  ASSERT_EQ(p[0], 0x30);
+  ASSERT_EQ(p[1], 0x20);
+  ASSERT_EQ(p[2], 0x10);
+  ASSERT_EQ(p[3], 0xff);
+  ASSERT_EQ(p[4], 5);
+
+  slider_circle_blend_bgr565((uint8_t*)p565, cov, 2, color_init(0xff, 0, 0, 0xff));
+  ASSERT_EQ(p565[0], 0xf800);
+  ASSERT_EQ(p565[1], 0xffff);
+}
+
+TEST(slider_circle_direct, draw_fb) {
+  slider_circle_raster_arc_t arc;
+  uint32_t line_length = DIRECT_FB_SIZE * 4;
+  rect_t clip = rect_init(0, 0, DIRECT_FB_SIZE, DIRECT_FB_SIZE / 2);
+  uint8_t* fb = (uint8_t*)TKMEM_ALLOC(line_length * DIRECT_FB_SIZE);
+  ASSERT_TRUE(fb != NULL);
+  memset(fb, 0x00, line_length * DIRECT_FB_SIZE);
+
+  memset(&arc, 0x00, sizeof(arc));
+  arc.cx = DIRECT_FB_SIZE / 2;
+  arc.cy = DIRECT_FB_SIZE / 2;
+  arc.r = 200;
+  arc.line_width = 20;
+  arc.start_angle = 0;
+  arc.end_angle = 2 * M_PI;
+  ASSERT_EQ(slider_circle_direct_draw_fb(fb, BITMAP_FMT_BGRA8888, line_length, &clip, &arc,
+                                         color_init(0xff, 0, 0, 0xff)),
+            RET_OK);
+
+  /*上面在裁剪矩形内，下面在裁剪矩形外，圆心没有覆盖*/
+  ASSERT_EQ(fb[40 * line_length + 240 * 4 + 2], 0xff);
+  ASSERT_EQ(fb[440 * line_length + 240 * 4 + 2], 0);
+  ASSERT_EQ(fb[240 * line_length + 240 * 4 + 2], 0);
+
+  TKMEM_FREE(fb);
+}
+
+static void direct_bench(bitmap_format_t format, uint32_t bpp, const char* name) {
+  uint32_t i = 0;
+  uint64_t cost = 0;
+  rect_t bounds;
+  slider_circle_raster_arc_t arc;
+  uint32_t line_length = DIRECT_FB_SIZE * bpp;
+  rect_t clip = rect_init(0, 0, DIRECT_FB_SIZE, DIRECT_FB_SIZE);
+  uint8_t* fb = (uint8_t*)TKMEM_ALLOC(line_length * DIRECT_FB_SIZE);
+  ASSERT_TRUE(fb != NULL);
+  memset(fb, 0xff, line_length * DIRECT_FB_SIZE);
+
+  memset(&arc, 0x00, sizeof(arc));
+  arc.cx = DIRECT_FB_SIZE / 2;
+  arc.cy = DIRECT_FB_SIZE / 2;
+  arc.r = 200;
+  arc.line_width = 24;
+  arc.start_angle = M_PI * 3 / 4;
+  arc.end_angle = M_PI * 9 / 4;
+  arc.cap = SLIDER_CIRCLE_RASTER_CAP_ROUND;
+  slider_circle_raster_bounds(&arc, &bounds);
+
+  cost = time_now_us();
+  for (i = 0; i < DIRECT_BENCH_TIMES; i++) {
+    slider_circle_direct_draw_fb(fb, format, line_length, &clip, &arc,
+                                 color_init(0x20, 0x80, 0xe0, 0xc0));
+  }
+  cost = tk_max(time_now_us() - cost, 1);
+
+  /*按圆弧的外接矩形计算像素数*/
+  log_info("direct %s(%s): %u x %dx%d in %llu us, %.1f MP/s\n", name,
+           slider_circle_blend_simd_name(), DIRECT_BENCH_TIMES, bounds.w, bounds.h,
+           (unsigned long long)cost, (double)bounds.w * bounds.h * DIRECT_BENCH_TIMES / cost);
+
+  TKMEM_FREE(fb);
+}
+
+TEST(slider_circle_direct, throughput) {
+  direct_bench(BITMAP_FMT_BGR565, 2, "bgr565");
+  direct_bench(BITMAP_FMT_BGRA8888, 4, "bgra8888");
+}
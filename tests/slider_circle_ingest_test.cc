@@ -0,0 +1,158 @@
+﻿#include "tkc/time_now.h"
+#include "base/idle.h"
+#include "lcd/lcd_mem_bgra8888.h"
+#include "slider_circle/slider_circle.h"
+#include "slider_circle/slider_circle_ingest.h"
+#include "gtest/gtest.h"
+
+#define INGEST_BATCH 1000
+#define INGEST_BENCH_BATCHES 10000
+
+TEST(slider_circle_ingest, push_commit) {
+  slider_circle_ingest_t ingest;
+  double samples[] = {10, 30, -5, 20};
+
+  ASSERT_EQ(slider_circle_ingest_reset(&ingest), RET_OK);
+
+  /*没有采样时不产生峰值*/
+  ASSERT_EQ(slider_circle_ingest_commit(&ingest, 0, 0, 0), RET_OK);
+  ASSERT_FALSE(ingest.has_peaks);
+
+  ASSERT_EQ(slider_circle_ingest_push(&ingest, samples, ARRAY_SIZE(samples)), RET_OK);
+  ASSERT_EQ(ingest.frame_count, 4u);
+  ASSERT_EQ(ingest.frame_min, -5);
+  ASSERT_EQ(ingest.frame_max, 30);
+  ASSERT_EQ(ingest.last, 20);
+
+  ASSERT_EQ(slider_circle_ingest_commit(&ingest, 20, 0, 1000), RET_OK);
+  ASSERT_TRUE(ingest.has_peaks);
+  ASSERT_EQ(ingest.frame_count, 0u);
+  ASSERT_EQ(ingest.peak_min, -5);
+  ASSERT_EQ(ingest.peak_max, 30);
+
+  /*不回落时一直保持*/
+  ASSERT_EQ(slider_circle_ingest_commit(&ingest, 20, 0, 5000), RET_OK);
+  ASSERT_EQ(ingest.peak_min, -5);
+  ASSERT_EQ(ingest.peak_max, 30);
+}
+
+TEST(slider_circle_ingest, decay) {
+  slider_circle_ingest_t ingest;
+  double samples[] = {0, 100};
+
+  slider_circle_ingest_reset(&ingest);
+  slider_circle_ingest_push(&ingest, samples, ARRAY_SIZE(samples));
+  slider_circle_ingest_commit(&ingest, 50, 10, 1000);
+
+  /*每秒回落10*/
+  slider_circle_ingest_commit(&ingest, 50, 10, 2000);
+  ASSERT_EQ(ingest.peak_max, 90);
+  ASSERT_EQ(ingest.peak_min, 10);
+
+  /*最多回落到当前值*/
+  slider_circle_ingest_commit(&ingest, 50, 10, 100000);
+  ASSERT_EQ(ingest.peak_max, 50);
+  ASSERT_EQ(ingest.peak_min, 50);
+
+  /*新的峰值立即生效*/
+  samples[0] = 70;
+  slider_circle_ingest_push(&ingest, samples, 1);
+  slider_circle_ingest_commit(&ingest, 70, 10, 100000);
+  ASSERT_EQ(ingest.peak_max, 70);
+}
+
+TEST(slider_circle_ingest, widget) {
+  double samples[] = {10, 90, 40};
+  widget_t* w = slider_circle_create(NULL, 0, 0, 100, 100);
+  slider_circle_t* s = SLIDER_CIRCLE(w);
+
+  ASSERT_EQ(widget_set_prop_bool(w, SLIDER_CIRCLE_PROP_PEAK_HOLD, TRUE), RET_OK);
+  ASSERT_EQ(widget_set_prop_float(w, SLIDER_CIRCLE_PROP_PEAK_DECAY, 5), RET_OK);
+  ASSERT_TRUE(s->peak_hold);
+  ASSERT_EQ(s->peak_decay, 5);
+
+  /*绘制之前只刷新一次*/
+  ASSERT_EQ(slider_circle_ingest(w, samples, ARRAY_SIZE(samples)), RET_OK);
+  ASSERT_TRUE(s->ingest_pending);
+  ASSERT_EQ(slider_circle_ingest(w, samples, ARRAY_SIZE(samples)), RET_OK);
+  ASSERT_EQ(s->ingest->frame_count, 6u);
+  ASSERT_EQ(s->ingest->frame_max, 90);
+
+  ASSERT_EQ(slider_circle_reset_peaks(w), RET_OK);
+  ASSERT_FALSE(s->ingest->has_peaks);
+
+  widget_destroy(w);
+}
+
+TEST(slider_circle_ingest, decay_repaint) {
+  canvas_t c;
+  double samples[] = {10, 90, 40};
+  rect_t r = rect_init(0, 0, 100, 100);
+  lcd_t* lcd = lcd_mem_bgra8888_create(100, 100, TRUE);
+  widget_t* w = slider_circle_create(NULL, 0, 0, 100, 100);
+  slider_circle_t* s = SLIDER_CIRCLE(w);
+
+  slider_circle_set_peak_hold(w, TRUE);
+  slider_circle_set_peak_decay(w, 1000);
+  canvas_init(&c, lcd, font_manager());
+
+  /*峰值离开当前值时，没有新的采样也在下一帧重绘*/
+  slider_circle_ingest(w, samples, ARRAY_SIZE(samples));
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  widget_on_paint_background(w, &c);
+  canvas_end_frame(&c);
+  ASSERT_NE(s->peak_idle, (uint32_t)TK_INVALID_ID);
+
+  w->dirty = FALSE;
+  idle_dispatch();
+  ASSERT_TRUE(w->dirty);
+  ASSERT_EQ(s->peak_idle, (uint32_t)TK_INVALID_ID);
+
+  /*回落到当前值之后不再重绘*/
+  s->ingest->peak_max = s->value;
+  s->ingest->peak_min = s->value;
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  widget_on_paint_background(w, &c);
+  canvas_end_frame(&c);
+  ASSERT_EQ(s->peak_idle, (uint32_t)TK_INVALID_ID);
+
+  /*不回落时保持不动，也不需要重绘*/
+  slider_circle_set_peak_decay(w, 0);
+  slider_circle_ingest(w, samples, ARRAY_SIZE(samples));
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  widget_on_paint_background(w, &c);
+  canvas_end_frame(&c);
+  ASSERT_EQ(s->peak_idle, (uint32_t)TK_INVALID_ID);
+
+  widget_destroy(w);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
+
+TEST(slider_circle_ingest, benchmark) {
+  uint32_t i = 0;
+  uint32_t k = 0;
+  uint64_t cost = 0;
+  slider_circle_ingest_t ingest;
+  double samples[INGEST_BATCH];
+
+  for (i = 0; i < INGEST_BATCH; i++) {
+    samples[i] = (i * 7919) % 1000;
+  }
+
+  slider_circle_ingest_reset(&ingest);
+  cost = time_now_us();
+  for (k = 0; k < INGEST_BENCH_BATCHES; k++) {
+    slider_circle_ingest_push(&ingest, samples, INGEST_BATCH);
+    if ((k % 16) == 15) {
+      /*1kHz的采样，60Hz的刷新*/
+      slider_circle_ingest_commit(&ingest, ingest.last, 0, k);
+    }
+  }
+  cost = time_now_us() - cost;
+
+  ASSERT_EQ(ingest.peak_max, 999);
+  ASSERT_EQ(ingest.peak_min, 0);
+  log_info("ingest: %u samples in %llu us\n", INGEST_BATCH * INGEST_BENCH_BATCHES,
+           (unsigned long long)cost);
+}
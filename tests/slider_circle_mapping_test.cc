@@ -0,0 +1,152 @@
+﻿#include <math.h>
+#include "tkc/time_now.h"
+#include "slider_circle/slider_circle.h"
+#include "slider_circle/slider_circle_mapping.h"
+#include "slider_circle/slider_circle_ticks.h"
+#include "gtest/gtest.h"
+
+#define MAPPING_BENCH_TIMES 100000
+
+TEST(slider_circle_mapping, log) {
+  double v = 0;
+  slider_circle_mapping_t mapping;
+
+  ASSERT_EQ(slider_circle_mapping_parse(&mapping, "log", 20, 20000), RET_OK);
+  ASSERT_EQ(mapping.type, SLIDER_CIRCLE_MAPPING_LOG);
+  ASSERT_DOUBLE_EQ(slider_circle_mapping_to_pos(&mapping, 20), 0);
+  ASSERT_DOUBLE_EQ(slider_circle_mapping_to_pos(&mapping, 20000), 1);
+
+  /*折线逼近的误差很小，正反转换一致*/
+  for (v = 20; v < 20000; v *= 1.01) {
+    double pos = slider_circle_mapping_to_pos(&mapping, v);
+    ASSERT_NEAR(pos, log(v / 20) / log(1000), 0.001);
+    ASSERT_NEAR(slider_circle_mapping_to_value(&mapping, pos), v, v * 1e-9);
+  }
+
+  /*min不大于0时退回到线性*/
+  ASSERT_NE(slider_circle_mapping_parse(&mapping, "log", 0, 100), RET_OK);
+  ASSERT_EQ(mapping.type, SLIDER_CIRCLE_MAPPING_LINEAR);
+  ASSERT_DOUBLE_EQ(slider_circle_mapping_to_pos(&mapping, 25), 0.25);
+}
+
+TEST(slider_circle_mapping, curve) {
+  slider_circle_mapping_t mapping;
+
+  ASSERT_EQ(slider_circle_mapping_parse(&mapping, "curve:0,0;50,80;100,100", 0, 100), RET_OK);
+  ASSERT_EQ(mapping.size, 3u);
+  ASSERT_DOUBLE_EQ(slider_circle_mapping_to_pos(&mapping, 25), 0.4);
+  ASSERT_DOUBLE_EQ(slider_circle_mapping_to_pos(&mapping, 75), 0.9);
+  ASSERT_DOUBLE_EQ(slider_circle_mapping_to_value(&mapping, 0.8), 50);
+  ASSERT_DOUBLE_EQ(slider_circle_mapping_to_value(&mapping, 0.9), 75);
+  ASSERT_DOUBLE_EQ(slider_circle_mapping_snap(&mapping, 33), 33);
+}
+
+TEST(slider_circle_mapping, list) {
+  slider_circle_mapping_t mapping;
+
+  /*不递增的值忽略*/
+  ASSERT_EQ(slider_circle_mapping_parse(&mapping, "list:1,2,5,10,5,20,50,100", 1, 100), RET_OK);
+  ASSERT_EQ(mapping.size, 7u);
+  ASSERT_DOUBLE_EQ(slider_circle_mapping_snap(&mapping, 3.4), 2);
+  ASSERT_DOUBLE_EQ(slider_circle_mapping_snap(&mapping, 3.6), 5);
+  ASSERT_DOUBLE_EQ(slider_circle_mapping_snap(&mapping, 1000), 100);
+  ASSERT_DOUBLE_EQ(slider_circle_mapping_to_pos(&mapping, 10), 0.5);
+  ASSERT_DOUBLE_EQ(slider_circle_mapping_to_value(&mapping, 0.49), 10);
+  ASSERT_DOUBLE_EQ(slider_circle_mapping_to_value(&mapping, 1), 100);
+
+  ASSERT_NE(slider_circle_mapping_parse(&mapping, "list:1", 1, 100), RET_OK);
+  ASSERT_EQ(mapping.type, SLIDER_CIRCLE_MAPPING_LINEAR);
+}
+
+TEST(slider_circle_mapping, widget) {
+  widget_t* w = slider_circle_create(NULL, 0, 0, 100, 100);
+
+  slider_circle_set_min(w, 1);
+  slider_circle_set_max(w, 100);
+  slider_circle_set_value(w, 33);
+  slider_circle_set_start_angle(w, 0);
+  slider_circle_set_end_angle(w, 360);
+
+  /*离散值列表代替step的取整，设置时就调整当前的值*/
+  widget_set_prop_str(w, SLIDER_CIRCLE_PROP_MAPPING, "list:1,2,5,10,20,50,100");
+  ASSERT_STREQ(widget_get_prop_str(w, SLIDER_CIRCLE_PROP_MAPPING, ""), "list:1,2,5,10,20,50,100");
+  ASSERT_EQ(widget_get_prop_int(w, WIDGET_PROP_VALUE, 0), 20);
+  slider_circle_set_value(w, 7);
+  ASSERT_EQ(widget_get_prop_int(w, WIDGET_PROP_VALUE, 0), 5);
+  ASSERT_NEAR(slider_circle_value_to_angle(w, 10), M_PI, 0.0001);
+
+  /*对数映射的节点表随min/max重新生成*/
+  slider_circle_set_mapping(w, "log");
+  slider_circle_set_max(w, 10000);
+  ASSERT_NEAR(slider_circle_value_to_angle(w, 100), M_PI, 0.001);
+#ifndef SLIDER_CIRCLE_WITHOUT_INPUT
+  ASSERT_NEAR(slider_circle_angle_to_value(w, 180), 100, 0.001);
+#endif /*SLIDER_CIRCLE_WITHOUT_INPUT*/
+
+  slider_circle_set_mapping(w, NULL);
+  ASSERT_TRUE(SLIDER_CIRCLE(w)->value_map == NULL);
+  ASSERT_NEAR(slider_circle_value_to_angle(w, 5000.5), M_PI, 0.001);
+
+  widget_destroy(w);
+}
+
+#ifndef SLIDER_CIRCLE_WITHOUT_TICKS
+static double ticks_line_angle(const slider_circle_ticks_t* ticks, uint32_t i) {
+  const pointf_t* p = ticks->lines + i * 2;
+
+  return atan2(p[0].y - ticks->params.h / 2.0, p[0].x - ticks->params.w / 2.0);
+}
+
+TEST(slider_circle_mapping, ticks) {
+  canvas_t c;
+  slider_circle_mapping_t mapping;
+  slider_circle_ticks_t ticks;
+  slider_circle_ticks_params_t params;
+
+  memset(&c, 0x00, sizeof(c));
+  memset(&params, 0x00, sizeof(params));
+  params.min = 1;
+  params.max = 1000;
+  params.step = 1;
+  params.w = 200;
+  params.h = 200;
+  params.start_angle = 0;
+  params.end_angle = 270;
+  params.line_width = 8;
+  params.min_gap = 4;
+  params.mapping = "log";
+
+  /*刻度的角度和拖动点一样按对数映射*/
+  slider_circle_mapping_parse(&mapping, "log", params.min, params.max);
+  slider_circle_ticks_init(&ticks);
+  ASSERT_EQ(slider_circle_ticks_update(&ticks, &c, &params), RET_OK);
+  ASSERT_GT(ticks.minor_nr, 2u);
+  ASSERT_NEAR(ticks_line_angle(&ticks, 1),
+              slider_circle_mapping_to_angle(&mapping, 11, 1, 1000, 0, 270, FALSE), 0.0001);
+  ASSERT_NEAR(ticks_line_angle(&ticks, 1), TK_D2R(270 * log(11.0) / log(1000.0)), 0.001);
+
+  /*映射变化时重新计算*/
+  params.mapping = NULL;
+  ASSERT_EQ(slider_circle_ticks_update(&ticks, &c, &params), RET_OK);
+  ASSERT_NEAR(ticks_line_angle(&ticks, 1), TK_D2R(270 * 10 / 999.0), 0.0001);
+
+  slider_circle_ticks_deinit(&ticks);
+}
+#endif /*SLIDER_CIRCLE_WITHOUT_TICKS*/
+
+TEST(slider_circle_mapping, bench) {
+  uint32_t i = 0;
+  uint64_t cost = 0;
+  double sum = 0;
+  slider_circle_mapping_t mapping;
+
+  ASSERT_EQ(slider_circle_mapping_parse(&mapping, "log", 20, 20000), RET_OK);
+  cost = time_now_us();
+  for (i = 0; i < MAPPING_BENCH_TIMES; i++) {
+    double pos = (double)i / MAPPING_BENCH_TIMES;
+    sum += slider_circle_mapping_to_pos(&mapping, slider_circle_mapping_to_value(&mapping, pos));
+  }
+  cost = time_now_us() - cost;
+  log_info("mapping: %u log round trips in %llu us (%g)\n", MAPPING_BENCH_TIMES,
+           (unsigned long long)cost, sum);
+}
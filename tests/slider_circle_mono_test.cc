@@ -0,0 +1,132 @@
+﻿#include "tkc/mem.h"
+#include "tkc/time_now.h"
+#include "slider_circle/slider_circle_mono.h"
+#include "gtest/gtest.h"
+
+#define MONO_FB_SIZE 480
+#define MONO_BENCH_TIMES 1000
+
+TEST(slider_circle_mono, fill) {
+  uint32_t t = 0;
+  uint8_t row[64];
+  uint8_t expected[64];
+
+  for (t = 0; t < 1000; t++) {
+    int32_t x = 0;
+    int32_t x0 = (t * 7919) % 400;
+    int32_t x1 = (t * 104729) % 400;
+    uint8_t pattern = (uint8_t)(t * 31);
+    uint8_t* p = row + (t & 3); /*不同的对齐*/
+
+    memset(row, 0x5a, sizeof(row));
+    memcpy(expected, row, sizeof(row));
+    slider_circle_mono_fill(p, x0, x1, pattern);
+
+    for (x = x0; x < x1; x++) {
+      uint8_t mask = 0x80 >> (x & 7);
+      uint8_t* e = expected + (t & 3) + (x >> 3);
+      *e = (*e & ~mask) | (pattern & mask);
+    }
+    ASSERT_EQ(memcmp(row, expected, sizeof(row)), 0);
+  }
+}
+
+TEST(slider_circle_mono, pattern) {
+  color_t black = color_init(0, 0, 0, 0xff);
+  color_t white = color_init(0xff, 0xff, 0xff, 0xff);
+  color_t gray = color_init(0x80, 0x80, 0x80, 0xff);
+  uint32_t y = 0;
+  uint32_t bits = 0;
+
+  ASSERT_EQ(slider_circle_mono_pattern(black, 0, FALSE), 0x00);
+  ASSERT_EQ(slider_circle_mono_pattern(white, 0, FALSE), 0xff);
+  ASSERT_EQ(slider_circle_mono_pattern(black, 1, TRUE), 0x00);
+  ASSERT_EQ(slider_circle_mono_pattern(white, 1, TRUE), 0xff);
+
+  /*50%的灰度在4x4的范围内有一半的像素是亮的*/
+  for (y = 0; y < 4; y++) {
+    uint8_t p = slider_circle_mono_pattern(gray, y, TRUE);
+    for (; p != 0; p &= p - 1) {
+      bits++;
+    }
+  }
+  ASSERT_EQ(bits, 16u);
+}
+
+TEST(slider_circle_mono, same_as_raster) {
+  int32_t x = 0;
+  int32_t y = 0;
+  uint32_t cap = 0;
+  uint8_t cov[200];
+  slider_circle_raster_arc_t arc;
+
+  /*像素中心在圆弧内的像素与覆盖率的阈值一致(只在边缘附近允许不同)*/
+  for (cap = SLIDER_CIRCLE_RASTER_CAP_BUTT; cap <= SLIDER_CIRCLE_RASTER_CAP_SQUARE; cap++) {
+    memset(&arc, 0x00, sizeof(arc));
+    arc.cx = 100.3f;
+    arc.cy = 99.7f;
+    arc.r = 80;
+    arc.line_width = 12;
+    arc.start_angle = M_PI * 2 / 3;
+    arc.end_angle = M_PI * 7 / 3;
+    arc.cap = cap;
+
+    for (y = 0; y < 200; y++) {
+      int32_t xs[2 * SLIDER_CIRCLE_MONO_MAX_SPANS];
+      uint32_t n = slider_circle_mono_row(&arc, y, xs);
+
+      slider_circle_raster_span(&arc, 0, y, ARRAY_SIZE(cov), cov);
+      for (x = 0; x < 200; x++) {
+        uint32_t k = 0;
+        bool_t on = FALSE;
+
+        for (k = 0; k < n; k++) {
+          on = on || (x >= xs[2 * k] && x < xs[2 * k + 1]);
+        }
+        if (cov[x] < 64) {
+          ASSERT_FALSE(on);
+        } else if (cov[x] > 192) {
+          ASSERT_TRUE(on);
+        }
+      }
+    }
+  }
+}
+
+TEST(slider_circle_mono, draw_fb) {
+  uint32_t i = 0;
+  uint64_t cost = 0;
+  slider_circle_raster_arc_t arc;
+  uint32_t line_length = TK_BITMAP_MONO_LINE_LENGTH(MONO_FB_SIZE);
+  rect_t clip = rect_init(0, 0, MONO_FB_SIZE, MONO_FB_SIZE);
+  uint8_t* fb = (uint8_t*)TKMEM_ALLOC(line_length * MONO_FB_SIZE);
+  ASSERT_TRUE(fb != NULL);
+  memset(fb, 0x00, line_length * MONO_FB_SIZE);
+
+  memset(&arc, 0x00, sizeof(arc));
+  arc.cx = MONO_FB_SIZE / 2;
+  arc.cy = MONO_FB_SIZE / 2;
+  arc.r = 200;
+  arc.line_width = 24;
+  arc.start_angle = M_PI * 3 / 4;
+  arc.end_angle = M_PI * 9 / 4;
+  arc.cap = SLIDER_CIRCLE_RASTER_CAP_ROUND;
+
+  ASSERT_EQ(slider_circle_mono_draw_fb(fb, line_length, &clip, &arc,
+                                       color_init(0xff, 0xff, 0xff, 0xff), FALSE),
+            RET_OK);
+  /*正上方在圆弧上，正下方在缺口里*/
+  ASSERT_EQ(fb[40 * line_length + 240 / 8], 0xff);
+  ASSERT_EQ(fb[440 * line_length + 240 / 8], 0x00);
+
+  cost = time_now_us();
+  for (i = 0; i < MONO_BENCH_TIMES; i++) {
+    slider_circle_mono_draw_fb(fb, line_length, &clip, &arc, color_init(0x80, 0x80, 0x80, 0xff),
+                               (i & 1) != 0);
+  }
+  cost = time_now_us() - cost;
+  log_info("mono: %u arcs %dx%d in %llu us\n", MONO_BENCH_TIMES, MONO_FB_SIZE, MONO_FB_SIZE,
+           (unsigned long long)cost);
+
+  TKMEM_FREE(fb);
+}
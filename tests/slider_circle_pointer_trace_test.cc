@@ -0,0 +1,79 @@
+﻿#include <math.h>
+#include "tkc/fs.h"
+#include "slider_circle/slider_circle.h"
+#include "slider_circle/slider_circle_pointer_trace.h"
+#include "pointer_replay/pointer_replay.h"
+#include "gtest/gtest.h"
+
+static void trace_append_at(slider_circle_pointer_trace_t* trace,
+                            slider_circle_pointer_type_t type, double angle, uint32_t time) {
+  /*200x200的slider_circle，缺省线宽下拖动点所在圆的半径为96*/
+  double a = TK_D2R(angle);
+  xy_t x = (xy_t)tk_roundi(100 + 96 * cos(a));
+  xy_t y = (xy_t)tk_roundi(100 + 96 * sin(a));
+
+  slider_circle_pointer_trace_append(trace, type, x, y, time);
+}
+
+TEST(slider_circle_pointer_trace, save_load) {
+  slider_circle_pointer_trace_t trace;
+  slider_circle_pointer_trace_t loaded;
+  const char* filename = "slider_circle_test.trace";
+
+  slider_circle_pointer_trace_init(&trace);
+  trace.w = 200;
+  trace.h = 200;
+  ASSERT_EQ(slider_circle_pointer_trace_append(&trace, SLIDER_CIRCLE_POINTER_DOWN, 1, 2, 0),
+            RET_OK);
+  ASSERT_EQ(slider_circle_pointer_trace_append(&trace, SLIDER_CIRCLE_POINTER_MOVE, 3, 4, 16),
+            RET_OK);
+  ASSERT_EQ(slider_circle_pointer_trace_append(&trace, SLIDER_CIRCLE_POINTER_UP, 5, 6, 32),
+            RET_OK);
+  ASSERT_EQ(slider_circle_pointer_trace_save(&trace, filename), RET_OK);
+
+  slider_circle_pointer_trace_init(&loaded);
+  ASSERT_EQ(slider_circle_pointer_trace_load(&loaded, filename), RET_OK);
+  ASSERT_EQ(loaded.size, 3u);
+  ASSERT_EQ(loaded.w, 200);
+  ASSERT_EQ(loaded.h, 200);
+  ASSERT_EQ(memcmp(loaded.records, trace.records, 3 * sizeof(slider_circle_pointer_record_t)), 0);
+
+  slider_circle_pointer_trace_deinit(&trace);
+  slider_circle_pointer_trace_deinit(&loaded);
+  fs_remove_file(os_fs(), filename);
+}
+
+TEST(slider_circle_pointer_trace, replay_wrap_around) {
+  uint32_t i = 0;
+  uint32_t time = 0;
+  pointer_replay_result_t result;
+  slider_circle_pointer_trace_t trace;
+  const double angles[] = {60, 70, 80, 85, 95, 100, 120};
+  pointer_replay_t* replay = pointer_replay_create(200, 200);
+  widget_t* w = slider_circle_create(replay->root, 0, 0, 200, 200);
+
+  /*缺省从90度到450度，值90对应54度，顺时针拖过90度(最大值)时不能跳回最小值*/
+  slider_circle_set_value(w, 90);
+  slider_circle_pointer_trace_init(&trace);
+  trace_append_at(&trace, SLIDER_CIRCLE_POINTER_DOWN, 54, time);
+  for (i = 0; i < ARRAY_SIZE(angles); i++) {
+    time += 16;
+    trace_append_at(&trace, SLIDER_CIRCLE_POINTER_MOVE, angles[i], time);
+  }
+  trace_append_at(&trace, SLIDER_CIRCLE_POINTER_UP, 120, time + 16);
+
+  ASSERT_EQ(pointer_replay_run(replay, w, &trace, &result), RET_OK);
+  ASSERT_EQ(result.events, trace.size);
+  ASSERT_EQ(result.values_nr, trace.size);
+  ASSERT_GT(result.paints, 0u);
+  ASSERT_GT(result.dirty_area, 0u);
+
+  for (i = 1; i < result.values_nr; i++) {
+    ASSERT_GE(result.values[i], result.values[i - 1]);
+  }
+  ASSERT_EQ(result.values[result.values_nr - 1], 100);
+
+  pointer_replay_result_deinit(&result);
+  slider_circle_pointer_trace_deinit(&trace);
+  pointer_replay_destroy(replay);
+}
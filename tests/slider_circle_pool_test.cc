@@ -0,0 +1,83 @@
+﻿#include "widgets/view.h"
+#include "slider_circle/slider_circle.h"
+#include "slider_circle/slider_circle_pool.h"
+#include "gtest/gtest.h"
+
+#define POOL_WIDGETS_NR 100
+
+TEST(slider_circle_pool, str_copy) {
+  char* str = NULL;
+  slider_circle_pool_stats_t before;
+  slider_circle_pool_stats_t after;
+
+  ASSERT_EQ(slider_circle_pool_release(), RET_OK);
+  ASSERT_EQ(slider_circle_pool_get_stats(&before), RET_OK);
+
+  /*没有预留时从堆中分配*/
+  str = slider_circle_pool_str_copy(NULL, "round");
+  ASSERT_STREQ(str, "round");
+  ASSERT_EQ(slider_circle_pool_get_stats(&after), RET_OK);
+  ASSERT_EQ(after.heap_allocs, before.heap_allocs + 1);
+  ASSERT_EQ(slider_circle_pool_str_free(str), RET_OK);
+
+  ASSERT_EQ(slider_circle_pool_reserve(1), RET_OK);
+  ASSERT_EQ(slider_circle_pool_get_stats(&after), RET_OK);
+  ASSERT_EQ(after.blocks, before.blocks + 1);
+  ASSERT_EQ(after.slots, before.slots + SLIDER_CIRCLE_POOL_BLOCK_SLOTS);
+
+  /*内容相同时不重新分配，能放下时在原来的槽中覆盖*/
+  str = slider_circle_pool_str_copy(NULL, "round");
+  ASSERT_EQ(slider_circle_pool_str_copy(str, "round"), str);
+  ASSERT_EQ(slider_circle_pool_str_copy(str, "square"), str);
+  ASSERT_STREQ(str, "square");
+  ASSERT_EQ(slider_circle_pool_get_stats(&after), RET_OK);
+  ASSERT_EQ(after.used, before.used + 1);
+  ASSERT_EQ(after.pooled_allocs, before.pooled_allocs + 1);
+
+  /*太长的字符串从堆中分配*/
+  str = slider_circle_pool_str_copy(str, "value is %.2f percent");
+  ASSERT_STREQ(str, "value is %.2f percent");
+  ASSERT_EQ(slider_circle_pool_get_stats(&after), RET_OK);
+  ASSERT_EQ(after.used, before.used);
+  ASSERT_TRUE(slider_circle_pool_str_copy(str, NULL) == NULL);
+
+  ASSERT_EQ(slider_circle_pool_release(), RET_OK);
+  ASSERT_EQ(slider_circle_pool_get_stats(&after), RET_OK);
+  ASSERT_EQ(after.blocks, before.blocks);
+}
+
+TEST(slider_circle_pool, screen) {
+  uint32_t i = 0;
+  uint32_t round = 0;
+  slider_circle_pool_stats_t before;
+  slider_circle_pool_stats_t after;
+
+  ASSERT_EQ(slider_circle_pool_release(), RET_OK);
+  ASSERT_EQ(slider_circle_pool_get_stats(&before), RET_OK);
+
+  /*每次打开界面前预留，关闭后一次释放*/
+  for (round = 0; round < 10; round++) {
+    widget_t* root = view_create(NULL, 0, 0, 800, 480);
+
+    ASSERT_EQ(slider_circle_pool_reserve(POOL_WIDGETS_NR), RET_OK);
+    for (i = 0; i < POOL_WIDGETS_NR; i++) {
+      widget_t* w = slider_circle_create(root, 0, 0, 100, 100);
+      slider_circle_set_line_cap(w, "round");
+      slider_circle_set_format(w, "%d%%");
+    }
+
+    ASSERT_EQ(slider_circle_pool_get_stats(&after), RET_OK);
+    ASSERT_EQ(after.used, before.used + POOL_WIDGETS_NR * SLIDER_CIRCLE_POOL_SLOTS_PER_WIDGET);
+
+    widget_destroy(root);
+    ASSERT_EQ(slider_circle_pool_release(), RET_OK);
+  }
+
+  ASSERT_EQ(slider_circle_pool_get_stats(&after), RET_OK);
+  ASSERT_EQ(after.used, before.used);
+  ASSERT_EQ(after.blocks, before.blocks);
+  ASSERT_EQ(after.heap_allocs, before.heap_allocs);
+  ASSERT_GE(after.peak, POOL_WIDGETS_NR * SLIDER_CIRCLE_POOL_SLOTS_PER_WIDGET);
+  log_info("pool: %u small heap allocations avoided, peak %u slots\n",
+           after.pooled_allocs - before.pooled_allocs, after.peak);
+}
@@ -0,0 +1,223 @@
+﻿#include "tkc/utils.h"
+#include "tkc/time_now.h"
+#include "widgets/view.h"
+#include "slider_circle/slider_circle.h"
+#include "slider_circle/slider_circle_source.h"
+#include "slider_circle/slider_circle_snapshot.h"
+#include "gtest/gtest.h"
+
+#define SNAPSHOT_WIDGETS_NR 1000
+
+static widget_t* snapshot_create_tree(uint32_t nr) {
+  uint32_t i = 0;
+  widget_t* root = view_create(NULL, 0, 0, 800, 480);
+
+  for (i = 0; i < nr; i++) {
+    char name[32];
+    widget_t* w = slider_circle_create(root, (i % 8) * 100, (i / 8 % 4) * 100, 100, 100);
+
+    tk_snprintf(name, sizeof(name), "gauge%u", i);
+    widget_set_name(w, name);
+  }
+
+  return root;
+}
+
+TEST(slider_circle_snapshot, save_restore) {
+  slider_circle_snapshot_record_t record;
+  widget_t* w = slider_circle_create(NULL, 10, 20, 100, 100);
+  widget_t* w2 = slider_circle_create(NULL, 10, 20, 100, 100);
+  slider_circle_t* s = SLIDER_CIRCLE(w2);
+
+  slider_circle_set_max(w, 200);
+  slider_circle_set_value(w, 123);
+  slider_circle_set_start_angle(w, -30);
+  slider_circle_set_end_angle(w, 210);
+  slider_circle_set_line_cap(w, "butt");
+  slider_circle_set_counter_clock_wise(w, TRUE);
+  slider_circle_set_show_ticks(w, TRUE);
+  slider_circle_set_format(w, "%d km/h");
+  slider_circle_set_peak_hold(w, TRUE);
+  slider_circle_set_peak_decay(w, 2.5f);
+  slider_circle_set_render_backend(w, "direct");
+
+  ASSERT_EQ(slider_circle_snapshot_save(w, &record), RET_OK);
+  ASSERT_EQ(slider_circle_snapshot_restore(w2, &record), RET_OK);
+
+  ASSERT_EQ(s->max, 200);
+  ASSERT_EQ(s->value, 123);
+  ASSERT_EQ(s->start_angle, -30);
+  ASSERT_EQ(s->end_angle, 210);
+  ASSERT_STREQ(s->line_cap, "butt");
+  ASSERT_EQ(s->counter_clock_wise, TRUE);
+  ASSERT_EQ(s->show_ticks, TRUE);
+  ASSERT_STREQ(s->format, "%d km/h");
+  ASSERT_EQ(s->peak_hold, TRUE);
+  ASSERT_EQ(s->peak_decay, 2.5f);
+  ASSERT_EQ(s->render_backend, SLIDER_CIRCLE_BACKEND_DIRECT);
+
+  slider_circle_set_line_cap(w, NULL);
+  ASSERT_EQ(slider_circle_snapshot_save(w, &record), RET_OK);
+  ASSERT_EQ(slider_circle_snapshot_restore(w2, &record), RET_OK);
+  ASSERT_TRUE(s->line_cap == NULL);
+
+  /*记录中的值超出范围或者不是step的整数倍时规整*/
+  record.value = 1000;
+  ASSERT_EQ(slider_circle_snapshot_restore(w2, &record), RET_OK);
+  ASSERT_EQ(s->value, 200);
+  record.value = 12.3;
+  record.step = 5;
+  ASSERT_EQ(slider_circle_snapshot_restore(w2, &record), RET_OK);
+  ASSERT_EQ(s->value, 10);
+
+  widget_destroy(w);
+  widget_destroy(w2);
+}
+
+TEST(slider_circle_snapshot, tree) {
+  wbuffer_t wb;
+  widget_t* root = snapshot_create_tree(10);
+  widget_t* root2 = snapshot_create_tree(10);
+  const slider_circle_snapshot_header_t* header = NULL;
+
+  slider_circle_set_value(widget_get_child(root, 3), 33);
+  slider_circle_set_value(widget_get_child(root, 9), 99);
+
+  wbuffer_init_extendable(&wb);
+  ASSERT_EQ(slider_circle_snapshot_save_tree(root, &wb), RET_OK);
+  header = (const slider_circle_snapshot_header_t*)wb.data;
+  ASSERT_EQ(header->magic, SLIDER_CIRCLE_SNAPSHOT_MAGIC);
+  ASSERT_EQ(header->count, 10u);
+  ASSERT_EQ(wb.cursor, sizeof(*header) + 10 * sizeof(slider_circle_snapshot_record_t));
+
+  ASSERT_EQ(slider_circle_snapshot_restore_tree(root2, wb.data, wb.cursor), RET_OK);
+  ASSERT_EQ(SLIDER_CIRCLE(widget_get_child(root2, 3))->value, 33);
+  ASSERT_EQ(SLIDER_CIRCLE(widget_get_child(root2, 9))->value, 99);
+
+  /*数据被截断*/
+  ASSERT_EQ(slider_circle_snapshot_restore_tree(root2, wb.data, wb.cursor - 1), RET_BAD_PARAMS);
+
+  /*count * record_size溢出32位时不能通过长度检查*/
+  {
+    slider_circle_snapshot_header_t h = *header;
+    h.count = 0xffffffffu / h.record_size + 1;
+    memcpy(wb.data, &h, sizeof(h));
+    ASSERT_EQ(slider_circle_snapshot_restore_tree(root2, wb.data, wb.cursor), RET_BAD_PARAMS);
+    h.count = 10;
+    memcpy(wb.data, &h, sizeof(h));
+  }
+
+  /*控件名不一致的不恢复*/
+  slider_circle_set_value(widget_get_child(root2, 3), 0);
+  widget_set_name(widget_get_child(root2, 3), "other");
+  ASSERT_EQ(slider_circle_snapshot_restore_tree(root2, wb.data, wb.cursor), RET_NOT_FOUND);
+  ASSERT_EQ(SLIDER_CIRCLE(widget_get_child(root2, 3))->value, 0);
+  ASSERT_EQ(SLIDER_CIRCLE(widget_get_child(root2, 9))->value, 99);
+
+  wbuffer_deinit(&wb);
+  widget_destroy(root);
+  widget_destroy(root2);
+}
+
+TEST(slider_circle_snapshot, strings) {
+  wbuffer_t wb;
+  widget_t* root = snapshot_create_tree(3);
+  widget_t* root2 = snapshot_create_tree(3);
+  slider_circle_t* s = SLIDER_CIRCLE(widget_get_child(root2, 1));
+  const slider_circle_snapshot_header_t* header = NULL;
+
+  slider_circle_set_zones(widget_get_child(root, 1), "0,60,#00ff00;60,100,#ff0000");
+  slider_circle_set_max(widget_get_child(root, 1), 1000);
+  slider_circle_set_min(widget_get_child(root, 1), 1);
+  slider_circle_set_mapping(widget_get_child(root, 1), "log");
+  slider_circle_set_zones(widget_get_child(root2, 2), "0,10,#0000ff");
+
+  wbuffer_init_extendable(&wb);
+  ASSERT_EQ(slider_circle_snapshot_save_tree(root, &wb), RET_OK);
+  header = (const slider_circle_snapshot_header_t*)wb.data;
+  ASSERT_EQ(header->version, SLIDER_CIRCLE_SNAPSHOT_VERSION);
+  ASSERT_GT(header->strings_size, 1u);
+  ASSERT_EQ(wb.cursor, sizeof(*header) + 3 * sizeof(slider_circle_snapshot_record_t) +
+                           header->strings_size);
+
+  /*按恢复的min/max重新生成对数映射表，空的zones清除原来的区间*/
+  ASSERT_EQ(slider_circle_snapshot_restore_tree(root2, wb.data, wb.cursor), RET_OK);
+  ASSERT_STREQ(s->zones, "0,60,#00ff00;60,100,#ff0000");
+  ASSERT_EQ(s->zone_list->size, 2u);
+  ASSERT_STREQ(s->mapping, "log");
+  ASSERT_TRUE(s->value_map != NULL);
+  ASSERT_NEAR(slider_circle_mapping_to_value(s->value_map, 1), 1000, 0.001);
+  ASSERT_TRUE(SLIDER_CIRCLE(widget_get_child(root2, 2))->zones == NULL);
+
+  /*字符串表被截断时不能恢复*/
+  ASSERT_EQ(slider_circle_snapshot_restore_tree(root2, wb.data, wb.cursor - 1), RET_BAD_PARAMS);
+
+  wbuffer_deinit(&wb);
+  widget_destroy(root);
+  widget_destroy(root2);
+}
+
+TEST(slider_circle_snapshot, source) {
+  slider_circle_snapshot_record_t record;
+  widget_t* w = slider_circle_create(NULL, 0, 0, 100, 100);
+  slider_circle_source_t* source = slider_circle_source_create();
+
+  /*发布之后还没有绘制过，保存的是共享的值*/
+  ASSERT_EQ(slider_circle_bind_source(w, source), RET_OK);
+  ASSERT_EQ(slider_circle_source_publish(source, 42), RET_OK);
+  ASSERT_EQ(slider_circle_snapshot_save(w, &record), RET_OK);
+  ASSERT_EQ(record.value, 42);
+
+  slider_circle_source_destroy(source);
+  widget_destroy(w);
+}
+
+TEST(slider_circle_snapshot, benchmark) {
+  wbuffer_t wb;
+  uint32_t i = 0;
+  uint64_t start = 0;
+  uint64_t snapshot_cost = 0;
+  uint64_t set_prop_cost = 0;
+  widget_t* root = snapshot_create_tree(SNAPSHOT_WIDGETS_NR);
+  widget_t* root2 = snapshot_create_tree(SNAPSHOT_WIDGETS_NR);
+
+  for (i = 0; i < SNAPSHOT_WIDGETS_NR; i++) {
+    slider_circle_set_value(widget_get_child(root, i), i % 100);
+  }
+
+  wbuffer_init_extendable(&wb);
+  ASSERT_EQ(slider_circle_snapshot_save_tree(root, &wb), RET_OK);
+
+  start = time_now_us();
+  ASSERT_EQ(slider_circle_snapshot_restore_tree(root2, wb.data, wb.cursor), RET_OK);
+  snapshot_cost = time_now_us() - start;
+
+  /*作为对比：按persistent_properties逐个属性通过set_prop恢复*/
+  start = time_now_us();
+  for (i = 0; i < SNAPSHOT_WIDGETS_NR; i++) {
+    widget_t* src = widget_get_child(root, i);
+    widget_t* dst = widget_get_child(root2, i);
+    const char** props = src->vt->persistent_properties;
+
+    while (props != NULL && *props != NULL) {
+      value_t v;
+      if (widget_get_prop(src, *props, &v) == RET_OK) {
+        widget_set_prop(dst, *props, &v);
+      }
+      props++;
+    }
+  }
+  set_prop_cost = time_now_us() - start;
+
+  for (i = 0; i < SNAPSHOT_WIDGETS_NR; i++) {
+    ASSERT_EQ(SLIDER_CIRCLE(widget_get_child(root2, i))->value, i % 100);
+  }
+
+  log_info("restore %u widgets(%u bytes): snapshot %llu us, set_prop %llu us\n",
+           SNAPSHOT_WIDGETS_NR, wb.cursor, (unsigned long long)snapshot_cost,
+           (unsigned long long)set_prop_cost);
+
+  wbuffer_deinit(&wb);
+  widget_destroy(root);
+  widget_destroy(root2);
+}
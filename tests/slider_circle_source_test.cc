@@ -0,0 +1,92 @@
+﻿#include "widgets/view.h"
+#include "slider_circle/slider_circle.h"
+#include "slider_circle/gauge_circle.h"
+#include "slider_circle/slider_circle_source.h"
+#include "gtest/gtest.h"
+
+static ret_t on_value_event(void* ctx, event_t* e) {
+  uint32_t* count = (uint32_t*)ctx;
+  (*count)++;
+
+  return RET_OK;
+}
+
+TEST(slider_circle_source, publish) {
+  uint32_t events = 0;
+  widget_t* root = view_create(NULL, 0, 0, 400, 200);
+  widget_t* a = slider_circle_create(root, 0, 0, 100, 100);
+  widget_t* b = gauge_circle_create(root, 100, 0, 100, 100);
+  slider_circle_source_t* source = slider_circle_source_create();
+  ASSERT_TRUE(source != NULL);
+
+  widget_on(a, EVT_VALUE_WILL_CHANGE, on_value_event, &events);
+  widget_on(a, EVT_VALUE_CHANGED, on_value_event, &events);
+  slider_circle_set_step(b, 10);
+
+  /*没有发布过时不改变控件的值*/
+  slider_circle_set_value(a, 5);
+  ASSERT_EQ(slider_circle_bind_source(a, source), RET_OK);
+  ASSERT_EQ(slider_circle_bind_source(b, source), RET_OK);
+  ASSERT_EQ(widget_get_prop_int(a, WIDGET_PROP_VALUE, 0), 5);
+  events = 0;
+
+  /*发布时只标记为需要重绘，不分发事件，读取时按各自的step处理*/
+  a->dirty = FALSE;
+  b->dirty = FALSE;
+  ASSERT_EQ(slider_circle_source_publish(source, 42), RET_OK);
+  ASSERT_TRUE(a->dirty);
+  ASSERT_TRUE(b->dirty);
+  ASSERT_EQ(events, 0u);
+  ASSERT_EQ(widget_get_prop_int(a, WIDGET_PROP_VALUE, 0), 42);
+  ASSERT_EQ(widget_get_prop_int(b, WIDGET_PROP_VALUE, 0), 40);
+
+  /*不可见的控件不刷新*/
+  widget_set_visible(b, FALSE);
+  b->dirty = FALSE;
+  ASSERT_EQ(slider_circle_source_publish(source, 60), RET_OK);
+  ASSERT_FALSE(b->dirty);
+  ASSERT_EQ(widget_get_prop_int(b, WIDGET_PROP_VALUE, 0), 60);
+
+  /*销毁控件时自动解除绑定*/
+  widget_destroy(b);
+  ASSERT_EQ(source->widgets.size, 1u);
+
+  /*销毁共享的值后控件保留最后的值*/
+  ASSERT_EQ(slider_circle_source_destroy(source), RET_OK);
+  ASSERT_TRUE(SLIDER_CIRCLE(a)->source == NULL);
+  ASSERT_EQ(widget_get_prop_int(a, WIDGET_PROP_VALUE, 0), 60);
+
+  widget_destroy(root);
+}
+
+static ret_t on_old_value(void* ctx, event_t* e) {
+  double* old = (double*)ctx;
+  *old = value_double(&(value_change_event_cast(e)->old_value));
+
+  return RET_OK;
+}
+
+TEST(slider_circle_source, set_value) {
+  uint32_t events = 0;
+  double old = 0;
+  widget_t* a = slider_circle_create(NULL, 0, 0, 100, 100);
+  slider_circle_source_t* source = slider_circle_source_create();
+
+  ASSERT_EQ(slider_circle_bind_source(a, source), RET_OK);
+  widget_on(a, EVT_VALUE_CHANGED, on_value_event, &events);
+  widget_on(a, EVT_VALUE_WILL_CHANGE, on_old_value, &old);
+
+  /*设置的值和发布的值一样，没有变化*/
+  ASSERT_EQ(slider_circle_source_publish(source, 30), RET_OK);
+  ASSERT_EQ(slider_circle_set_value(a, 30), RET_OK);
+  ASSERT_EQ(events, 0u);
+
+  /*事件中的旧值是发布的值*/
+  ASSERT_EQ(slider_circle_source_publish(source, 50), RET_OK);
+  ASSERT_EQ(slider_circle_set_value(a, 70), RET_OK);
+  ASSERT_EQ(events, 1u);
+  ASSERT_EQ(old, 50);
+
+  slider_circle_source_destroy(source);
+  widget_destroy(a);
+}
@@ -0,0 +1,94 @@
+﻿#include "slider_circle_register.h"
+#include "slider_circle/slider_circle_sprite.h"
+#include "gtest/gtest.h"
+
+TEST(slider_circle_sprite, shared) {
+  point_t pos = {0, 0};
+  point_t pos1 = {0, 0};
+  color_t color = color_init(0x20, 0x80, 0xff, 0xff);
+  bitmap_t* b = NULL;
+  bitmap_t* b1 = NULL;
+
+  ASSERT_EQ(slider_circle_sprite_clear(), RET_OK);
+
+  b = slider_circle_sprite_get(10, color, 50.0f, 60.0f, &pos);
+  ASSERT_TRUE(b != NULL);
+  ASSERT_EQ(b->w, 23);
+  ASSERT_EQ(b->h, 23);
+  ASSERT_EQ(pos.x, 39);
+  ASSERT_EQ(pos.y, 49);
+
+  /*外观和相位相同时共用同一个位图*/
+  ASSERT_EQ(slider_circle_sprite_get(10, color, 80.0f, 20.0f, &pos1), b);
+  ASSERT_EQ(pos1.x, 69);
+  ASSERT_EQ(pos1.y, 9);
+  ASSERT_EQ(slider_circle_sprite_get(10, color, 50.9f, 60.0f, &pos1), b);
+  ASSERT_EQ(pos1.x, 40);
+
+  /*不同的相位使用不同的位图*/
+  b1 = slider_circle_sprite_get(10, color, 50.5f, 60.0f, &pos1);
+  ASSERT_TRUE(b1 != NULL && b1 != b);
+  ASSERT_EQ(pos1.x, 39);
+  ASSERT_EQ(slider_circle_sprite_count(), 1u);
+
+  ASSERT_EQ(slider_circle_sprite_clear(), RET_OK);
+  ASSERT_EQ(slider_circle_sprite_count(), 0u);
+}
+
+TEST(slider_circle_sprite, pixels) {
+  point_t pos = {0, 0};
+  color_t color = color_init(0x20, 0x80, 0xff, 0xff);
+  bitmap_t* b = slider_circle_sprite_get(8, color, 30.25f, 30.0f, &pos);
+  uint8_t* data = NULL;
+  uint32_t line_length = 0;
+  ASSERT_TRUE(b != NULL);
+
+  data = bitmap_lock_buffer_for_read(b);
+  line_length = bitmap_get_line_length(b);
+  ASSERT_TRUE(data != NULL);
+
+  /*中心不透明，角上透明*/
+  ASSERT_EQ(data[9 * line_length + 9 * 4 + 0], 0x20);
+  ASSERT_EQ(data[9 * line_length + 9 * 4 + 3], 0xff);
+  ASSERT_EQ(data[0 * line_length + 0 * 4 + 3], 0x00);
+  ASSERT_EQ(data[18 * line_length + 18 * 4 + 3], 0x00);
+  /*中心向右偏了1/4像素，左边缘的覆盖率比右边缘高*/
+  ASSERT_GT(data[9 * line_length + 1 * 4 + 3], data[9 * line_length + 17 * 4 + 3]);
+  bitmap_unlock_buffer(b);
+
+  ASSERT_EQ(slider_circle_sprite_clear(), RET_OK);
+}
+
+TEST(slider_circle_sprite, evict) {
+  uint32_t i = 0;
+  point_t pos = {0, 0};
+  color_t color = color_init(0x20, 0x80, 0xff, 0xff);
+
+  ASSERT_EQ(slider_circle_sprite_clear(), RET_OK);
+  for (i = 0; i < 2 * SLIDER_CIRCLE_SPRITE_CACHE_MAX; i++) {
+    color.rgba.r = i;
+    ASSERT_TRUE(slider_circle_sprite_get(6, color, 10, 10, &pos) != NULL);
+    ASSERT_LE(slider_circle_sprite_count(), SLIDER_CIRCLE_SPRITE_CACHE_MAX);
+  }
+
+  /*半径为0、太大或者透明的拖动块不缓存*/
+  ASSERT_TRUE(slider_circle_sprite_get(0, color, 10, 10, &pos) == NULL);
+  ASSERT_TRUE(slider_circle_sprite_get(SLIDER_CIRCLE_SPRITE_MAX_SIZE + 1, color, 10, 10, &pos) ==
+              NULL);
+  color.rgba.a = 0;
+  ASSERT_TRUE(slider_circle_sprite_get(6, color, 10, 10, &pos) == NULL);
+
+  ASSERT_EQ(slider_circle_sprite_clear(), RET_OK);
+}
+
+TEST(slider_circle_sprite, cache_deinit) {
+  point_t pos = {0, 0};
+  color_t color = color_init(0x20, 0x80, 0xff, 0xff);
+
+  ASSERT_TRUE(slider_circle_sprite_get(6, color, 10, 10, &pos) != NULL);
+  ASSERT_EQ(slider_circle_sprite_count(), 1u);
+
+  /*退出前释放缓存的位图*/
+  ASSERT_EQ(slider_circle_sprite_cache_deinit(), RET_OK);
+  ASSERT_EQ(slider_circle_sprite_count(), 0u);
+}
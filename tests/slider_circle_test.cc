@@ -1,4 +1,8 @@
-﻿#include "slider_circle/slider_circle.h"
+﻿#include "tkc/mem.h"
+#include "slider_circle/slider_circle.h"
+#include "slider_circle/slider_circle_pool.h"
+#include "tkc/time_now.h"
+#include "lcd/lcd_mem_bgra8888.h"
 #include "gtest/gtest.h"
 
 TEST(slider_circle, basic) {
@@ -86,6 +90,18 @@ TEST(slider_circle, set_get) {
   ASSERT_EQ(widget_set_prop_int(w, SLIDER_CIRCLE_PROP_END_ANGLE, 10), RET_OK);
   ASSERT_EQ(widget_get_prop_int(w, SLIDER_CIRCLE_PROP_END_ANGLE, 0), 10);
 
+  ASSERT_EQ(widget_set_prop_bool(w, SLIDER_CIRCLE_PROP_SHOW_TICKS, true), RET_OK);
+  ASSERT_EQ(widget_get_prop_bool(w, SLIDER_CIRCLE_PROP_SHOW_TICKS, false), true);
+
+  ASSERT_EQ(widget_set_prop_bool(w, SLIDER_CIRCLE_PROP_TRACK_DITHER, true), RET_OK);
+  ASSERT_EQ(widget_get_prop_bool(w, SLIDER_CIRCLE_PROP_TRACK_DITHER, false), true);
+
+  ASSERT_EQ(widget_set_prop_int(w, SLIDER_CIRCLE_PROP_MAJOR_TICKS, 5), RET_OK);
+  ASSERT_EQ(widget_get_prop_int(w, SLIDER_CIRCLE_PROP_MAJOR_TICKS, 0), 5);
+
+  ASSERT_EQ(widget_set_prop_int(w, SLIDER_CIRCLE_PROP_TICK_MIN_GAP, 6), RET_OK);
+  ASSERT_EQ(widget_get_prop_int(w, SLIDER_CIRCLE_PROP_TICK_MIN_GAP, 0), 6);
+
   widget_destroy(w);
 }
 
@@ -124,4 +140,433 @@ TEST(slider_circle, others) {
   ASSERT_EQ(slider_circle_point_to_value(w, 60, 20), 35);
 
   widget_destroy(w);
-}
\ No newline at end of file
+}
+
+TEST(slider_circle, ticks) {
+  canvas_t c;
+  slider_circle_ticks_t ticks;
+  slider_circle_ticks_params_t params;
+
+  memset(&c, 0x00, sizeof(c));
+  memset(&params, 0x00, sizeof(params));
+  params.min = 0;
+  params.max = 100;
+  params.step = 1;
+  params.w = 200;
+  params.h = 200;
+  params.start_angle = 0;
+  params.end_angle = 360;
+  params.line_width = 8;
+  params.major_ticks = 10;
+  params.min_gap = 4;
+
+  slider_circle_ticks_init(&ticks);
+  ASSERT_EQ(slider_circle_ticks_update(&ticks, &c, &params), RET_OK);
+  ASSERT_EQ(ticks.major_nr, 10u);
+  ASSERT_EQ(ticks.minor_nr, 90u);
+  ASSERT_EQ(ticks.labels_nr, 0u);
+
+  /*参数不变时不重新计算*/
+  ticks.lines[0].x = -1;
+  ASSERT_EQ(slider_circle_ticks_update(&ticks, &c, &params), RET_OK);
+  ASSERT_EQ(ticks.lines[0].x, -1);
+
+  /*间距太小时抽稀*/
+  params.min_gap = 10;
+  ASSERT_EQ(slider_circle_ticks_update(&ticks, &c, &params), RET_OK);
+  ASSERT_EQ(ticks.major_nr, 10u);
+  ASSERT_EQ(ticks.minor_nr, 40u);
+
+  /*拷贝后参数相同时直接使用拷贝的布局*/
+  slider_circle_ticks_t copy;
+  slider_circle_ticks_init(&copy);
+  ASSERT_EQ(slider_circle_ticks_copy(&copy, &ticks), RET_OK);
+  ASSERT_EQ(copy.minor_nr, 40u);
+  copy.lines[0].x = -2;
+  ASSERT_EQ(slider_circle_ticks_update(&copy, &c, &params), RET_OK);
+  ASSERT_EQ(copy.lines[0].x, -2);
+  slider_circle_ticks_deinit(&copy);
+
+  slider_circle_ticks_deinit(&ticks);
+}
+
+TEST(slider_circle, ticks_format_in_place) {
+  canvas_t c;
+  rect_t r = rect_init(0, 0, 200, 200);
+  lcd_t* lcd = lcd_mem_bgra8888_create(200, 200, TRUE);
+  widget_t* w = NULL;
+  slider_circle_t* s = NULL;
+  char* format = NULL;
+
+  /*format在内存池中时原地修改，地址不变*/
+  ASSERT_EQ(slider_circle_pool_reserve(1), RET_OK);
+  w = slider_circle_create(NULL, 0, 0, 200, 200);
+  s = SLIDER_CIRCLE(w);
+  slider_circle_set_show_ticks(w, TRUE);
+  slider_circle_set_format(w, "%d");
+  format = s->format;
+  canvas_init(&c, lcd, font_manager());
+
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  widget_on_paint_background(w, &c);
+  canvas_end_frame(&c);
+  ASSERT_GT(s->ticks.labels_nr, 0u);
+  ASSERT_EQ(wcscmp(s->ticks.labels[0].text, L"0"), 0);
+
+  slider_circle_set_format(w, "%dV");
+  ASSERT_EQ(s->format, format);
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  widget_on_paint_background(w, &c);
+  canvas_end_frame(&c);
+  ASSERT_EQ(wcscmp(s->ticks.labels[0].text, L"0V"), 0);
+
+  widget_destroy(w);
+  slider_circle_pool_release();
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
+
+TEST(slider_circle, format_value) {
+  char buff[32];
+
+  ASSERT_EQ(slider_circle_format_value(buff, sizeof(buff), "%d", 30.6), RET_OK);
+  ASSERT_STREQ(buff, "31");
+
+  ASSERT_EQ(slider_circle_format_value(buff, sizeof(buff), "%2.2lf", 1.5), RET_OK);
+  ASSERT_STREQ(buff, "1.50");
+
+  ASSERT_EQ(slider_circle_format_value(buff, sizeof(buff), "%%%d", 30), RET_OK);
+  ASSERT_STREQ(buff, "%30");
+
+  /*参数的类型与长度修饰符一致*/
+  ASSERT_EQ(slider_circle_format_value(buff, sizeof(buff), "%ld", 30.6), RET_OK);
+  ASSERT_STREQ(buff, "31");
+  ASSERT_EQ(slider_circle_format_value(buff, sizeof(buff), "%lld", 3000000000.0), RET_OK);
+  ASSERT_STREQ(buff, "3000000000");
+  ASSERT_EQ(slider_circle_format_value(buff, sizeof(buff), "%hd", 12), RET_OK);
+  ASSERT_STREQ(buff, "12");
+  ASSERT_EQ(slider_circle_format_value(buff, sizeof(buff), "%.1Lf", 1.25), RET_OK);
+  ASSERT_STREQ(buff, "1.2");
+
+  /*不支持的长度修饰符*/
+  ASSERT_EQ(slider_circle_format_value(buff, sizeof(buff), "%zd", 30), RET_BAD_PARAMS);
+  ASSERT_STREQ(buff, "");
+  ASSERT_EQ(slider_circle_format_value(buff, sizeof(buff), "%lc", 65), RET_BAD_PARAMS);
+}
+
+TEST(slider_circle, clone) {
+  widget_t* w = slider_circle_create(NULL, 10, 20, 100, 100);
+  slider_circle_t* s = SLIDER_CIRCLE(w);
+
+  slider_circle_set_max(w, 200);
+  slider_circle_set_value(w, 150);
+  slider_circle_set_start_angle(w, -30);
+  slider_circle_set_line_cap(w, "round");
+  slider_circle_set_format(w, "%.1f");
+  slider_circle_set_show_ticks(w, TRUE);
+
+  widget_t* w2 = widget_clone(w, NULL);
+  slider_circle_t* s2 = SLIDER_CIRCLE(w2);
+  ASSERT_TRUE(s2 != NULL);
+  ASSERT_EQ(s2->max, 200);
+  ASSERT_EQ(s2->value, 150);
+  ASSERT_EQ(s2->start_angle, -30);
+  ASSERT_EQ(s2->show_ticks, TRUE);
+  ASSERT_STREQ(s2->line_cap, "round");
+  ASSERT_STREQ(s2->format, "%.1f");
+  ASSERT_TRUE(s2->format != s->format);
+
+  widget_destroy(w);
+  widget_destroy(w2);
+}
+
+TEST(slider_circle, clone_benchmark) {
+  uint32_t i = 0;
+  uint64_t start = 0;
+  uint64_t fast_cost = 0;
+  uint64_t generic_cost = 0;
+  const uint32_t nr = 500;
+  widget_t* w = slider_circle_create(NULL, 10, 20, 100, 100);
+  widget_t* fast = slider_circle_create(NULL, 0, 0, 100, 100);
+  widget_t* generic = slider_circle_create(NULL, 0, 0, 100, 100);
+
+  slider_circle_set_max(w, 200);
+  slider_circle_set_value(w, 150);
+  slider_circle_set_line_cap(w, "round");
+  slider_circle_set_format(w, "%.1f");
+
+  start = time_now_us();
+  for (i = 0; i < nr; i++) {
+    widget_clone(w, fast);
+  }
+  fast_cost = time_now_us() - start;
+
+  /*作为对比：按clone_properties逐个属性通过get_prop/set_prop拷贝*/
+  start = time_now_us();
+  for (i = 0; i < nr; i++) {
+    widget_t* clone = slider_circle_create(generic, w->x, w->y, w->w, w->h);
+    widget_copy_props(clone, w, w->vt->clone_properties);
+  }
+  generic_cost = time_now_us() - start;
+
+  ASSERT_EQ(SLIDER_CIRCLE(widget_get_child(fast, nr - 1))->value, 150);
+  ASSERT_EQ(SLIDER_CIRCLE(widget_get_child(generic, nr - 1))->value, 150);
+  log_info("clone %u widgets: on_copy %llu us, clone_properties %llu us\n", nr,
+           (unsigned long long)fast_cost, (unsigned long long)generic_cost);
+
+  widget_destroy(w);
+  widget_destroy(fast);
+  widget_destroy(generic);
+}
+
+TEST(slider_circle, state_dedup) {
+  pointer_event_t e;
+  widget_t* w = slider_circle_create(NULL, 0, 0, 100, 100);
+
+  /*状态变化了，但解析出的样式值都一样，不重绘*/
+  w->dirty = FALSE;
+  widget_dispatch(w, pointer_event_init(&e, EVT_POINTER_MOVE, w, 10, 10));
+  ASSERT_STREQ(w->state, WIDGET_STATE_OVER);
+  ASSERT_FALSE(w->dirty);
+
+  /*状态没有变化，不重绘*/
+  widget_dispatch(w, pointer_event_init(&e, EVT_POINTER_MOVE, w, 11, 11));
+  ASSERT_FALSE(w->dirty);
+
+  /*样式值变化时重绘*/
+  widget_set_style_color(w, "normal:fg_color", 0xff0000ff);
+  w->dirty = FALSE;
+  widget_dispatch(w, pointer_event_init(&e, EVT_POINTER_LEAVE, w, 200, 200));
+  ASSERT_STREQ(w->state, WIDGET_STATE_NORMAL);
+  ASSERT_TRUE(w->dirty);
+
+  /*只有widget绘制的边框样式变化时也重绘*/
+  widget_set_style_int(w, "over:border_width", 3);
+  w->dirty = FALSE;
+  widget_dispatch(w, pointer_event_init(&e, EVT_POINTER_MOVE, w, 10, 10));
+  ASSERT_STREQ(w->state, WIDGET_STATE_OVER);
+  ASSERT_TRUE(w->dirty);
+
+  widget_destroy(w);
+}
+
+static uint8_t track_red_at(lcd_t* lcd, uint32_t x, uint32_t y) {
+  lcd_mem_t* mem = (lcd_mem_t*)lcd;
+
+  return mem->offline_fb[y * mem->line_length + x * 4 + 2];
+}
+
+TEST(slider_circle, track_overdraw) {
+  canvas_t c;
+  rect_t r = rect_init(0, 0, 100, 100);
+  lcd_t* lcd = lcd_mem_bgra8888_create(100, 100, TRUE);
+  widget_t* w = slider_circle_create(NULL, 0, 0, 100, 100);
+
+  slider_circle_set_start_angle(w, 0);
+  slider_circle_set_end_angle(w, 360);
+  slider_circle_set_value(w, 50);
+  slider_circle_set_bg_line_width(w, 8);
+  slider_circle_set_fg_line_width(w, 8);
+  widget_set_style_color(w, "normal:bg_color", 0xff0000ff);
+  widget_set_style_color(w, "normal:fg_color", 0xff00ff00);
+  canvas_init(&c, lcd, font_manager());
+
+  /*填充部分不透明并且和轨道一样宽：被填充的下半圈不画轨道，上半圈画轨道*/
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  canvas_set_fill_color(&c, color_init(0, 0, 0, 0xff));
+  canvas_fill_rect(&c, 0, 0, 100, 100);
+  widget_on_paint_background(w, &c);
+  canvas_end_frame(&c);
+  ASSERT_EQ(track_red_at(lcd, 50, 96), 0);
+  ASSERT_GT(track_red_at(lcd, 50, 4), 0xf0);
+
+  /*填充部分比轨道窄时仍然画整个轨道*/
+  slider_circle_set_fg_line_width(w, 4);
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  canvas_fill_rect(&c, 0, 0, 100, 100);
+  widget_on_paint_background(w, &c);
+  canvas_end_frame(&c);
+  ASSERT_GT(track_red_at(lcd, 50, 96), 0xf0);
+
+  widget_destroy(w);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
+
+TEST(slider_circle, style_in_place) {
+  canvas_t c;
+  rect_t r = rect_init(0, 0, 100, 100);
+  lcd_t* lcd = lcd_mem_bgra8888_create(100, 100, TRUE);
+  widget_t* w = slider_circle_create(NULL, 0, 0, 100, 100);
+
+  slider_circle_set_bg_line_width(w, 8);
+  widget_set_style_color(w, "normal:bg_color", 0xff0000ff);
+  canvas_init(&c, lcd, font_manager());
+
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  widget_on_paint_background(w, &c);
+  canvas_end_frame(&c);
+  ASSERT_GT(track_red_at(lcd, 50, 4), 0xf0);
+
+  /*第二次修改的是同一个可修改的样式，样式对象和状态都没有变化*/
+  widget_set_style_color(w, "normal:bg_color", 0xffff0000);
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  canvas_set_fill_color(&c, color_init(0, 0, 0, 0xff));
+  canvas_fill_rect(&c, 0, 0, 100, 100);
+  widget_on_paint_background(w, &c);
+  canvas_end_frame(&c);
+  ASSERT_EQ(track_red_at(lcd, 50, 4), 0);
+
+  widget_destroy(w);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
+
+TEST(slider_circle, text) {
+  widget_t* w = slider_circle_create(NULL, 0, 0, 100, 100);
+
+  /*text随值和format更新，不用等到绘制*/
+  ASSERT_EQ(wcscmp(w->text.str, L"0"), 0);
+  slider_circle_set_value(w, 30);
+  ASSERT_EQ(wcscmp(w->text.str, L"30"), 0);
+  slider_circle_set_format(w, "%.1f%%");
+  ASSERT_EQ(wcscmp(w->text.str, L"30.0%"), 0);
+
+  /*不显示文本时不更新*/
+  slider_circle_set_show_text(w, FALSE);
+  slider_circle_set_value(w, 40);
+  ASSERT_EQ(wcscmp(w->text.str, L"30.0%"), 0);
+  slider_circle_set_show_text(w, TRUE);
+  ASSERT_EQ(wcscmp(w->text.str, L"40.0%"), 0);
+
+  widget_destroy(w);
+}
+
+static ret_t on_value_changed_count(void* ctx, event_t* e) {
+  (*(uint32_t*)ctx)++;
+
+  return RET_OK;
+}
+
+TEST(slider_circle, render_key) {
+  canvas_t c;
+  uint32_t changed = 0;
+  rect_t r = rect_init(0, 0, 100, 100);
+  lcd_t* lcd = lcd_mem_bgra8888_create(100, 100, TRUE);
+  widget_t* w = slider_circle_create(NULL, 0, 0, 100, 100);
+
+  slider_circle_set_step(w, 0);
+  slider_circle_set_format(w, "%d");
+  slider_circle_set_show_text(w, TRUE);
+  widget_on(w, EVT_VALUE_CHANGED, on_value_changed_count, &changed);
+  canvas_init(&c, lcd, font_manager());
+
+  slider_circle_set_value(w, 30.2);
+  canvas_begin_frame(&c, &r, LCD_DRAW_OFFLINE);
+  widget_paint(w, &c);
+  canvas_end_frame(&c);
+
+  /*拖动点移动不到半个像素，文本也一样：事件照常分发，但是不重绘*/
+  w->dirty = FALSE;
+  changed = 0;
+  slider_circle_set_value(w, 30.21);
+  ASSERT_EQ(changed, 1u);
+  ASSERT_FALSE(w->dirty);
+
+  /*文本变化时重绘*/
+  slider_circle_set_value(w, 31);
+  ASSERT_EQ(changed, 2u);
+  ASSERT_TRUE(w->dirty);
+
+  widget_destroy(w);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
+
+static void paint_foreground(widget_t* w, canvas_t* c, lcd_t* lcd) {
+  rect_t r = rect_init(0, 0, lcd->w, lcd->h);
+
+  canvas_begin_frame(c, &r, LCD_DRAW_OFFLINE);
+  canvas_set_fill_color(c, color_init(0, 0, 0, 0xff));
+  canvas_fill_rect(c, 0, 0, lcd->w, lcd->h);
+  widget_on_paint_self(w, c);
+  canvas_end_frame(c);
+}
+
+TEST(slider_circle, specialized_paint) {
+  canvas_t c;
+  uint32_t i = 0;
+  const char* caps[] = {"butt", "round", "square"};
+  lcd_t* lcd = lcd_mem_bgra8888_create(100, 100, TRUE);
+  lcd_mem_t* mem = (lcd_mem_t*)lcd;
+  uint32_t size = mem->line_length * 100;
+  uint8_t* expected = (uint8_t*)TKMEM_ALLOC(size);
+  widget_t* w = slider_circle_create(NULL, 0, 0, 100, 100);
+  slider_circle_t* s = SLIDER_CIRCLE(w);
+
+  ASSERT_TRUE(expected != NULL);
+  canvas_init(&c, lcd, font_manager());
+  slider_circle_set_value(w, 40);
+  slider_circle_set_fg_line_width(w, 8);
+
+  /*每种组合下特化的函数和通用的函数画出的结果完全一样*/
+  for (i = 0; i < 2 * 2 * 2 * ARRAY_SIZE(caps); i++) {
+    slider_circle_set_counter_clock_wise(w, (i & 1) != 0);
+    slider_circle_set_header_size(w, (i & 2) != 0 ? 8 : 0);
+    slider_circle_set_show_text(w, (i & 4) != 0);
+    slider_circle_set_line_cap(w, caps[i / 8]);
+    ASSERT_EQ(s->cap, slider_circle_raster_cap_from_str(caps[i / 8]));
+    ASSERT_TRUE(s->paint_self != NULL);
+
+    slider_circle_set_specialized_paint(FALSE);
+    paint_foreground(w, &c, lcd);
+    memcpy(expected, mem->offline_fb, size);
+
+    slider_circle_set_specialized_paint(TRUE);
+    paint_foreground(w, &c, lcd);
+    ASSERT_EQ(memcmp(expected, mem->offline_fb, size), 0);
+  }
+
+  TKMEM_FREE(expected);
+  widget_destroy(w);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
+
+TEST(slider_circle, specialized_paint_benchmark) {
+  canvas_t c;
+  uint32_t i = 0;
+  uint64_t start = 0;
+  uint64_t specialized_cost = 0;
+  uint64_t generic_cost = 0;
+  const uint32_t nr = 2000;
+  lcd_t* lcd = lcd_mem_bgra8888_create(100, 100, TRUE);
+  widget_t* w = slider_circle_create(NULL, 0, 0, 100, 100);
+
+  slider_circle_set_value(w, 40);
+  slider_circle_set_line_cap(w, "round");
+  slider_circle_set_show_text(w, FALSE);
+  canvas_init(&c, lcd, font_manager());
+  paint_foreground(w, &c, lcd);
+
+  slider_circle_set_specialized_paint(FALSE);
+  start = time_now_us();
+  for (i = 0; i < nr; i++) {
+    paint_foreground(w, &c, lcd);
+  }
+  generic_cost = time_now_us() - start;
+
+  slider_circle_set_specialized_paint(TRUE);
+  start = time_now_us();
+  for (i = 0; i < nr; i++) {
+    paint_foreground(w, &c, lcd);
+  }
+  specialized_cost = time_now_us() - start;
+
+  log_info("paint %u times: specialized %llu us, generic %llu us\n", nr,
+           (unsigned long long)specialized_cost, (unsigned long long)generic_cost);
+
+  widget_destroy(w);
+  canvas_reset(&c);
+  lcd_destroy(lcd);
+}
@@ -0,0 +1,53 @@
+﻿#include "slider_circle/slider_circle.h"
+#include "slider_circle/slider_circle_trace.h"
+#include "gtest/gtest.h"
+
+#ifdef WITH_SLIDER_CIRCLE_TRACE
+
+TEST(slider_circle_trace, record) {
+  str_t str;
+  uint32_t i = 0;
+
+  ASSERT_EQ(slider_circle_trace_reset(), RET_OK);
+  ASSERT_EQ(slider_circle_trace_count(), 0u);
+
+  ASSERT_EQ(slider_circle_trace_record("test", time_now_us()), RET_OK);
+  ASSERT_EQ(slider_circle_trace_count(), 1u);
+
+  str_init(&str, 1024);
+  ASSERT_EQ(slider_circle_trace_dump(&str), RET_OK);
+  ASSERT_TRUE(strstr(str.str, "\"traceEvents\":[") != NULL);
+  ASSERT_TRUE(strstr(str.str, "\"name\":\"test\"") != NULL);
+  ASSERT_TRUE(strstr(str.str, "\"ph\":\"X\"") != NULL);
+  str_reset(&str);
+
+  /*满了之后覆盖最早的事件*/
+  for (i = 0; i < SLIDER_CIRCLE_TRACE_CAPACITY + 10; i++) {
+    slider_circle_trace_record("overflow", time_now_us());
+  }
+  ASSERT_EQ(slider_circle_trace_count(), (uint32_t)SLIDER_CIRCLE_TRACE_CAPACITY);
+
+  str_init(&str, 1024);
+  ASSERT_EQ(slider_circle_trace_dump(&str), RET_OK);
+  ASSERT_TRUE(strstr(str.str, "\"name\":\"test\"") == NULL);
+  str_reset(&str);
+}
+
+TEST(slider_circle_trace, on_event) {
+  str_t str;
+  event_t e = event_init(EVT_THEME_CHANGED, NULL);
+  widget_t* w = slider_circle_create(NULL, 0, 0, 100, 100);
+
+  ASSERT_EQ(slider_circle_trace_reset(), RET_OK);
+  widget_dispatch(w, &e);
+  ASSERT_GE(slider_circle_trace_count(), 1u);
+
+  str_init(&str, 1024);
+  ASSERT_EQ(slider_circle_trace_dump(&str), RET_OK);
+  ASSERT_TRUE(strstr(str.str, "\"name\":\"on_event\"") != NULL);
+  str_reset(&str);
+
+  widget_destroy(w);
+}
+
+#endif /*WITH_SLIDER_CIRCLE_TRACE*/
@@ -0,0 +1,156 @@
+﻿#include "tkc/time_now.h"
+#include "widgets/view.h"
+#include "slider_circle_register.h"
+#include "slider_circle/slider_circle.h"
+#include "slider_circle/slider_circle_raster.h"
+#include "slider_circle/slider_circle_sprite.h"
+#include "slider_circle/slider_circle_warmup.h"
+#include "gtest/gtest.h"
+
+#define WARMUP_WIDGETS_NR 200
+
+TEST(slider_circle_raster, arc) {
+  uint8_t cov[200];
+  slider_circle_raster_arc_t arc;
+
+  /*圆心(100,100)，半径80，线宽10，从0度到90度(右下四分之一)*/
+  memset(&arc, 0x00, sizeof(arc));
+  arc.cx = 100;
+  arc.cy = 100;
+  arc.r = 80;
+  arc.line_width = 10;
+  arc.start_angle = 0;
+  arc.end_angle = M_PI / 2;
+  arc.cap = SLIDER_CIRCLE_RASTER_CAP_BUTT;
+
+  /*45度方向上线条中间完全覆盖，圆心和线条外面没有覆盖*/
+  slider_circle_raster_span(&arc, 0, 156, 200, cov);
+  ASSERT_EQ(cov[156], 255);
+  ASSERT_EQ(cov[100], 0);
+  ASSERT_EQ(cov[199], 0);
+
+  /*在角度范围之外(上半部分)没有覆盖*/
+  slider_circle_raster_span(&arc, 0, 43, 200, cov);
+  ASSERT_EQ(cov[156], 0);
+
+  /*圆头在起点外面(0度上方)有覆盖，平头没有*/
+  slider_circle_raster_span(&arc, 0, 97, 200, cov);
+  ASSERT_EQ(cov[180], 0);
+  arc.cap = SLIDER_CIRCLE_RASTER_CAP_ROUND;
+  slider_circle_raster_span(&arc, 0, 97, 200, cov);
+  ASSERT_EQ(cov[180], 255);
+}
+
+TEST(slider_circle_raster, square_cap) {
+  uint8_t cov[200];
+  uint8_t prepared_cov[200];
+  slider_circle_raster_arc_t arc;
+  slider_circle_raster_prepared_t prepared;
+
+  memset(&arc, 0x00, sizeof(arc));
+  arc.cx = 100;
+  arc.cy = 100;
+  arc.r = 80;
+  arc.line_width = 10;
+  arc.start_angle = 0;
+  arc.end_angle = M_PI / 2;
+  arc.cap = SLIDER_CIRCLE_RASTER_CAP_SQUARE;
+
+  /*方头在起点外面延长半个线宽(5个像素)*/
+  slider_circle_raster_span(&arc, 0, 97, 200, cov);
+  ASSERT_EQ(cov[180], 255);
+  slider_circle_raster_span(&arc, 0, 93, 200, cov);
+  ASSERT_EQ(cov[180], 0);
+
+  /*很短的圆弧两端延长之后，不会画到圆心另一侧*/
+  arc.end_angle = 0.01f;
+  slider_circle_raster_span(&arc, 0, 100, 200, cov);
+  ASSERT_EQ(cov[180], 255);
+  ASSERT_EQ(cov[20], 0);
+
+  ASSERT_EQ(slider_circle_raster_prepare(&prepared, &arc), RET_OK);
+  slider_circle_raster_span_prepared(&prepared, 0, 100, 200, prepared_cov);
+  ASSERT_EQ(memcmp(cov, prepared_cov, sizeof(cov)), 0);
+}
+
+TEST(slider_circle_raster, disk) {
+  uint8_t cov[20];
+  slider_circle_raster_arc_t arc;
+
+  memset(&arc, 0x00, sizeof(arc));
+  arc.cx = 10;
+  arc.cy = 10;
+  arc.r = 8;
+
+  slider_circle_raster_span(&arc, 0, 9, 20, cov);
+  ASSERT_EQ(cov[10], 255);
+  ASSERT_EQ(cov[0], 0);
+  ASSERT_GT(cov[2], 0);
+  ASSERT_LT(cov[1], 255);
+}
+
+static widget_t* warmup_create_tree(uint32_t nr) {
+  uint32_t i = 0;
+  widget_t* root = view_create(NULL, 0, 0, 800, 480);
+
+  for (i = 0; i < nr; i++) {
+    widget_t* w = slider_circle_create(root, 0, 0, 200, 200);
+    slider_circle_set_bg_line_width(w, 12);
+    slider_circle_set_line_cap(w, "round");
+  }
+
+  return root;
+}
+
+TEST(slider_circle_warmup, adopt) {
+  widget_t* root = warmup_create_tree(4);
+  slider_circle_t* s = SLIDER_CIRCLE(widget_get_child(root, 0));
+
+  /*没有启动工作线程时什么也不做*/
+  ASSERT_EQ(slider_circle_warmup(root), RET_OK);
+  ASSERT_TRUE(s->track_layer == NULL);
+
+  ASSERT_EQ(slider_circle_warmup_init(2), RET_OK);
+  ASSERT_EQ(slider_circle_sprite_clear(), RET_OK);
+  ASSERT_EQ(slider_circle_warmup(root), RET_OK);
+  ASSERT_EQ(slider_circle_warmup_wait(5000), RET_OK);
+
+  /*外观相同的拖动点共用预先生成的位图*/
+  ASSERT_EQ(slider_circle_sprite_count(), 1u);
+
+  if (s->track_layer != NULL) {
+    ASSERT_EQ(s->track_layer->state, SLIDER_CIRCLE_LAYER_READY);
+    ASSERT_TRUE(slider_circle_layer_adopt(s->track_layer, &(s->track_layer->key)) != NULL);
+    ASSERT_EQ(s->track_layer->state, SLIDER_CIRCLE_LAYER_ADOPTED);
+
+    /*参数变化后不再使用缓存层*/
+    slider_circle_layer_key_t key = s->track_layer->key;
+    key.arc.line_width++;
+    ASSERT_TRUE(slider_circle_layer_adopt(s->track_layer, &key) == NULL);
+  }
+
+  /*销毁还在排队的缓存层*/
+  ASSERT_EQ(slider_circle_warmup(root), RET_OK);
+  widget_destroy(root);
+  ASSERT_EQ(slider_circle_warmup_deinit(), RET_OK);
+  ASSERT_EQ(slider_circle_sprite_cache_deinit(), RET_OK);
+}
+
+TEST(slider_circle_warmup, scale) {
+  uint32_t threads = 0;
+
+  for (threads = 1; threads <= 4; threads *= 2) {
+    uint64_t start = 0;
+    widget_t* root = warmup_create_tree(WARMUP_WIDGETS_NR);
+
+    ASSERT_EQ(slider_circle_warmup_init(threads), RET_OK);
+    start = time_now_us();
+    slider_circle_warmup(root);
+    ASSERT_EQ(slider_circle_warmup_wait(60000), RET_OK);
+    log_info("warmup %u widgets with %u threads: %llu us\n", WARMUP_WIDGETS_NR, threads,
+             (unsigned long long)(time_now_us() - start));
+
+    ASSERT_EQ(slider_circle_warmup_deinit(), RET_OK);
+    widget_destroy(root);
+  }
+}
@@ -0,0 +1,92 @@
+﻿#include "tkc/mem.h"
+#include "slider_circle/slider_circle.h"
+#include "slider_circle/slider_circle_zones.h"
+#include "gtest/gtest.h"
+
+TEST(slider_circle_zones, parse) {
+  slider_circle_zones_t zones;
+
+  ASSERT_EQ(slider_circle_zones_parse(&zones, NULL), RET_OK);
+  ASSERT_EQ(zones.size, 0u);
+
+  /*按起始值排序，格式不正确的区间忽略，颜色中可以有逗号*/
+  ASSERT_EQ(slider_circle_zones_parse(&zones, "90,100,red; bad ;0, 10 ,rgba(0,255,0,0.5)"), RET_OK);
+  ASSERT_EQ(zones.size, 2u);
+  ASSERT_EQ(zones.zones[0].from, 0);
+  ASSERT_EQ(zones.zones[0].to, 10);
+  ASSERT_EQ(zones.zones[0].color.rgba.g, 0xff);
+  ASSERT_EQ(zones.zones[1].from, 90);
+  ASSERT_EQ(zones.zones[1].to, 100);
+  ASSERT_EQ(zones.zones[1].color.rgba.r, 0xff);
+
+  /*起始值大于结束值时交换*/
+  ASSERT_EQ(slider_circle_zones_parse(&zones, "20,10,red"), RET_OK);
+  ASSERT_EQ(zones.zones[0].from, 10);
+  ASSERT_EQ(zones.zones[0].to, 20);
+}
+
+TEST(slider_circle_zones, merge) {
+  slider_circle_zones_t zones;
+
+  /*颜色相同并且相连的区间合并*/
+  ASSERT_EQ(slider_circle_zones_parse(&zones, "80,90,#ffbf00;85,95,#ffbf00;90,100,red"), RET_OK);
+  ASSERT_EQ(zones.size, 2u);
+  ASSERT_EQ(zones.zones[0].from, 80);
+  ASSERT_EQ(zones.zones[0].to, 95);
+
+  /*颜色相同但不相连的区间不合并*/
+  ASSERT_EQ(slider_circle_zones_parse(&zones, "0,10,red;90,100,red"), RET_OK);
+  ASSERT_EQ(zones.size, 2u);
+}
+
+TEST(slider_circle_zones, raster_over) {
+  uint8_t* data = NULL;
+  slider_circle_raster_arc_t arc;
+  uint32_t line_length = 100 * 4;
+  color_t gray = color_init(0x80, 0x80, 0x80, 0xff);
+  color_t red = color_init(0xff, 0, 0, 0xff);
+
+  data = (uint8_t*)TKMEM_ALLOC(line_length * 100);
+  ASSERT_TRUE(data != NULL);
+  memset(data, 0x00, line_length * 100);
+
+  memset(&arc, 0x00, sizeof(arc));
+  arc.cx = 50;
+  arc.cy = 50;
+  arc.r = 40;
+  arc.line_width = 10;
+  arc.start_angle = 0;
+  arc.end_angle = M_PI * 2;
+  ASSERT_EQ(slider_circle_raster_rgba(&arc, gray, data, 100, 100, line_length), RET_OK);
+
+  /*右下四分之一叠加红色，其它部分保持轨道的颜色*/
+  arc.end_angle = M_PI / 2;
+  ASSERT_EQ(slider_circle_raster_rgba_over(&arc, red, data, 100, 100, line_length), RET_OK);
+  ASSERT_EQ(data[78 * line_length + 78 * 4], 0xff);
+  ASSERT_EQ(data[78 * line_length + 78 * 4 + 3], 0xff);
+  ASSERT_EQ(data[22 * line_length + 22 * 4], 0x80);
+
+  TKMEM_FREE(data);
+}
+
+TEST(slider_circle_zones, prop) {
+  widget_t* w = slider_circle_create(NULL, 0, 0, 100, 100);
+  widget_t* c = NULL;
+  slider_circle_t* s = SLIDER_CIRCLE(w);
+
+  ASSERT_EQ(widget_set_prop_str(w, SLIDER_CIRCLE_PROP_ZONES, "80,90,#ffbf00;90,100,red"), RET_OK);
+  ASSERT_STREQ(widget_get_prop_str(w, SLIDER_CIRCLE_PROP_ZONES, NULL), "80,90,#ffbf00;90,100,red");
+  ASSERT_TRUE(s->zone_list != NULL);
+  ASSERT_EQ(s->zone_list->size, 2u);
+
+  c = widget_clone(w, NULL);
+  ASSERT_STREQ(SLIDER_CIRCLE(c)->zones, s->zones);
+  ASSERT_EQ(SLIDER_CIRCLE(c)->zone_list->size, 2u);
+
+  ASSERT_EQ(slider_circle_set_zones(w, NULL), RET_OK);
+  ASSERT_TRUE(s->zones == NULL);
+  ASSERT_TRUE(s->zone_list == NULL);
+
+  widget_destroy(c);
+  widget_destroy(w);
+}